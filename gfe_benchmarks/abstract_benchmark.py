@@ -0,0 +1,50 @@
+from six import add_metaclass
+
+from spinn_utilities.abstract_base import AbstractBase, abstractmethod
+from spinn_utilities.abstract_base import abstractproperty
+
+
+@add_metaclass(AbstractBase)
+class AbstractBenchmark(object):
+    """ A graph whose tool chain and run are measured by the benchmark\
+        runner; one instance builds graphs of any size
+    """
+
+    __slots__ = ()
+
+    @abstractproperty
+    def name(self):
+        """ The name of the benchmark in the results
+        """
+
+    @abstractproperty
+    def binary_folder(self):
+        """ The folder holding the binaries of the benchmark
+        """
+
+    @abstractmethod
+    def supports(self, grid_size, cells_per_core):
+        """ Whether the benchmark can be built with some parameters
+
+        :param grid_size: the width and height of the grid
+        :param cells_per_core: the number of cells to put on each core
+        :rtype: bool
+        """
+
+    @abstractmethod
+    def build(self, grid_size, cells_per_core):
+        """ Add the graph of the benchmark to the front end, which has been\
+            set up
+
+        :param grid_size: the width and height of the grid
+        :param cells_per_core: the number of cells to put on each core
+        :return: the vertices of the graph, for extract()
+        """
+
+    @abstractmethod
+    def extract(self, vertices, run_time):
+        """ Read back the results of a run, as an application would
+
+        :param vertices: the vertices returned by build()
+        :param run_time: the number of ticks that were run
+        """
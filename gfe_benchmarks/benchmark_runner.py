@@ -0,0 +1,170 @@
+from collections import OrderedDict
+from contextlib import contextmanager
+import datetime
+import itertools
+import json
+import logging
+import os
+import platform
+import shutil
+import tempfile
+import time
+
+from spinn_front_end_common.utilities import globals_variables
+
+import spinnaker_graph_front_end as front_end
+
+logger = logging.getLogger(__name__)
+
+# The phases of the tool chain timed by the front end
+PHASES = ["graph_building", "mapping", "data_generation", "loading",
+          "running", "extraction"]
+
+# The board emulated when there is no machine; a 48-chip board
+_VIRTUAL_BOARD_CONFIG = """[Machine]
+virtual_board = True
+version = 5
+width = 8
+height = 8
+"""
+
+
+@contextmanager
+def virtual_machine():
+    """ Run the front end against a virtual board rather than a machine;\
+        the graph is mapped and its data generated, but nothing is loaded\
+        or run.  The front end reads a config from the current directory,\
+        so one is written to a temporary directory which is made current.
+    """
+    folder = tempfile.mkdtemp()
+    cwd = os.getcwd()
+    with open(os.path.join(
+            folder, front_end.SpiNNaker.CONFIG_FILE_NAME), "w") as f:
+        f.write(_VIRTUAL_BOARD_CONFIG)
+    os.chdir(folder)
+    try:
+        yield
+    finally:
+        os.chdir(cwd)
+        shutil.rmtree(folder, ignore_errors=True)
+
+
+def count_lost_packets(simulator):
+    """ Count the packets lost in a run: those the binaries report in their\
+        tick profiles, and multicast packets dropped by the routers of the\
+        chips used
+
+    :return: (packets lost by cores, packets dropped by routers)
+    """
+    lost = sum(
+        profile.n_lost_packets
+        for profile in simulator.get_tick_profiles().values())
+    chips = set(
+        (placement.x, placement.y)
+        for placement in simulator.placements.placements)
+    dropped = sum(
+        simulator.transceiver.get_router_diagnostics(
+            x, y).n_dropped_multicast_packets
+        for (x, y) in chips)
+    return lost, dropped
+
+
+def run_benchmark(
+        benchmark, grid_size, cells_per_core, machine_time_step, run_time,
+        emulate=False):
+    """ Build, map, load, run and read back one graph of a benchmark,\
+        timing each phase
+
+    :param benchmark: the benchmark to run
+    :type benchmark: AbstractBenchmark
+    :param grid_size: the width and height of the grid
+    :param cells_per_core: the number of cells to put on each core
+    :param machine_time_step: the tick period in microseconds
+    :param run_time: how long to run for in milliseconds
+    :param emulate: True to use a virtual board instead of a machine
+    :return: the result, ready to be written as JSON
+    :rtype: OrderedDict
+    """
+    result = OrderedDict([
+        ("benchmark", benchmark.name),
+        ("grid_size", grid_size),
+        ("cells_per_core", cells_per_core),
+        ("machine_time_step", machine_time_step),
+        ("run_time", run_time),
+        ("emulated", emulate)])
+    timings = OrderedDict()
+    result["timings"] = timings
+    if not benchmark.supports(grid_size, cells_per_core):
+        result["skipped"] = True
+        return result
+
+    context = virtual_machine() if emulate else _current_folder()
+    with context:
+        front_end.setup(
+            model_binary_folder=benchmark.binary_folder,
+            machine_time_step=machine_time_step)
+        simulator = globals_variables.get_simulator()
+        try:
+            vertices = benchmark.build(grid_size, cells_per_core)
+            report = front_end.run(run_time)
+            timings.update(report.seconds_by_phase)
+            result["peak_memory_kb"] = max(
+                phase.peak_memory_kb for phase in report.phases)
+
+            # Nothing runs on a virtual board, so there is nothing to read
+            if not emulate:
+                start = time.time()
+                benchmark.extract(
+                    vertices, run_time * 1000 // machine_time_step)
+                timings["extraction"] = (
+                    timings.get("extraction", 0.0) + time.time() - start)
+                lost, dropped = count_lost_packets(simulator)
+                result["lost_packets"] = lost
+                result["router_dropped_packets"] = dropped
+        except Exception as e:
+            logger.exception("Benchmark {} failed".format(result))
+            result["error"] = str(e)
+        finally:
+            front_end.stop()
+    for phase in PHASES:
+        timings.setdefault(phase, None)
+    return result
+
+
+@contextmanager
+def _current_folder():
+    yield
+
+
+def run_sweep(
+        benchmark, grid_sizes, cells_per_core, machine_time_steps,
+        run_time, emulate=False):
+    """ Run a benchmark over every combination of parameters
+
+    :return: the results, ready to be written as JSON
+    :rtype: OrderedDict
+    """
+    results = list()
+    for grid_size, n_cells, time_step in itertools.product(
+            grid_sizes, cells_per_core, machine_time_steps):
+        logger.info(
+            "Running {} with grid size {}, {} cells per core and time step "
+            "{}".format(benchmark.name, grid_size, n_cells, time_step))
+        results.append(run_benchmark(
+            benchmark, grid_size, n_cells, time_step, run_time, emulate))
+    return OrderedDict([
+        ("version", front_end.__version__),
+        ("python", platform.python_version()),
+        ("host", platform.node()),
+        ("date", datetime.datetime.now().isoformat()),
+        ("results", results)])
+
+
+def write_results(results, path):
+    with open(path, "w") as f:
+        json.dump(results, f, indent=4)
+
+
+def read_results(path):
+    with open(path) as f:
+        return json.load(f, object_pairs_hook=OrderedDict)
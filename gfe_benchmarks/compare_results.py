@@ -0,0 +1,68 @@
+""" Compare two sets of benchmark results, reporting the phases which got\
+    slower, e.g.
+
+    python -m gfe_benchmarks.compare_results old.json new.json
+"""
+import argparse
+import sys
+
+from gfe_benchmarks.benchmark_runner import read_results
+
+# The parameters which identify a result
+_KEY = ["benchmark", "grid_size", "cells_per_core", "machine_time_step",
+        "run_time", "emulated"]
+
+
+def _by_key(results):
+    return {
+        tuple(result[name] for name in _KEY): result
+        for result in results["results"]}
+
+
+def compare(old_results, new_results, tolerance):
+    """ Find the timings which got slower by more than a tolerance
+
+    :param old_results: the results to compare against
+    :param new_results: the results to compare
+    :param tolerance: the fraction a timing may grow by, e.g. 0.1
+    :return: list of (parameters, phase, old seconds, new seconds)
+    """
+    old = _by_key(old_results)
+    regressions = list()
+    for key, new_result in sorted(_by_key(new_results).items()):
+        if key not in old:
+            continue
+        old_timings = old[key]["timings"]
+        for phase, seconds in new_result["timings"].items():
+            old_seconds = old_timings.get(phase)
+            if seconds is None or old_seconds is None:
+                continue
+            if seconds > old_seconds * (1.0 + tolerance):
+                regressions.append(
+                    (dict(zip(_KEY, key)), phase, old_seconds, seconds))
+    return regressions
+
+
+def main(args=None):
+    parser = argparse.ArgumentParser(
+        description="Compare graph front end benchmark results")
+    parser.add_argument("old")
+    parser.add_argument("new")
+    parser.add_argument(
+        "--tolerance", type=float, default=0.1,
+        help="the fraction a timing may grow by before it is reported")
+    args = parser.parse_args(args)
+
+    old_results = read_results(args.old)
+    new_results = read_results(args.new)
+    regressions = compare(old_results, new_results, args.tolerance)
+    for parameters, phase, old_seconds, new_seconds in regressions:
+        sys.stdout.write(
+            "{} {}: {:.3f}s in {} -> {:.3f}s in {}\n".format(
+                parameters, phase, old_seconds, old_results["version"],
+                new_seconds, new_results["version"]))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,80 @@
+import os
+import random
+
+from pacman.model.decorators import overrides
+
+import spinnaker_graph_front_end as front_end
+from spinnaker_graph_front_end.utility_models import SDRAMMailboxMachineEdge
+from spinnaker_graph_front_end.examples.Conways import \
+    partitioned_example_b_no_vis_buffer as conways_b
+from spinnaker_graph_front_end.examples.Conways.\
+    partitioned_example_b_no_vis_buffer.conways_basic_cell \
+    import ConwayBasicCell
+
+from gfe_benchmarks.abstract_benchmark import AbstractBenchmark
+
+# The offsets of the eight neighbours of a cell
+_NEIGHBOURS = [
+    (0, 1), (1, 1), (1, 0), (1, -1), (0, -1), (-1, -1), (-1, 0), (-1, 1)]
+
+
+class ConwayBenchmark(AbstractBenchmark):
+    """ Conway's game of life on a toroidal grid, using the cells of the\
+        partitioned example b
+    """
+
+    __slots__ = [
+        # The fraction of the cells which start alive
+        "_density",
+
+        # The seed of the initial states
+        "_seed"
+    ]
+
+    def __init__(self, density=0.3, seed=1):
+        self._density = density
+        self._seed = seed
+
+    @property
+    @overrides(AbstractBenchmark.name)
+    def name(self):
+        return "conway"
+
+    @property
+    @overrides(AbstractBenchmark.binary_folder)
+    def binary_folder(self):
+        return os.path.dirname(conways_b.__file__)
+
+    @overrides(AbstractBenchmark.supports)
+    def supports(self, grid_size, cells_per_core):
+
+        # The cells of example b hold one cell per core
+        return cells_per_core == 1
+
+    @overrides(AbstractBenchmark.build)
+    def build(self, grid_size, cells_per_core):
+        states = random.Random(self._seed)
+        cells = dict()
+        for x in range(grid_size):
+            for y in range(grid_size):
+                cell = ConwayBasicCell(
+                    "cell{}_{}".format(x, y),
+                    states.random() < self._density)
+                cells[x, y] = cell
+                front_end.add_machine_vertex_instance(cell)
+
+        for (x, y), cell in cells.items():
+            for (dx, dy) in _NEIGHBOURS:
+                neighbour = cells[(x + dx) % grid_size, (y + dy) % grid_size]
+                front_end.add_machine_edge_instance(
+                    SDRAMMailboxMachineEdge(cell, neighbour),
+                    ConwayBasicCell.PARTITION_ID)
+        return list(cells.values())
+
+    @overrides(AbstractBenchmark.extract)
+    def extract(self, vertices, run_time):
+        buffer_manager = front_end.buffer_manager()
+        placements = front_end.placements()
+        for cell in vertices:
+            cell.get_data(
+                buffer_manager, placements.get_placement_of_vertex(cell))
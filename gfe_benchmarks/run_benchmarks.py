@@ -0,0 +1,59 @@
+""" Run the benchmarks of the graph front end over a sweep of parameters\
+    and write the results as JSON, e.g.
+
+    python -m gfe_benchmarks.run_benchmarks --grid-sizes 4,6 \\
+        --time-steps 1000,500 --emulate --output results.json
+"""
+import argparse
+import logging
+
+from gfe_benchmarks.benchmark_runner import run_sweep, write_results
+from gfe_benchmarks.conway_benchmark import ConwayBenchmark
+from gfe_benchmarks.stencil_benchmark import StencilLifeBenchmark
+
+# The benchmarks which can be run, by name; the conway benchmark has one
+# cell per core, and the stencil_life benchmark any number
+BENCHMARKS = {
+    "conway": ConwayBenchmark,
+    "stencil_life": StencilLifeBenchmark
+}
+
+
+def _int_list(value):
+    return [int(item) for item in value.split(",")]
+
+
+def main(args=None):
+    parser = argparse.ArgumentParser(
+        description="Benchmark the graph front end")
+    parser.add_argument(
+        "--benchmark", choices=sorted(BENCHMARKS), default="conway")
+    parser.add_argument(
+        "--grid-sizes", type=_int_list, default=[4, 6],
+        help="comma separated widths of the grid")
+    parser.add_argument(
+        "--cells-per-core", type=_int_list, default=[1],
+        help="comma separated numbers of cells per core")
+    parser.add_argument(
+        "--time-steps", type=_int_list, default=[1000],
+        help="comma separated machine time steps in microseconds")
+    parser.add_argument(
+        "--run-time", type=int, default=100,
+        help="the run time in milliseconds")
+    parser.add_argument(
+        "--emulate", action="store_true",
+        help="use a virtual board; only graph building, mapping and data "
+             "generation are measured")
+    parser.add_argument(
+        "--output", default="gfe_benchmark_results.json")
+    args = parser.parse_args(args)
+
+    logging.basicConfig(level=logging.INFO)
+    results = run_sweep(
+        BENCHMARKS[args.benchmark](), args.grid_sizes, args.cells_per_core,
+        args.time_steps, args.run_time, args.emulate)
+    write_results(results, args.output)
+
+
+if __name__ == "__main__":
+    main()
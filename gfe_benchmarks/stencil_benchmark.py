@@ -0,0 +1,81 @@
+import os
+import random
+
+from pacman.model.decorators import overrides
+
+import spinnaker_graph_front_end as front_end
+from spinnaker_graph_front_end.examples import stencil
+from spinnaker_graph_front_end.utilities.stencil_spec import MOORE, UINT8
+
+from gfe_benchmarks.abstract_benchmark import AbstractBenchmark
+
+
+def _life(state, n_alive):
+    return 1 if n_alive == 3 or (state and n_alive == 2) else 0
+
+
+def get_tile_size(grid_size, cells_per_core):
+    """ The most square tile of a number of cells which divides the grid
+
+    :return: the (width, height) of the tile, or None if there is none
+    """
+    tiles = [
+        (cells_per_core // height, height)
+        for height in range(1, cells_per_core + 1)
+        if cells_per_core % height == 0 and
+        grid_size % height == 0 and
+        grid_size % (cells_per_core // height) == 0]
+    if not tiles:
+        return None
+    return min(tiles, key=lambda tile: abs(tile[0] - tile[1]))
+
+
+class StencilLifeBenchmark(AbstractBenchmark):
+    """ Conway's game of life on a toroidal grid, using a generated stencil\
+        kernel with a tile of cells on each core
+    """
+
+    __slots__ = [
+        # The fraction of the cells which start alive
+        "_density",
+
+        # The seed of the initial states
+        "_seed"
+    ]
+
+    def __init__(self, density=0.3, seed=1):
+        self._density = density
+        self._seed = seed
+
+    @property
+    @overrides(AbstractBenchmark.name)
+    def name(self):
+        return "stencil_life"
+
+    @property
+    @overrides(AbstractBenchmark.binary_folder)
+    def binary_folder(self):
+
+        # The kernel is built into the binary cache, which the front end
+        # searches once the grid is added
+        return os.path.dirname(stencil.__file__)
+
+    @overrides(AbstractBenchmark.supports)
+    def supports(self, grid_size, cells_per_core):
+        return get_tile_size(grid_size, cells_per_core) is not None
+
+    @overrides(AbstractBenchmark.build)
+    def build(self, grid_size, cells_per_core):
+        tile_width, tile_height = get_tile_size(grid_size, cells_per_core)
+        spec = front_end.StencilSpec(
+            neighbourhood=MOORE, cell_type=UINT8, tile_width=tile_width,
+            tile_height=tile_height, rule=_life)
+        states = random.Random(self._seed)
+        cells = [[1 if states.random() < self._density else 0
+                  for _ in range(grid_size)] for _ in range(grid_size)]
+        return [front_end.add_stencil_grid(spec, cells, label="life")]
+
+    @overrides(AbstractBenchmark.extract)
+    def extract(self, vertices, run_time):
+        for grid in vertices:
+            front_end.get_stencil_cells(grid)
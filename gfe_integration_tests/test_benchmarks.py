@@ -0,0 +1,42 @@
+import unittest
+
+from gfe_benchmarks.benchmark_runner import run_sweep
+from gfe_benchmarks.conway_benchmark import ConwayBenchmark
+from gfe_benchmarks.stencil_benchmark import \
+    StencilLifeBenchmark, get_tile_size
+
+
+class TestBenchmarks(unittest.TestCase):
+
+    def test_emulated_conway_sweep(self):
+        results = run_sweep(
+            ConwayBenchmark(), grid_sizes=[4], cells_per_core=[1, 2],
+            machine_time_steps=[1000], run_time=10, emulate=True)
+        run, skipped = results["results"]
+        self.assertNotIn("error", run)
+        self.assertGreater(run["timings"]["graph_building"], 0)
+        self.assertIsNotNone(run["timings"]["mapping"])
+        self.assertIsNotNone(run["timings"]["data_generation"])
+        self.assertTrue(skipped["skipped"])
+
+    def test_tile_size(self):
+        self.assertEqual(get_tile_size(4, 1), (1, 1))
+        self.assertEqual(get_tile_size(4, 4), (2, 2))
+        self.assertEqual(get_tile_size(6, 6), (3, 2))
+        self.assertEqual(get_tile_size(8, 8), (4, 2))
+        self.assertIsNone(get_tile_size(4, 3))
+
+    def test_emulated_stencil_sweep(self):
+
+        # every number of cells per core which tiles the grid is measured
+        results = run_sweep(
+            StencilLifeBenchmark(), grid_sizes=[4], cells_per_core=[1, 4],
+            machine_time_steps=[1000], run_time=10, emulate=True)
+        for run in results["results"]:
+            self.assertNotIn("skipped", run)
+            self.assertNotIn("error", run)
+            self.assertIsNotNone(run["timings"]["mapping"])
+
+
+if __name__ == '__main__':
+    unittest.main()
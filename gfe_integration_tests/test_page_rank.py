@@ -0,0 +1,12 @@
+import os
+import unittest
+
+
+class TestPageRank(unittest.TestCase):
+
+    def test_page_rank(self):
+        import spinnaker_graph_front_end.examples.page_rank as pr_dir
+        class_file = pr_dir.__file__
+        path = os.path.dirname(os.path.abspath(class_file))
+        os.chdir(path)
+        import spinnaker_graph_front_end.examples.page_rank.page_rank   # NOQA
@@ -0,0 +1,12 @@
+import os
+import unittest
+
+
+class TestSSSP(unittest.TestCase):
+
+    def test_sssp(self):
+        import spinnaker_graph_front_end.examples.sssp as sssp_dir
+        class_file = sssp_dir.__file__
+        path = os.path.dirname(os.path.abspath(class_file))
+        os.chdir(path)
+        import spinnaker_graph_front_end.examples.sssp.sssp   # NOQA
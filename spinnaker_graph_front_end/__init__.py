@@ -9,12 +9,30 @@ from spinn_utilities.socket_address import SocketAddress
 # front end common imports
 from spinn_front_end_common.utilities.utility_objs import ExecutableFinder
 from spinn_front_end_common.utilities import globals_variables
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
 # utility models for graph front ends
 from spinn_front_end_common.utility_models import LivePacketGather
 from spinn_front_end_common.utility_models import ReverseIpTagMultiCastSource
 
 from pacman.model.graphs.machine import MachineEdge
 
+# utility models provided by the graph front end
+from spinnaker_graph_front_end.utility_models import SDRAMMailboxMachineEdge
+from spinnaker_graph_front_end.utility_models import StreamInjectorVertex
+from spinnaker_graph_front_end.utilities.time_step_tuner \
+    import tune_time_step
+from spinnaker_graph_front_end.utilities.resource_model \
+    import ResourceModel, get_resource_model_path
+from spinnaker_graph_front_end.utilities.reduction_tree \
+    import ReductionTree, ReductionOperation
+from spinnaker_graph_front_end.utilities.stencil_codegen \
+    import build_stencil_binary
+from spinnaker_graph_front_end.utilities.stencil_grid import StencilGrid
+from spinnaker_graph_front_end.utilities.stencil_spec import StencilSpec
+from spinnaker_graph_front_end.utilities.input_stream import InputStream
+from spinnaker_graph_front_end.utilities.graph_batch import GraphBatch
+from spinnaker_graph_front_end import common_model_binaries
+
 import os
 import logging
 import sys
@@ -25,6 +43,7 @@ _none_labelled_vertex_count = None
 _none_labelled_edge_count = None
 
 __all__ = ['LivePacketGather', 'ReverseIpTagMultiCastSource', 'MachineEdge',
+           'SDRAMMailboxMachineEdge',
            'setup', 'run', 'stop', 'read_xml_file', 'add_vertex_instance',
            'add_vertex', 'add_machine_vertex', 'add_machine_vertex_instance',
            'add_edge', 'add_application_edge_instance', 'add_machine_edge',
@@ -33,14 +52,23 @@ __all__ = ['LivePacketGather', 'ReverseIpTagMultiCastSource', 'MachineEdge',
            'has_ran', 'machine_time_step', 'no_machine_time_steps',
            'timescale_factor', 'machine_graph', 'application_graph',
            'routing_infos', 'placements', 'transceiver', 'graph_mapper',
-           'buffer_manager', 'machine', 'is_allocated_machine']
+           'buffer_manager', 'machine', 'is_allocated_machine',
+           'auto_tune_time_step', 'profile_resources', 'timing_report',
+           'timing_reports', 'checkpoint', 'get_tick_profiles',
+           'ReductionTree', 'ReductionOperation', 'add_reduction_tree',
+           'get_reduction_results', 'StencilSpec', 'add_stencil_grid',
+           'get_stencil_cells', 'InputStream', 'add_input_stream',
+           'open_input_stream', 'get_input_stream_counters',
+           'create_graph_batch', 'get_graph_batch_results', 'get_token_logs',
+           'get_key_trace_report']
 
 
 def setup(hostname=None, graph_label=None, model_binary_module=None,
           model_binary_folder=None, database_socket_addresses=None,
           user_dsg_algorithm=None, n_chips_required=None,
           extra_pre_run_algorithms=None, extra_post_run_algorithms=None,
-          time_scale_factor=None, machine_time_step=None):
+          time_scale_factor=None, machine_time_step=None,
+          restore_from=None):
     """
 
     :param hostname:\
@@ -85,6 +113,12 @@ def setup(hostname=None, graph_label=None, model_binary_module=None,
         algorithms which need to be ran after the simulation has ran. These\
         could be post processing of generated data on the machine for example.
     :type extra_pre_run_algorithms: list of str
+    :param restore_from:\
+        a file written by checkpoint(); each vertex of the graph that is\
+        built which can be checkpointed is given the state saved from the\
+        vertex with the same label, and the timing of the checkpoint is used\
+        unless other timing is given
+    :type restore_from: str
     """
     global _none_labelled_vertex_count
     global _none_labelled_edge_count
@@ -109,6 +143,10 @@ def setup(hostname=None, graph_label=None, model_binary_module=None,
         file_dir = os.path.dirname(os.path.abspath(sys.argv[0]))
         executable_finder.add_path(file_dir)
 
+    # the binaries of the models provided by the graph front end
+    executable_finder.add_path(
+        os.path.dirname(common_model_binaries.__file__))
+
     # set up the spinnaker object
     SpiNNaker(
         host_name=hostname, graph_label=graph_label,
@@ -119,7 +157,138 @@ def setup(hostname=None, graph_label=None, model_binary_module=None,
         extra_pre_run_algorithms=extra_pre_run_algorithms,
         extra_post_run_algorithms=extra_post_run_algorithms,
         machine_time_step=machine_time_step,
-        time_scale_factor=time_scale_factor)
+        time_scale_factor=time_scale_factor,
+        restore_from=restore_from)
+
+
+def auto_tune_time_step(
+        build_graph, calibration_run_time=None, headroom=None,
+        **setup_args):
+    """ Set up the front end with the smallest machine time step that the\
+        graph can safely run at.  The graph is built and run briefly at the\
+        machine time step given (or the default), the cost of the ticks of\
+        the vertices that measure it (see AbstractHasTickProfile) is read\
+        back, and the front end is set up again with the chosen time step\
+        and the graph rebuilt, ready for the real run.  A calibration which\
+        overruns or loses packets is run again at a longer time step, up to\
+        max_calibrations times (see the [AutoTune] section of the config).
+
+    :param build_graph:\
+        a function of no arguments which adds the vertices and edges of the\
+        graph to the front end; it is called twice
+    :type build_graph: callable
+    :param calibration_run_time:\
+        how long to run the calibration for; taken from the [AutoTune]\
+        section of the config if not given
+    :type calibration_run_time: int
+    :param headroom:\
+        the fraction of each tick to leave spare on the slowest core; taken\
+        from the [AutoTune] section of the config if not given
+    :type headroom: float
+    :param setup_args: the arguments to pass to setup()
+    :return: the tuning chosen
+    :rtype: TimeStepTuning
+    """
+    setup(**setup_args)
+    simulator = globals_variables.get_simulator()
+    config = simulator.config
+    if calibration_run_time is None:
+        calibration_run_time = config.getint(
+            "AutoTune", "calibration_run_time")
+    if headroom is None:
+        headroom = config.getfloat("AutoTune", "headroom")
+
+    max_calibrations = max(config.getint("AutoTune", "max_calibrations"), 1)
+    tuning = None
+
+    # a calibration which overran only shows that its time step is too
+    # short, so calibrate again at the longer time step picked
+    for calibration in range(max_calibrations):
+        if calibration > 0:
+            setup_args["machine_time_step"] = tuning.machine_time_step
+            setup(**setup_args)
+            simulator = globals_variables.get_simulator()
+        build_graph()
+        run(calibration_run_time)
+        tick_profiles = simulator.get_tick_profiles()
+        if not tick_profiles:
+            logger.warning(
+                "No vertex measures its tick cost, so the machine time step "
+                "cannot be tuned")
+        tuning = tune_time_step(
+            tick_profiles, simulator.machine_time_step, headroom,
+            config.getint("AutoTune", "minimum_machine_time_step"),
+            config.getint("AutoTune", "time_step_granularity"),
+            config.getint("Resources", "cpu_clock_mhz"),
+            simulator.time_scale_factor)
+        stop()
+        if tuning.calibration_was_safe:
+            break
+    else:
+        logger.warning(
+            "No calibration ran without overruns or lost packets in {} "
+            "tries; the time step chosen may still be too short".format(
+                max_calibrations))
+    logger.info("Auto-tuned {}".format(tuning))
+
+    setup_args["machine_time_step"] = tuning.machine_time_step
+    setup(**setup_args)
+    build_graph()
+    return tuning
+
+
+def profile_resources(
+        build_graph, element_counts, run_time, binary_file_name=None,
+        output_folder=None, **setup_args):
+    """ Measure the DTCM and CPU cycles per tick a binary needs against the\
+        number of elements its vertices hold, and fit a resource model to\
+        the measurements.  A graph is built and run for each number of\
+        elements; the vertices measured must implement\
+        AbstractHasTickProfile and call tick_profiler_record_dtcm_usage().\
+        The binaries have to run to be measured, so this needs a real\
+        machine rather than a virtual one.
+
+    :param build_graph:\
+        a function taking the number of elements which adds a graph to the\
+        front end and returns the vertices to measure, each holding that\
+        many elements
+    :type build_graph: callable
+    :param element_counts: the numbers of elements to measure, at least two
+    :type element_counts: iterable of int
+    :param run_time: how long to run each graph for
+    :type run_time: int
+    :param binary_file_name:\
+        the binary being measured; if given with output_folder, the model\
+        is saved where the vertices of the binary will load it from
+    :type binary_file_name: str
+    :param output_folder: the folder to save the model in
+    :type output_folder: str
+    :param setup_args: the arguments to pass to setup()
+    :return: the model fitted
+    :rtype: ResourceModel
+    """
+    samples = list()
+    for n_elements in element_counts:
+        setup(**setup_args)
+        simulator = globals_variables.get_simulator()
+        if simulator.config.getboolean("Machine", "virtual_board"):
+            stop()
+            raise ConfigurationException(
+                "Resources can only be measured on a real machine")
+        vertices = set(build_graph(n_elements))
+        run(run_time)
+        for placement, profile in simulator.get_tick_profiles().items():
+            if placement.vertex in vertices and profile.n_ticks > 0:
+                samples.append((
+                    n_elements, profile.dtcm_used_bytes,
+                    profile.max_tick_cycles))
+        stop()
+
+    model = ResourceModel.fit(samples)
+    logger.info("Measured {}".format(model))
+    if binary_file_name is not None and output_folder is not None:
+        model.save(get_resource_model_path(binary_file_name, output_folder))
+    return model
 
 
 def run(duration=None):
@@ -127,14 +296,84 @@ def run(duration=None):
 
     :param duration: the number of microseconds the application should run for
     :type duration: int
+    :return: where the time of the run went
+    :rtype: PhaseTimingReport
     """
-    globals_variables.get_simulator().run(duration)
+    return globals_variables.get_simulator().run(duration)
 
 
 def run_until_complete():
     """ Run until the application is complete
+
+    :return: where the time of the run went
+    :rtype: PhaseTimingReport
+    """
+    return globals_variables.get_simulator().run_until_complete()
+
+
+def timing_report():
+    """ Get where the time and memory of the latest run went, phase by\
+        phase and algorithm by algorithm; the time taken by stop() is added\
+        to it
+
+    :rtype: PhaseTimingReport
+    """
+    return globals_variables.get_simulator().timing_report
+
+
+def timing_reports():
+    """ Get the timing reports of all the runs so far, oldest first
+
+    :rtype: list of PhaseTimingReport
+    """
+    return globals_variables.get_simulator().timing_reports
+
+
+def checkpoint(path):
+    """ Save the state of every vertex that can be checkpointed (see\
+        AbstractCheckpointable) to a file, while the application is paused\
+        after a run; pass the file to setup() as restore_from to carry on\
+        from here in a later script
+
+    :param path: the file to write
+    :rtype: Checkpoint
+    """
+    return globals_variables.get_simulator().checkpoint(path)
+
+
+def get_tick_profiles():
+    """ Read the cost of the ticks and the packets lost by each vertex which\
+        measures them (see AbstractHasTickProfile) in the runs so far, e.g.\
+        to rebalance the work of the vertices before the next run
+
+    :return: dict of placement to TickProfile
+    """
+    return globals_variables.get_simulator().get_tick_profiles()
+
+
+def get_token_logs():
+    """ Read the messages logged by each core running a binary built with\
+        TOKEN_LOGGING=1, which logs tokens and raw arguments to a ring in\
+        SDRAM rather than text to its iobuf, rebuilt from the dictionary\
+        saved next to the binary
+
+    :return: dict of placement to its messages, oldest first
     """
-    globals_variables.get_simulator().run_until_complete()
+    return globals_variables.get_simulator().get_token_logs()
+
+
+def get_key_trace_report():
+    """ Report the multicast traffic of the runs so far: the packets\
+        received by each vertex which traces its keys (see\
+        AbstractTracesKeys), by the edge they came along, traced through the\
+        router tables to the links and chips they crossed, with the packets\
+        dropped by the routers; written to key_trace_report.rpt in the\
+        report folder.  Tracing is turned on in the [KeyTrace] section of\
+        the config
+
+    :rtype: KeyTraceReport
+    """
+    return globals_variables.get_simulator().get_key_trace_report()
 
 
 def stop():
@@ -146,6 +385,183 @@ def stop():
     _executable_finder = None
 
 
+def add_reduction_tree(
+        contributors, operations, period=1, deliver_results=False,
+        label="reduction", contributors_per_chip=None, completion=False):
+    """ Add a tree of aggregator cores which combine a value from each\
+        contributor every period ticks, to be recorded and optionally sent\
+        back to the contributors.  The contributors are constrained to the\
+        chips of their aggregators, so this is called once the contributors\
+        have been made, and the machine is found if it has not been.
+
+    :param contributors: the vertices contributing values
+    :type contributors: list of AbstractReductionContributor
+    :param operations: the operation of each reduction
+    :type operations: list of ReductionOperation
+    :param period: the number of ticks between contributions
+    :param deliver_results: True to send the results back to every\
+        contributor as well as recording them
+    :param label: the label of the tree
+    :param contributors_per_chip: the most contributors to put on a chip,\
+        or None to fill each chip
+    :param completion: True to end a run_until_complete() run once every\
+        contributor says it is done in the same period (see\
+        reduction_signal_done() in reduction.h)
+    :rtype: ReductionTree
+    """
+    tree = ReductionTree(
+        contributors, operations, period, deliver_results, label, completion)
+    tree.add_to_graph(
+        machine(), add_machine_vertex_instance, add_machine_edge_instance,
+        contributors_per_chip)
+    return tree
+
+
+def get_reduction_results(tree):
+    """ Get the results of a reduction tree recorded in the last run
+
+    :param tree: the tree, as returned by add_reduction_tree()
+    :return: the result of each round of each reduction, by reduction
+    :rtype: list of list of int
+    """
+    return tree.get_results(buffer_manager(), placements())
+
+
+def add_stencil_grid(spec, cells, label="stencil"):
+    """ Add a grid of cells updated by a kernel generated for a stencil,\
+        with a core for each tile of the grid.  The kernel is built the\
+        first time the stencil is used, and its binary cached by the hash of\
+        the stencil in the binary_cache folder of the [Stencil] section of\
+        the config, so building needs the SpiNNaker tools (SPINN_DIRS) only\
+        for a new stencil.
+
+    :param spec: the stencil
+    :type spec: StencilSpec
+    :param cells: the initial cells as a list of rows, which must be a\
+        whole number of tiles across and up; the grid wraps around at its\
+        edges
+    :param label: the label of the grid
+    :rtype: StencilGrid
+    """
+    simulator = globals_variables.get_simulator()
+    cache_folder = simulator.config.get("Stencil", "binary_cache")
+    simulator.add_binary_folder(build_stencil_binary(
+        spec, None if cache_folder == "None" else cache_folder))
+    grid = StencilGrid(spec, cells, label)
+    grid.add_to_graph(
+        add_machine_vertex_instance, add_machine_edge_instance,
+        machine_graph())
+    return grid
+
+
+def get_stencil_cells(grid):
+    """ Get the cells of a stencil grid when the last run paused
+
+    :param grid: the grid, as returned by add_stencil_grid()
+    :return: the cells as a list of rows
+    """
+    return grid.read_cells(transceiver(), placements())
+
+
+def add_input_stream(
+        n_channels, port, reply_port, packets_per_second, label="stream",
+        window=None, credit_batch=None, reply_host=None):
+    """ Add a core which sends values streamed from the host with\
+        open_input_stream() as multicast packets, channel i with the first\
+        key of the partition StreamInjectorVertex.PARTITION_ID plus i.  The\
+        defaults come from the [Streaming] section of the config.
+
+    :param n_channels: the number of channels
+    :param port: the port the host sends the frames of values to
+    :param reply_port: the port the host sends from, which the injector\
+        tells how much of its buffer is free
+    :param packets_per_second: the most packets the injector sends in a\
+        second of machine time
+    :param label: the label of the vertex
+    :param window: the frames of values the injector buffers
+    :param credit_batch: the frames drained after which the host is told
+    :param reply_host: the host the injector replies to
+    :rtype: StreamInjectorVertex
+    """
+    simulator = globals_variables.get_simulator()
+    config = simulator.config
+    if window is None:
+        window = config.getint("Streaming", "window")
+    if credit_batch is None:
+        credit_batch = config.getint("Streaming", "credit_batch")
+    if reply_host is None:
+        reply_host = config.get("Streaming", "reply_host")
+    packets_per_tick = max(
+        1, int(packets_per_second * simulator.machine_time_step / 1e6))
+    injector = StreamInjectorVertex(
+        label, n_channels, port, reply_host, reply_port, window,
+        packets_per_tick, credit_batch)
+    add_machine_vertex_instance(injector)
+    return injector
+
+
+def open_input_stream(injector, timeout=0.1, max_requests=100):
+    """ Open a stream of values to an injector added with\
+        add_input_stream(), once the graph is running; values are sent as\
+        fast as the injector drains them
+
+    :param injector: the injector
+    :type injector: StreamInjectorVertex
+    :param timeout: the seconds to wait for credit before asking again
+    :param max_requests: the times to ask for credit before giving up
+    :rtype: InputStream
+    """
+    placement = placements().get_placement_of_vertex(injector)
+    spinnaker_machine = globals_variables.get_simulator().machine
+    chip = spinnaker_machine.get_chip_at(placement.x, placement.y)
+    ethernet = spinnaker_machine.get_chip_at(
+        chip.nearest_ethernet_x, chip.nearest_ethernet_y)
+    return InputStream(
+        ethernet.ip_address, injector.port, injector.n_slots,
+        injector.reply_port, timeout, max_requests)
+
+
+def get_input_stream_counters(injector):
+    """ Get the counters of an injector when the last run paused
+
+    :param injector: the injector, as returned by add_input_stream()
+    :rtype: InjectorCounters
+    """
+    return injector.read_counters(
+        transceiver(), placements().get_placement_of_vertex(injector))
+
+
+def create_graph_batch(prefix_bits=8):
+    """ Create a batch of independent graphs, such as the variants of a\
+        parameter sweep, which are mapped side by side onto the machine and\
+        run together.  Vertices and edges are added to the graphs of the\
+        batch (see GraphBatch.add_graph()) instead of with\
+        add_machine_vertex_instance() and add_machine_edge_instance(); edges\
+        between graphs are refused, and fixed keys must be in the range of\
+        their graph (see BatchedGraph.lattice_keys()).
+
+    :param prefix_bits: the top bits of each key saying which graph sends\
+        it, so there can be up to 2^prefix_bits graphs
+    :rtype: GraphBatch
+    """
+    batch = GraphBatch(
+        add_machine_vertex_instance, add_machine_edge_instance, prefix_bits)
+    globals_variables.get_simulator().add_graph_batch(batch)
+    return batch
+
+
+def get_graph_batch_results(batch, read):
+    """ Get a result from each vertex of each graph of a batch after a run
+
+    :param batch: the batch, as returned by create_graph_batch()
+    :param read: function of a vertex and its placement giving the result\
+        of the vertex, such as the data it recorded
+    :return: the results of the vertices of each graph, by graph name
+    :rtype: OrderedDict of name to OrderedDict of vertex to result
+    """
+    return batch.collect(placements(), read)
+
+
 def read_xml_file(file_path):
     """ Reads a xml file and translates it into an application graph and \
         machine graph (if required)
@@ -0,0 +1,10 @@
+from .abstract_checkpointable import AbstractCheckpointable
+from .abstract_has_recording_sizing import AbstractHasRecordingSizing
+from .abstract_has_tick_profile import AbstractHasTickProfile
+from .abstract_reduction_contributor import AbstractReductionContributor
+from .abstract_sdram_mailbox_producer import AbstractSDRAMMailboxProducer
+from .abstract_traces_keys import AbstractTracesKeys
+
+__all__ = ["AbstractCheckpointable", "AbstractHasRecordingSizing",
+           "AbstractHasTickProfile", "AbstractReductionContributor",
+           "AbstractSDRAMMailboxProducer", "AbstractTracesKeys"]
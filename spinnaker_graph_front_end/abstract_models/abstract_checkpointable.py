@@ -0,0 +1,39 @@
+from six import add_metaclass
+
+from spinn_utilities.abstract_base import AbstractBase, abstractmethod, \
+    abstractproperty
+
+
+@add_metaclass(AbstractBase)
+class AbstractCheckpointable(object):
+    """ A vertex whose state can be saved with front_end.checkpoint() while\
+        the application is paused, and given back to it when a graph is\
+        built again after setup(restore_from=...).  The binary must write\
+        its state back to the checkpoint region every time it pauses.
+    """
+
+    __slots__ = ()
+
+    @abstractproperty
+    def checkpoint_region_id(self):
+        """ The id of the data region that holds the state of the vertex
+
+        :rtype: int
+        """
+
+    @abstractproperty
+    def checkpoint_size_in_bytes(self):
+        """ The number of bytes of state at the start of the region
+
+        :rtype: int
+        """
+
+    @abstractmethod
+    def restore_checkpoint(self, state):
+        """ Called when the vertex is added to a graph restored from a\
+            checkpoint, before its data is generated, with the state saved\
+            from the vertex of the same label
+
+        :param state: the bytes read from the checkpoint region
+        :type state: bytes
+        """
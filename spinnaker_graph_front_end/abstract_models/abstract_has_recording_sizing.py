@@ -0,0 +1,21 @@
+from six import add_metaclass
+
+from spinn_utilities.abstract_base import AbstractBase, abstractproperty
+
+
+@add_metaclass(AbstractBase)
+class AbstractHasRecordingSizing(object):
+    """ A vertex whose recording regions are sized with RecordingSizing,\
+        so that a later run which they cannot hold can be stopped before it\
+        starts
+    """
+
+    __slots__ = ()
+
+    @abstractproperty
+    def recording_sizing(self):
+        """ The sizing the recording regions were last written to the data\
+            specification with, or None if they have not been written
+
+        :rtype: RecordingSizing
+        """
@@ -0,0 +1,19 @@
+from six import add_metaclass
+
+from spinn_utilities.abstract_base import AbstractBase, abstractproperty
+
+
+@add_metaclass(AbstractBase)
+class AbstractHasTickProfile(object):
+    """ A vertex whose binary measures the cost of its timer ticks with\
+        tick_profiler.h
+    """
+
+    __slots__ = ()
+
+    @abstractproperty
+    def tick_profile_region_id(self):
+        """ The id of the data region that holds the tick profile
+
+        :rtype: int
+        """
@@ -0,0 +1,23 @@
+from six import add_metaclass
+
+from spinn_utilities.abstract_base import AbstractBase, abstractmethod
+
+
+@add_metaclass(AbstractBase)
+class AbstractReductionContributor(object):
+    """ A vertex which contributes values to a reduction tree with\
+        reduction.h.  The vertex must provide the tree's n_reductions keys\
+        for its REDUCTION_PARTITION_ID partition, and reserve and write its\
+        reduction region with the tree's reserve_contributor_region() and\
+        write_contributor_region().
+    """
+
+    __slots__ = ()
+
+    @abstractmethod
+    def set_reduction_tree(self, reduction_tree):
+        """ Called when the vertex is added to a reduction tree
+
+        :param reduction_tree: the tree the vertex contributes to
+        :type reduction_tree: ReductionTree
+        """
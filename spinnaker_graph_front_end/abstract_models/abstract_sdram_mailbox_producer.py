@@ -0,0 +1,20 @@
+from six import add_metaclass
+
+from spinn_utilities.abstract_base import AbstractBase, abstractproperty
+
+
+@add_metaclass(AbstractBase)
+class AbstractSDRAMMailboxProducer(object):
+    """ A vertex which can hand its outgoing data to consumers on the same\
+        chip through a shared SDRAM mailbox instead of multicast packets
+    """
+
+    __slots__ = ()
+
+    @abstractproperty
+    def sdram_mailbox_region_id(self):
+        """ The id of the data region that holds the mailbox of this vertex.\
+            Consumers locate the mailbox through this region at start up.
+
+        :rtype: int
+        """
@@ -0,0 +1,19 @@
+from six import add_metaclass
+
+from spinn_utilities.abstract_base import AbstractBase, abstractproperty
+
+
+@add_metaclass(AbstractBase)
+class AbstractTracesKeys(object):
+    """ A vertex whose binary counts the multicast packets it receives by\
+        source with key_trace.h
+    """
+
+    __slots__ = ()
+
+    @abstractproperty
+    def key_trace_region_id(self):
+        """ The id of the data region that holds the key trace
+
+        :rtype: int
+        """
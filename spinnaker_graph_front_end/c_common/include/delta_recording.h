@@ -0,0 +1,107 @@
+//! \file
+//! \brief Recording of the changes of a value only.
+//!
+//! Rather than recording a value every tick, a record of (tick, value) is
+//! made only when the value changes, so the data recorded, and read back
+//! by the host, grows with the activity of the core rather than with the
+//! run time.  A record is two unsigned LEB128 varints: the ticks since the
+//! previous record (at least 1, with the tick before 0 taken as the first
+//! previous record), then the value.  The records are gathered in DTCM and
+//! passed to recording_record() in blocks padded to whole words with zero
+//! bytes, which the host skips since no record starts with a zero (see
+//! delta_recording.py).
+
+#ifndef __DELTA_RECORDING_H__
+#define __DELTA_RECORDING_H__
+
+#include "common-typedefs.h"
+#include <recording.h>
+
+//! the bytes of records gathered before they are recorded
+#define DELTA_RECORDING_BUFFER_BYTES 64
+
+//! the most bytes of a record: two varints of up to 5 bytes each
+#define DELTA_RECORDING_MAX_RECORD_BYTES 10
+
+//! the changes of a value recorded to a recording channel
+typedef struct delta_recording_t {
+    //! the recording channel the records go to
+    uint8_t channel;
+    //! whether a value has been recorded yet
+    bool has_value;
+    //! the tick and value of the last record
+    uint32_t last_tick;
+    uint32_t last_value;
+    //! the bytes of records gathered
+    uint32_t n_bytes;
+    //! the records gathered, as words so that they can be recorded as is
+    uint32_t buffer[DELTA_RECORDING_BUFFER_BYTES / sizeof(uint32_t)];
+} delta_recording_t;
+
+//! \brief Start recording the changes of a value
+//! \param[in] recording: the changes to record
+//! \param[in] channel: the recording channel to record them to
+static inline void delta_recording_initialise(
+        delta_recording_t *recording, uint8_t channel) {
+    recording->channel = channel;
+    recording->has_value = false;
+    recording->last_tick = UINT32_MAX;
+    recording->last_value = 0;
+    recording->n_bytes = 0;
+}
+
+//! \brief Record the records gathered, padded to a whole number of words
+//! \param[in] recording: the changes being recorded
+static inline void delta_recording_flush(delta_recording_t *recording) {
+    if (recording->n_bytes == 0) {
+        return;
+    }
+    uint8_t *bytes = (uint8_t *) recording->buffer;
+    while (recording->n_bytes & 3) {
+        bytes[recording->n_bytes++] = 0;
+    }
+    recording_record(
+        recording->channel, recording->buffer, recording->n_bytes);
+    recording->n_bytes = 0;
+}
+
+//! \brief Add a varint to the records gathered
+//! \param[in] recording: the changes being recorded
+//! \param[in] value: the value of the varint
+static inline void _delta_recording_write_varint(
+        delta_recording_t *recording, uint32_t value) {
+    uint8_t *bytes = (uint8_t *) recording->buffer;
+    while (value >= 0x80) {
+        bytes[recording->n_bytes++] = (uint8_t) (value | 0x80);
+        value >>= 7;
+    }
+    bytes[recording->n_bytes++] = (uint8_t) value;
+}
+
+//! \brief Record the value of a tick if it has changed since the last
+//!     record, or if it is the first
+//! \param[in] recording: the changes being recorded
+//! \param[in] tick: the tick of the value, later than that of the last
+//! \param[in] value: the value
+//! \return whether a record was made
+static inline bool delta_recording_record(
+        delta_recording_t *recording, uint32_t tick, uint32_t value) {
+    if (recording->has_value && value == recording->last_value) {
+        return false;
+    }
+    _delta_recording_write_varint(recording, tick - recording->last_tick);
+    _delta_recording_write_varint(recording, value);
+    recording->has_value = true;
+    recording->last_tick = tick;
+    recording->last_value = value;
+
+    // there must be space for the next record, and its padding
+    if (recording->n_bytes >
+            DELTA_RECORDING_BUFFER_BYTES - DELTA_RECORDING_MAX_RECORD_BYTES -
+            sizeof(uint32_t)) {
+        delta_recording_flush(recording);
+    }
+    return true;
+}
+
+#endif // __DELTA_RECORDING_H__
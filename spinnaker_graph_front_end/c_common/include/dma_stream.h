@@ -0,0 +1,195 @@
+//! \file
+//! \brief Double-buffered streaming of large SDRAM regions into DTCM.
+//!
+//! A streamed region is too big to copy into DTCM, so it is fetched one
+//! block at a time by DMA into one of two DTCM buffers; while the caller
+//! works on one block the next is already being fetched into the other.
+//!
+//!     dma_stream_begin(&stream);
+//!     uint32_t n_bytes;
+//!     uint32_t *block;
+//!     while ((block = dma_stream_next(&stream, &n_bytes)) != NULL) {
+//!         ... work on n_bytes of block ...
+//!     }
+//!
+//! dma_stream_next() waits for the DMA of the block it returns, so the DMA
+//! done callback has to be able to interrupt the caller; pass a DMA
+//! priority of 0 to simulation_initialise() if the stream is read from
+//! within another callback.  Only one stream can be read at a time.
+//!
+//! The region is laid out by streamed_region.py as the size of the data in
+//! bytes, the size of the blocks in bytes (a multiple of 4), and then the
+//! data, padded to a whole number of words.  The last block may hold fewer
+//! bytes than the block size; it is fetched in whole words, but only the
+//! bytes of the data are counted in the size returned with it.
+
+#ifndef __DMA_STREAM_H__
+#define __DMA_STREAM_H__
+
+#include "spin1_api.h"
+#include "common-typedefs.h"
+#include <simulation.h>
+#include <debug.h>
+
+//! the DMA tag used to fetch the blocks of streams
+#ifndef DMA_STREAM_DMA_TAG
+#define DMA_STREAM_DMA_TAG 2
+#endif
+
+//! the number of DTCM buffers of each stream
+#define DMA_STREAM_N_BUFFERS 2
+
+//! the states a DTCM buffer of a stream goes through
+typedef enum dma_buffer_state_e {
+    DMA_BUFFER_FREE, DMA_BUFFER_FETCHING, DMA_BUFFER_READY, DMA_BUFFER_IN_USE
+} dma_buffer_state_e;
+
+//! the header of a streamed region
+typedef struct streamed_region_t {
+    uint32_t n_bytes;
+    uint32_t block_bytes;
+    uint32_t data[];
+} streamed_region_t;
+
+//! a stream of a region
+typedef struct dma_stream_t {
+    streamed_region_t *region;
+    uint32_t *buffers[DMA_STREAM_N_BUFFERS];
+    volatile dma_buffer_state_e states[DMA_STREAM_N_BUFFERS];
+    uint32_t sizes[DMA_STREAM_N_BUFFERS];
+    uint32_t n_bytes_fetched;
+    uint32_t n_bytes_returned;
+    uint32_t fetch_buffer;
+    uint32_t next_buffer;
+} dma_stream_t;
+
+//! the stream which is currently being read
+static dma_stream_t *dma_stream_active = NULL;
+
+//! whether the DMA callback has been registered
+static bool dma_stream_callback_registered = false;
+
+//! \brief Start the DMA of the next block if there is a free buffer for it
+//! \param[in] stream: the stream to fetch the next block of
+static inline void _dma_stream_fetch(dma_stream_t *stream) {
+    uint32_t buffer = stream->fetch_buffer;
+    if (stream->states[buffer] != DMA_BUFFER_FREE ||
+            stream->n_bytes_fetched >= stream->region->n_bytes) {
+        return;
+    }
+
+    uint32_t size = stream->region->n_bytes - stream->n_bytes_fetched;
+    if (size > stream->region->block_bytes) {
+        size = stream->region->block_bytes;
+    }
+    uint8_t *source = ((uint8_t *) stream->region->data) +
+        stream->n_bytes_fetched;
+    stream->states[buffer] = DMA_BUFFER_FETCHING;
+    stream->sizes[buffer] = size;
+    stream->n_bytes_fetched += size;
+
+    // DMAs are of whole words; the padding fits as the block size is too
+    uint32_t dma_size = (size + 3) & ~3;
+    while (!spin1_dma_transfer(
+            DMA_STREAM_DMA_TAG, source, stream->buffers[buffer], DMA_READ,
+            dma_size)) {
+        log_debug("DMA queue full, retrying block fetch");
+    }
+}
+
+//! \brief Callback for the completion of the DMA of a block
+//! \param[in] unused: unused
+//! \param[in] tag: the tag of the DMA
+static void _dma_stream_dma_done(uint unused, uint tag) {
+    use(unused);
+    use(tag);
+
+    dma_stream_t *stream = dma_stream_active;
+    stream->states[stream->fetch_buffer] = DMA_BUFFER_READY;
+    stream->fetch_buffer =
+        (stream->fetch_buffer + 1) % DMA_STREAM_N_BUFFERS;
+    _dma_stream_fetch(stream);
+}
+
+//! \brief Set up a stream of a region
+//! \param[in] stream: the stream to set up
+//! \param[in] region: the streamed region in SDRAM
+//! \return True if the set up was successful, False otherwise
+static inline bool dma_stream_initialise(
+        dma_stream_t *stream, address_t region) {
+    stream->region = (streamed_region_t *) region;
+    for (uint32_t i = 0; i < DMA_STREAM_N_BUFFERS; i++) {
+        stream->buffers[i] = spin1_malloc(stream->region->block_bytes);
+        if (stream->buffers[i] == NULL) {
+            log_error("Could not allocate a stream buffer of %d bytes",
+                      stream->region->block_bytes);
+            return false;
+        }
+        stream->states[i] = DMA_BUFFER_FREE;
+    }
+    log_info("streaming %d bytes from 0x%08x in blocks of %d bytes",
+             stream->region->n_bytes, stream->region->data,
+             stream->region->block_bytes);
+
+    if (!dma_stream_callback_registered) {
+        if (!simulation_dma_transfer_done_callback_on(
+                DMA_STREAM_DMA_TAG, _dma_stream_dma_done)) {
+            log_error("Could not register the stream DMA callback");
+            return false;
+        }
+        dma_stream_callback_registered = true;
+    }
+    return true;
+}
+
+//! \brief Start reading a stream from the start of its region
+//! \param[in] stream: the stream to read
+static inline void dma_stream_begin(dma_stream_t *stream) {
+    uint cpsr = spin1_int_disable();
+    dma_stream_active = stream;
+    stream->n_bytes_fetched = 0;
+    stream->n_bytes_returned = 0;
+    stream->fetch_buffer = 0;
+    stream->next_buffer = 0;
+    for (uint32_t i = 0; i < DMA_STREAM_N_BUFFERS; i++) {
+        stream->states[i] = DMA_BUFFER_FREE;
+    }
+    _dma_stream_fetch(stream);
+    spin1_mode_restore(cpsr);
+}
+
+//! \brief Get the next block of a stream; the block returned by the
+//!     previous call is handed back to be filled again
+//! \param[in] stream: the stream to read
+//! \param[out] n_bytes: the number of bytes in the block
+//! \return the block, or NULL if the whole region has been read
+static inline uint32_t *dma_stream_next(
+        dma_stream_t *stream, uint32_t *n_bytes) {
+
+    // Hand back the buffer of the previous block
+    uint cpsr = spin1_int_disable();
+    for (uint32_t i = 0; i < DMA_STREAM_N_BUFFERS; i++) {
+        if (stream->states[i] == DMA_BUFFER_IN_USE) {
+            stream->states[i] = DMA_BUFFER_FREE;
+        }
+    }
+    _dma_stream_fetch(stream);
+    spin1_mode_restore(cpsr);
+
+    if (stream->n_bytes_returned >= stream->region->n_bytes) {
+        return NULL;
+    }
+
+    // Wait for the DMA of the next block to complete
+    uint32_t buffer = stream->next_buffer;
+    while (stream->states[buffer] != DMA_BUFFER_READY) {
+        continue;
+    }
+    stream->states[buffer] = DMA_BUFFER_IN_USE;
+    stream->next_buffer = (buffer + 1) % DMA_STREAM_N_BUFFERS;
+    stream->n_bytes_returned += stream->sizes[buffer];
+    *n_bytes = stream->sizes[buffer];
+    return stream->buffers[buffer];
+}
+
+#endif  // __DMA_STREAM_H__
@@ -0,0 +1,191 @@
+//! \file
+//! \brief Fixed point arithmetic for numeric vertices.
+//!
+//! The cores have no floating point unit, so numeric applications keep
+//! their values in fixed point: signed 16.15 (s1615_t, the same layout as
+//! the accum type of spinn_common) for values, and unsigned 0.32 (u032_t)
+//! for fractions such as probabilities and weights.  Products are rounded
+//! to the nearest representable value, halves rounding up, and results
+//! outside the range of s16.15 saturate.
+//!
+//! Sums of products (s1615_dot(), s1615_axpy(), s1615_stencil_sweep()) are
+//! accumulated exactly in 64 bits and rounded once at the end, which the
+//! compiler turns into one SMLAL per term; this is exact as long as the
+//! partial sums stay within the +/-2^63 of the accumulator, which with its
+//! 30 fractional bits is +/-2^33 in value: room for 2^33 products of values
+//! up to 1.0, but only two products of values at the limits of s16.15.
+//! Sums of products of fractions (u032_mac()) are accumulated the same way
+//! with 64 fractional bits, so they hold sums below 1.0; a sum that reaches
+//! 1.0 saturates.
+//! Where the ARM DSP instructions are available, saturating additions use
+//! QADD and QSUB.  Everything here also builds on the host, where
+//! c_common/test checks it bit for bit against a reference.
+
+#ifndef __FIXED_POINT_KERNELS_H__
+#define __FIXED_POINT_KERNELS_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+//! a signed 16.15 fixed point number
+typedef int32_t s1615_t;
+
+//! an unsigned 0.32 fixed point number
+typedef uint32_t u032_t;
+
+//! the number of fractional bits of s1615_t
+#define S1615_SHIFT 15
+
+//! 1.0 as an s1615_t
+#define S1615_ONE ((s1615_t) (1 << S1615_SHIFT))
+
+//! the largest and smallest s1615_t
+#define S1615_MAX ((s1615_t) INT32_MAX)
+#define S1615_MIN ((s1615_t) INT32_MIN)
+
+//! \brief Clamp a 64 bit value to the range of s1615_t
+static inline s1615_t s1615_saturate(int64_t value) {
+    if (value > S1615_MAX) {
+        return S1615_MAX;
+    }
+    if (value < S1615_MIN) {
+        return S1615_MIN;
+    }
+    return (s1615_t) value;
+}
+
+//! \brief Add two values, saturating
+static inline s1615_t s1615_add_sat(s1615_t a, s1615_t b) {
+#ifdef __ARM_FEATURE_DSP
+    s1615_t result;
+    __asm__ ("qadd %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+    return result;
+#else
+    return s1615_saturate((int64_t) a + b);
+#endif
+}
+
+//! \brief Subtract one value from another, saturating
+static inline s1615_t s1615_sub_sat(s1615_t a, s1615_t b) {
+#ifdef __ARM_FEATURE_DSP
+    s1615_t result;
+    __asm__ ("qsub %0, %1, %2" : "=r" (result) : "r" (a), "r" (b));
+    return result;
+#else
+    return s1615_saturate((int64_t) a - b);
+#endif
+}
+
+//! \brief Round and saturate an accumulator of products, each with
+//!     2 * S1615_SHIFT fractional bits, to an s1615_t
+static inline s1615_t s1615_from_accumulator(int64_t accumulator) {
+    return s1615_saturate(
+        (accumulator + (1 << (S1615_SHIFT - 1))) >> S1615_SHIFT);
+}
+
+//! \brief Add the exact product of two values to an accumulator, to be
+//!     rounded once with s1615_from_accumulator()
+static inline int64_t s1615_mac(int64_t accumulator, s1615_t a, s1615_t b) {
+    return accumulator + (int64_t) a * b;
+}
+
+//! \brief Multiply two values, rounding and saturating
+static inline s1615_t s1615_mul(s1615_t a, s1615_t b) {
+    return s1615_from_accumulator((int64_t) a * b);
+}
+
+//! \brief The dot product of two vectors, rounded once
+//! \param[in] a: the first vector
+//! \param[in] b: the second vector
+//! \param[in] n: the length of the vectors
+static inline s1615_t s1615_dot(
+        const s1615_t *a, const s1615_t *b, uint32_t n) {
+    int64_t accumulator = 0;
+    for (uint32_t i = 0; i < n; i++) {
+        accumulator += (int64_t) a[i] * b[i];
+    }
+    return s1615_from_accumulator(accumulator);
+}
+
+//! \brief y = y + scale * x, element by element, rounding each element once
+//! \param[in,out] y: the vector added to
+//! \param[in] scale: the value x is multiplied by
+//! \param[in] x: the vector added
+//! \param[in] n: the length of the vectors
+static inline void s1615_axpy(
+        s1615_t *y, s1615_t scale, const s1615_t *x, uint32_t n) {
+    for (uint32_t i = 0; i < n; i++) {
+        y[i] = s1615_from_accumulator(
+            (int64_t) y[i] * S1615_ONE + (int64_t) scale * x[i]);
+    }
+}
+
+//! \brief One sweep of a five point stencil over a row-major grid:
+//!     out = centre * in + neighbour * (north + south + east + west).  The
+//!     cells on the edge of the grid have no stencil, and are copied.
+//! \param[in] in: the grid before the sweep
+//! \param[out] out: the grid after the sweep; must not overlap in
+//! \param[in] width: the number of cells in a row
+//! \param[in] height: the number of rows
+//! \param[in] centre: the weight of the cell itself
+//! \param[in] neighbour: the weight of each of its four neighbours
+static inline void s1615_stencil_sweep(
+        const s1615_t *in, s1615_t *out, uint32_t width, uint32_t height,
+        s1615_t centre, s1615_t neighbour) {
+    for (uint32_t y = 0; y < height; y++) {
+        const s1615_t *row = &in[y * width];
+        s1615_t *out_row = &out[y * width];
+        if (y == 0 || y == height - 1 || width < 3) {
+            for (uint32_t x = 0; x < width; x++) {
+                out_row[x] = row[x];
+            }
+            continue;
+        }
+        const s1615_t *north = &in[(y - 1) * width];
+        const s1615_t *south = &in[(y + 1) * width];
+        out_row[0] = row[0];
+        for (uint32_t x = 1; x < width - 1; x++) {
+            int64_t accumulator = (int64_t) centre * row[x];
+            accumulator += (int64_t) neighbour * north[x];
+            accumulator += (int64_t) neighbour * south[x];
+            accumulator += (int64_t) neighbour * row[x - 1];
+            accumulator += (int64_t) neighbour * row[x + 1];
+            out_row[x] = s1615_from_accumulator(accumulator);
+        }
+        out_row[width - 1] = row[width - 1];
+    }
+}
+
+//! \brief Round and saturate an accumulator of products of fractions, each
+//!     with 64 fractional bits, to a u032_t
+static inline u032_t u032_from_accumulator(uint64_t accumulator) {
+    uint64_t result = (accumulator >> 32) + ((accumulator >> 31) & 1);
+    if (result > UINT32_MAX) {
+        return UINT32_MAX;
+    }
+    return (u032_t) result;
+}
+
+//! \brief Add the exact product of two fractions to an accumulator, to be
+//!     rounded once with u032_from_accumulator(); a sum that reaches 1.0
+//!     saturates the accumulator
+static inline uint64_t u032_mac(uint64_t accumulator, u032_t a, u032_t b) {
+    uint64_t sum = accumulator + (uint64_t) a * b;
+    if (sum < accumulator) {
+        return UINT64_MAX;
+    }
+    return sum;
+}
+
+//! \brief Multiply two fractions, rounding
+static inline u032_t u032_mul(u032_t a, u032_t b) {
+    return u032_from_accumulator((uint64_t) a * b);
+}
+
+//! \brief Scale a value by a fraction, rounding; this cannot saturate
+static inline s1615_t u032_scale(s1615_t value, u032_t fraction) {
+    return (s1615_t) (
+        ((int64_t) value * (int64_t) fraction + (1ll << 31)) >> 32);
+}
+
+#endif  // __FIXED_POINT_KERNELS_H__
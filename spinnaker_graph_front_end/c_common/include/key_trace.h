@@ -0,0 +1,122 @@
+//! \file
+//! \brief Counting of the multicast packets received, by source.
+//!
+//! The key trace region holds the key and mask of each outgoing partition
+//! with an edge to this core, in increasing order of key, and a count of
+//! the packets received from each.  When tracing is turned on (in the
+//! [KeyTrace] section of the config) one packet in every sample period is
+//! looked up and counted; otherwise tracing costs a test per packet.  The
+//! counts are kept in DTCM and written back to the region when the
+//! application pauses or ends, from where the host maps them back to the
+//! edges, links and chips of the graph (see key_trace.py).
+
+#ifndef __KEY_TRACE_H__
+#define __KEY_TRACE_H__
+
+#include "spin1_api.h"
+#include "common-typedefs.h"
+#include <debug.h>
+
+//! a source of packets and the packets counted from it
+typedef struct key_trace_entry_t {
+    uint32_t key;
+    uint32_t mask;
+    uint32_t count;
+} key_trace_entry_t;
+
+//! the layout of the key trace region
+typedef struct key_trace_region_t {
+    //! one packet in every this many is counted, or 0 for none
+    uint32_t sample_period;
+    uint32_t n_entries;
+    //! the packets received, whether counted or not
+    uint32_t n_received;
+    //! the packets counted which matched no entry
+    uint32_t n_unmatched;
+    key_trace_entry_t entries[];
+} key_trace_region_t;
+
+//! the region, which the counts are written back to
+static key_trace_region_t *key_trace_region = NULL;
+
+//! the entries, in DTCM while tracing
+static key_trace_entry_t *key_trace_entries = NULL;
+
+//! the packets received and the packets matching no entry
+static uint32_t key_trace_n_received = 0;
+static uint32_t key_trace_n_unmatched = 0;
+
+//! the packets left before the next one counted
+static uint32_t key_trace_countdown = 0;
+
+//! \brief Set up the tracing of keys
+//! \param[in] region: the key trace region
+//! \return whether the entries could be copied to DTCM
+static inline bool key_trace_initialise(address_t region) {
+    key_trace_region = (key_trace_region_t *) region;
+    key_trace_countdown = key_trace_region->sample_period;
+    if (key_trace_countdown == 0) {
+        return true;
+    }
+
+    uint32_t n_bytes =
+        key_trace_region->n_entries * sizeof(key_trace_entry_t);
+    key_trace_entries = spin1_malloc(n_bytes > 0 ? n_bytes : 4);
+    if (key_trace_entries == NULL) {
+        log_error("Could not allocate the %d key trace entries",
+            key_trace_region->n_entries);
+        return false;
+    }
+    spin1_memcpy(key_trace_entries, key_trace_region->entries, n_bytes);
+    for (uint32_t i = 0; i < key_trace_region->n_entries; i++) {
+        key_trace_entries[i].count = 0;
+    }
+    return true;
+}
+
+//! \brief Count a packet received; call first thing in the packet callback
+//! \param[in] key: the key of the packet
+static inline void key_trace_record(uint32_t key) {
+    if (key_trace_countdown == 0) {
+        return;
+    }
+    key_trace_n_received += 1;
+    key_trace_countdown -= 1;
+    if (key_trace_countdown != 0) {
+        return;
+    }
+    key_trace_countdown = key_trace_region->sample_period;
+
+    // the last entry with a key no greater than this one
+    uint32_t low = 0;
+    uint32_t high = key_trace_region->n_entries;
+    while (low < high) {
+        uint32_t middle = (low + high) / 2;
+        if (key_trace_entries[middle].key <= key) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low > 0 && (key & key_trace_entries[low - 1].mask) ==
+            key_trace_entries[low - 1].key) {
+        key_trace_entries[low - 1].count += 1;
+    } else {
+        key_trace_n_unmatched += 1;
+    }
+}
+
+//! \brief Write the counts back to the region for the host; call when the
+//!     application pauses
+static inline void key_trace_write_back(void) {
+    if (key_trace_entries == NULL) {
+        return;
+    }
+    key_trace_region->n_received = key_trace_n_received;
+    key_trace_region->n_unmatched = key_trace_n_unmatched;
+    for (uint32_t i = 0; i < key_trace_region->n_entries; i++) {
+        key_trace_region->entries[i].count = key_trace_entries[i].count;
+    }
+}
+
+#endif  // __KEY_TRACE_H__
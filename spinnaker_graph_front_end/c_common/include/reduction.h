@@ -0,0 +1,164 @@
+//! \file
+//! \brief Contributing values to global reductions.
+//!
+//! A vertex taking part in a reduction tree (see reduction_tree.py) sends
+//! one value per reduction every period ticks with reduction_contribute().
+//! The values are combined by an aggregator core on each chip, then on each
+//! board, and the results are recorded for the host by the root of the
+//! tree.  If the tree delivers its results back, pass every multicast
+//! packet to reduction_receive() first and read them with
+//! reduction_get_result().
+//!
+//! A tree can also end a run_until_complete() run: each core says whether
+//! it is done every period with reduction_signal_done(), and once every
+//! core is done in the same period the root tells every core of the tree.
+//! reduction_is_complete() is then true, and the core should write out
+//! what the host reads and call simulation_exit(); the aggregators exit by
+//! themselves.
+
+#ifndef __REDUCTION_H__
+#define __REDUCTION_H__
+
+#include "spin1_api.h"
+#include "common-typedefs.h"
+#include <debug.h>
+
+//! the ways values can be combined; values are unsigned, and sums saturate
+typedef enum reduction_operation_e {
+    REDUCTION_SUM, REDUCTION_MIN, REDUCTION_MAX
+} reduction_operation_e;
+
+//! the most reductions a tree can carry
+#define REDUCTION_MAX_REDUCTIONS 8
+
+//! the layout of the reduction region of a contributor
+typedef struct reduction_config_t {
+    //! the key of reduction 0; reduction i is sent with key + i
+    uint32_t key;
+    //! the number of ticks between contributions
+    uint32_t period;
+    uint32_t n_reductions;
+    //! whether the results are sent back, and the keys they arrive with
+    uint32_t has_results;
+    uint32_t result_key;
+    uint32_t result_mask;
+    //! the index + 1 of the reduction saying whether every core is done,
+    //! or 0 if the tree does not end the run
+    uint32_t completion_reduction;
+} reduction_config_t;
+
+static reduction_config_t reduction_config;
+
+//! the latest result of each reduction, and how many have arrived
+static uint32_t reduction_results[REDUCTION_MAX_REDUCTIONS];
+static volatile uint32_t reduction_n_results[REDUCTION_MAX_REDUCTIONS];
+
+//! \brief Combine two values of a reduction
+static inline uint32_t reduction_combine(
+        reduction_operation_e operation, uint32_t a, uint32_t b) {
+    switch (operation) {
+    case REDUCTION_MIN:
+        return (a < b) ? a : b;
+    case REDUCTION_MAX:
+        return (a > b) ? a : b;
+    default:
+        return (a + b < a) ? UINT32_MAX : a + b;
+    }
+}
+
+//! \brief Read the reduction region of this core
+//! \param[in] region: the reduction region
+//! \return true if the region is valid
+static inline bool reduction_initialise(address_t region) {
+    spin1_memcpy(&reduction_config, region, sizeof(reduction_config));
+    if (reduction_config.n_reductions > REDUCTION_MAX_REDUCTIONS ||
+            reduction_config.completion_reduction >
+            reduction_config.n_reductions ||
+            reduction_config.period == 0) {
+        log_error("bad reduction region: %d reductions every %d ticks",
+                  reduction_config.n_reductions, reduction_config.period);
+        return false;
+    }
+    for (uint32_t i = 0; i < REDUCTION_MAX_REDUCTIONS; i++) {
+        reduction_results[i] = 0;
+        reduction_n_results[i] = 0;
+    }
+    return true;
+}
+
+//! \brief Contribute a value to a reduction; the value is only sent at the
+//!     end of each period, on the ticks where (time + 1) is a multiple of it
+//! \param[in] reduction: the index of the reduction
+//! \param[in] time: the current tick
+//! \param[in] value: the value of this core
+//! \return true if the value was sent
+static inline bool reduction_contribute(
+        uint32_t reduction, uint32_t time, uint32_t value) {
+    if (reduction >= reduction_config.n_reductions ||
+            ((time + 1) % reduction_config.period) != 0) {
+        return false;
+    }
+    while (!spin1_send_mc_packet(
+            reduction_config.key + reduction, value, WITH_PAYLOAD)) {
+        spin1_delay_us(1);
+    }
+    return true;
+}
+
+//! \brief Say whether this core is done, as its contribution to the
+//!     completion reduction; sent only at the end of each period, as with
+//!     reduction_contribute()
+//! \param[in] time: the current tick
+//! \param[in] done: whether this core has nothing more to do
+//! \return true if the signal was sent
+static inline bool reduction_signal_done(uint32_t time, bool done) {
+    if (reduction_config.completion_reduction == 0) {
+        return false;
+    }
+    return reduction_contribute(
+        reduction_config.completion_reduction - 1, time, done ? 1 : 0);
+}
+
+//! \brief Take a packet if it is a result of a reduction
+//! \param[in] key: the key of the packet
+//! \param[in] payload: the payload of the packet
+//! \return true if the packet was a result, so needs no more handling
+static inline bool reduction_receive(uint32_t key, uint32_t payload) {
+    if (!reduction_config.has_results ||
+            (key & reduction_config.result_mask) !=
+            reduction_config.result_key) {
+        return false;
+    }
+    uint32_t reduction = key & ~reduction_config.result_mask;
+    if (reduction < reduction_config.n_reductions) {
+        reduction_results[reduction] = payload;
+        reduction_n_results[reduction] += 1;
+    }
+    return true;
+}
+
+//! \brief Get the latest result of a reduction
+//! \param[in] reduction: the index of the reduction
+//! \param[out] n_results: the number of results received so far, so that a
+//!     new one can be told from the last; may be NULL
+//! \return the result, or 0 if none has arrived
+static inline uint32_t reduction_get_result(
+        uint32_t reduction, uint32_t *n_results) {
+    if (n_results != NULL) {
+        *n_results = reduction_n_results[reduction];
+    }
+    return reduction_results[reduction];
+}
+
+//! \brief Whether every core of the tree has said it is done in the same
+//!     period, so that the run should end
+static inline bool reduction_is_complete(void) {
+    if (reduction_config.completion_reduction == 0) {
+        return false;
+    }
+    uint32_t reduction = reduction_config.completion_reduction - 1;
+    return reduction_n_results[reduction] > 0 &&
+        reduction_results[reduction] != 0;
+}
+
+#endif  // __REDUCTION_H__
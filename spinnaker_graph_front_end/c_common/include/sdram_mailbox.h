@@ -0,0 +1,288 @@
+//! \file
+//! \brief Shared SDRAM mailboxes between vertices placed on the same chip.
+//!
+//! A producer writes its data for timer tick t into slot (t & 1) of a
+//! mailbox region in its own data specification.  A consumer on the same
+//! chip finds that region through the producer's user0 register and reads
+//! the slot written on the previous tick by DMA at the start of its tick.
+//!
+//! Each slot holds the time it was written for both before and after the
+//! data.  The producer writes the time after the data first and the time
+//! before it last, and the DMA reads forwards, so a read overlapping a
+//! write sees two different times.  A read which does not find the time of
+//! the previous tick in both is retried a few times, in case the producer
+//! is just behind, and the mailbox is then treated as missing for the tick
+//! rather than giving data of another tick.
+//!
+//! The layout of the regions is written by sdram_mailbox_utilities.py.
+
+#ifndef __SDRAM_MAILBOX_H__
+#define __SDRAM_MAILBOX_H__
+
+#include "spin1_api.h"
+#include <sark.h>
+#include "common-typedefs.h"
+#include <data_specification.h>
+#include <simulation.h>
+#include <debug.h>
+
+//! the DMA tag used to read the mailboxes
+#ifndef SDRAM_MAILBOX_DMA_TAG
+#define SDRAM_MAILBOX_DMA_TAG 1
+#endif
+
+//! the number of times a stale read is retried before the mailbox is
+//! treated as missing
+#ifndef SDRAM_MAILBOX_N_RETRIES
+#define SDRAM_MAILBOX_N_RETRIES 4
+#endif
+
+//! the number of slots in each mailbox
+#define SDRAM_MAILBOX_N_SLOTS 2
+
+//! the words of a slot besides the data: the time before and after it
+#define SDRAM_MAILBOX_SLOT_HEADER_WORDS 2
+
+//! a slot of a mailbox; the time it was written, the data, and the time
+//! again
+typedef struct mailbox_slot_t {
+    uint32_t time;
+    uint32_t data[];
+} mailbox_slot_t;
+
+//! the producer side of a mailbox, as laid out in SDRAM
+typedef struct mailbox_region_t {
+    uint32_t n_words;
+    uint32_t slots[];
+} mailbox_region_t;
+
+//! a mailbox read by this core
+typedef struct mailbox_t {
+    mailbox_region_t *region;
+    mailbox_slot_t *buffer;
+    //! whether the buffer holds the data of the tick read
+    bool valid;
+} mailbox_t;
+
+//! a key and mask of a producer whose packets are also read from SDRAM
+typedef struct mailbox_key_filter_t {
+    uint32_t key;
+    uint32_t mask;
+} mailbox_key_filter_t;
+
+//! the mailbox region of this core, if it is a producer
+static mailbox_region_t *mailbox_own_region = NULL;
+
+//! the mailboxes this core reads
+static mailbox_t *mailboxes = NULL;
+static uint32_t mailbox_n_reads = 0;
+
+//! the keys of packets which duplicate data read from SDRAM
+static mailbox_key_filter_t *mailbox_filters = NULL;
+static uint32_t mailbox_n_filters = 0;
+
+//! the progress of the reads of the current tick
+static uint32_t mailbox_next_read = 0;
+static uint32_t mailbox_read_time = 0;
+static uint32_t mailbox_n_retries = 0;
+
+//! the number of mailboxes treated as missing because their slot had not
+//! been updated, or was being written, however often it was read
+static uint32_t mailbox_n_stale_reads = 0;
+
+//! called when all the mailboxes of a tick have been read
+static void (*mailbox_reads_done_callback)(void) = NULL;
+
+//! \brief Get the size of a slot in words
+//! \param[in] region: the mailbox region
+//! \return the size of a slot in words including the times
+static inline uint32_t _sdram_mailbox_slot_words(mailbox_region_t *region) {
+    return region->n_words + SDRAM_MAILBOX_SLOT_HEADER_WORDS;
+}
+
+//! \brief Get a slot of a mailbox
+//! \param[in] region: the mailbox region
+//! \param[in] time: the time of the tick the slot is for
+//! \return the slot
+static inline mailbox_slot_t *_sdram_mailbox_slot(
+        mailbox_region_t *region, uint32_t time) {
+    return (mailbox_slot_t *) &region->slots[
+        (time & (SDRAM_MAILBOX_N_SLOTS - 1)) *
+        _sdram_mailbox_slot_words(region)];
+}
+
+//! \brief Set up the mailbox this core writes to
+//! \param[in] region: the mailbox region of this core
+static inline void sdram_mailbox_producer_initialise(address_t region) {
+    mailbox_own_region = (mailbox_region_t *) region;
+    log_info("mailbox of %d words at 0x%08x",
+             mailbox_own_region->n_words, mailbox_own_region);
+}
+
+//! \brief Write the data of this tick into the mailbox of this core
+//! \param[in] time: the current time
+//! \param[in] data: the data to write; the size of the mailbox in words
+static inline void sdram_mailbox_write(uint32_t time, uint32_t *data) {
+    mailbox_slot_t *slot = _sdram_mailbox_slot(mailbox_own_region, time);
+    uint32_t n_words = mailbox_own_region->n_words;
+
+    // The time after the data is written first and the time before it
+    // last, so that a read overlapping the write sees different times
+    slot->data[n_words] = time;
+    for (uint32_t i = 0; i < n_words; i++) {
+        slot->data[i] = data[i];
+    }
+    slot->time = time;
+}
+
+//! \brief Start the DMA of the next mailbox, or report that all are done
+static inline void _sdram_mailbox_read_next(void) {
+    if (mailbox_next_read >= mailbox_n_reads) {
+        mailbox_reads_done_callback();
+        return;
+    }
+
+    mailbox_t *mailbox = &mailboxes[mailbox_next_read];
+    uint32_t n_words = _sdram_mailbox_slot_words(mailbox->region);
+    while (!spin1_dma_transfer(
+            SDRAM_MAILBOX_DMA_TAG,
+            _sdram_mailbox_slot(mailbox->region, mailbox_read_time),
+            mailbox->buffer, DMA_READ, n_words * sizeof(uint32_t))) {
+        log_debug("DMA queue full, retrying mailbox read");
+    }
+}
+
+//! \brief Callback for the completion of the DMA of a mailbox
+//! \param[in] unused: unused
+//! \param[in] tag: the tag of the DMA
+static void _sdram_mailbox_dma_done(uint unused, uint tag) {
+    use(unused);
+    use(tag);
+
+    mailbox_t *mailbox = &mailboxes[mailbox_next_read];
+    mailbox_slot_t *buffer = mailbox->buffer;
+    mailbox->valid = buffer->time == mailbox_read_time &&
+        buffer->data[mailbox->region->n_words] == mailbox_read_time;
+    if (!mailbox->valid) {
+        if (mailbox_n_retries < SDRAM_MAILBOX_N_RETRIES) {
+            mailbox_n_retries += 1;
+            _sdram_mailbox_read_next();
+            return;
+        }
+        mailbox_n_stale_reads += 1;
+        log_warning("mailbox %d holds time %d instead of %d, so is missing",
+                    mailbox_next_read, buffer->time, mailbox_read_time);
+    }
+    mailbox_n_retries = 0;
+    mailbox_next_read += 1;
+    _sdram_mailbox_read_next();
+}
+
+//! \brief Set up the mailboxes this core reads from
+//! \param[in] region: the mailbox reads region of this core
+//! \param[in] reads_done_callback: called once all the mailboxes of a tick
+//!     have been read; from within sdram_mailbox_read_all() if this core
+//!     has no mailboxes to read, or from the DMA callback otherwise
+//! \return True if the set up was successful, False otherwise
+static inline bool sdram_mailbox_consumer_initialise(
+        address_t region, void (*reads_done_callback)(void)) {
+    mailbox_reads_done_callback = reads_done_callback;
+
+    mailbox_n_reads = region[0];
+    address_t read_data = &region[1];
+    if (mailbox_n_reads > 0) {
+        mailboxes = spin1_malloc(mailbox_n_reads * sizeof(mailbox_t));
+        if (mailboxes == NULL) {
+            log_error("Could not allocate the mailboxes");
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < mailbox_n_reads; i++) {
+        uint32_t core = read_data[0];
+        uint32_t region_id = read_data[1];
+        uint32_t n_words = read_data[2];
+        read_data = &read_data[3];
+
+        // The producer is on this chip, so its regions can be found in the
+        // same way as the ones of this core
+        address_t producer_address = (address_t) sv_vcpu[core].user0;
+        mailboxes[i].region = (mailbox_region_t *)
+            data_specification_get_region(region_id, producer_address);
+        mailboxes[i].buffer = spin1_malloc(
+            (n_words + SDRAM_MAILBOX_SLOT_HEADER_WORDS) * sizeof(uint32_t));
+        mailboxes[i].valid = false;
+        if (mailboxes[i].buffer == NULL) {
+            log_error("Could not allocate the buffer of mailbox %d", i);
+            return false;
+        }
+        log_info("reading mailbox of core %d at 0x%08x",
+                 core, mailboxes[i].region);
+    }
+
+    mailbox_n_filters = read_data[0];
+    if (mailbox_n_filters > 0) {
+
+        // The filters are checked on every packet, so keep them in DTCM
+        uint32_t filter_size = mailbox_n_filters * sizeof(mailbox_key_filter_t);
+        mailbox_filters = spin1_malloc(filter_size);
+        if (mailbox_filters == NULL) {
+            log_error("Could not allocate the mailbox key filters");
+            return false;
+        }
+        spin1_memcpy(mailbox_filters, &read_data[1], filter_size);
+    }
+
+    if (mailbox_n_reads > 0 && !simulation_dma_transfer_done_callback_on(
+            SDRAM_MAILBOX_DMA_TAG, _sdram_mailbox_dma_done)) {
+        log_error("Could not register the mailbox DMA callback");
+        return false;
+    }
+    return true;
+}
+
+//! \brief Read all the mailboxes written on the previous tick
+//! \param[in] time: the current time
+static inline void sdram_mailbox_read_all(uint32_t time) {
+    mailbox_read_time = time - 1;
+    mailbox_next_read = 0;
+    mailbox_n_retries = 0;
+    _sdram_mailbox_read_next();
+}
+
+//! \brief Get the data read from a mailbox on this tick
+//! \param[in] index: the index of the mailbox
+//! \return the data words of the mailbox, or NULL if the mailbox did not
+//!     hold the data of the previous tick, which must then be treated as
+//!     missing
+static inline uint32_t *sdram_mailbox_data(uint32_t index) {
+    if (!mailboxes[index].valid) {
+        return NULL;
+    }
+    return mailboxes[index].buffer->data;
+}
+
+//! \brief Get the number of mailboxes this core reads
+//! \return the number of mailboxes
+static inline uint32_t sdram_mailbox_n_reads(void) {
+    return mailbox_n_reads;
+}
+
+//! \brief Get the number of mailboxes treated as missing
+//! \return the number of stale reads so far
+static inline uint32_t sdram_mailbox_n_stale_reads(void) {
+    return mailbox_n_stale_reads;
+}
+
+//! \brief Determine if a packet duplicates data read from a mailbox
+//! \param[in] key: the key of the packet
+//! \return True if the packet should be dropped
+static inline bool sdram_mailbox_is_filtered_key(uint32_t key) {
+    for (uint32_t i = 0; i < mailbox_n_filters; i++) {
+        if ((key & mailbox_filters[i].mask) == mailbox_filters[i].key) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#endif  // __SDRAM_MAILBOX_H__
@@ -0,0 +1,101 @@
+//! \file
+//! \brief Measurement of the cost of timer ticks.
+//!
+//! Records, in a small SDRAM region, how many CPU cycles the work of each
+//! timer tick took from the timer interrupt, along with counts of ticks
+//! that overran and of packets the application knows it lost.  The host
+//! reads the region to pick the smallest safe machine time step (see
+//! tick_profile.py).  Timer 2 is used as a free running cycle counter.
+
+#ifndef __TICK_PROFILER_H__
+#define __TICK_PROFILER_H__
+
+#include "spin1_api.h"
+#include <sark.h>
+#include "common-typedefs.h"
+#include <debug.h>
+
+//! timer 2 control: enabled, 32 bit, free running, no prescaling
+#define TICK_PROFILER_T2_CONTROL 0x82
+
+//! the layout of the tick profile region
+typedef struct tick_profile_t {
+    uint32_t max_tick_cycles;
+    uint32_t total_tick_cycles_low;
+    uint32_t total_tick_cycles_high;
+    uint32_t n_ticks;
+    uint32_t n_overruns;
+    uint32_t n_lost_packets;
+    uint32_t dtcm_used_bytes;
+} tick_profile_t;
+
+//! the profile of this core in SDRAM
+static tick_profile_t *tick_profile = NULL;
+
+//! the cycles between the timer interrupt and the start of the callback
+static uint32_t tick_profiler_latency;
+
+//! the value of timer 2 at the start of the callback
+static uint32_t tick_profiler_t2_start;
+
+//! \brief Set up the profiling of timer ticks
+//! \param[in] region: the tick profile region
+static inline void tick_profiler_initialise(address_t region) {
+    tick_profile = (tick_profile_t *) region;
+    tick_profile->max_tick_cycles = 0;
+    tick_profile->total_tick_cycles_low = 0;
+    tick_profile->total_tick_cycles_high = 0;
+    tick_profile->n_ticks = 0;
+    tick_profile->n_overruns = 0;
+    tick_profile->n_lost_packets = 0;
+    tick_profile->dtcm_used_bytes = 0;
+
+    tc[T2_CONTROL] = TICK_PROFILER_T2_CONTROL;
+}
+
+//! \brief Mark the start of the work of a timer tick; call first thing in
+//!     the timer callback
+static inline void tick_profiler_start_tick(void) {
+    tick_profiler_t2_start = tc[T2_COUNT];
+    tick_profiler_latency = tc[T1_LOAD] - tc[T1_COUNT];
+}
+
+//! \brief Mark the end of the work of a timer tick; call once everything
+//!     the tick started, including any DMA it waited on, has finished
+static inline void tick_profiler_end_tick(void) {
+
+    // Timer 2 counts down
+    uint32_t cycles = tick_profiler_latency +
+        (tick_profiler_t2_start - tc[T2_COUNT]);
+
+    if (cycles > tick_profile->max_tick_cycles) {
+        tick_profile->max_tick_cycles = cycles;
+    }
+    uint32_t low = tick_profile->total_tick_cycles_low + cycles;
+    if (low < cycles) {
+        tick_profile->total_tick_cycles_high += 1;
+    }
+    tick_profile->total_tick_cycles_low = low;
+    tick_profile->n_ticks += 1;
+    if (cycles > tc[T1_LOAD]) {
+        tick_profile->n_overruns += 1;
+    }
+}
+
+//! \brief Count packets the application knows it has lost, e.g. ones it
+//!     could not buffer or expected but never received
+//! \param[in] n_packets: the number of packets lost
+static inline void tick_profiler_record_lost_packets(uint32_t n_packets) {
+    tick_profile->n_lost_packets += n_packets;
+}
+
+//! \brief Record how much DTCM the binary uses; call once everything has
+//!     been allocated, i.e. at the end of initialisation.  Everything that
+//!     is not in the largest free block of the heap counts as used,
+//!     including the code, static data and the stack.
+static inline void tick_profiler_record_dtcm_usage(void) {
+    tick_profile->dtcm_used_bytes =
+        (DTCM_TOP - DTCM_BASE) - sark_heap_max(sark.heap, 0);
+}
+
+#endif  // __TICK_PROFILER_H__
@@ -0,0 +1,186 @@
+//! \file
+//! \brief Tokenised logging to a ring in SDRAM.
+//!
+//! When a binary is built with TOKEN_LOGGING=1 (see Makefile.token_log),
+//! each log_info(), log_debug(), log_warning() and log_error() of its
+//! sources is replaced by token_log_record(), with the number of the
+//! message in a dictionary saved next to the binary and the arguments as
+//! raw words.  Nothing is formatted on the core: a record of a header word
+//! (the number of arguments in the top 8 bits, the token in the rest) and
+//! the arguments is written to a ring in SDRAM, and once the ring is full
+//! the oldest records make way for the newest.  When a record does not fit
+//! before the end of the ring, a zero word marks the rest of the ring as
+//! unused and the record starts again at the beginning.  The host finds
+//! the ring through the user2 register of the core and rebuilds the
+//! messages from the dictionary (see token_log.py).
+//!
+//! The ring is allocated on the first record, so sources need no changes.
+//! Each source file of a binary has its own copy of this header, so the
+//! first record of each file looks for a ring in user2 before allocating
+//! one, and the files of a binary share a ring.  The ring records the time
+//! the core was loaded, so that a ring left by an earlier application on
+//! the core is not taken for one of this application.
+
+#ifndef __TOKEN_LOG_H__
+#define __TOKEN_LOG_H__
+
+#include "spin1_api.h"
+#include <sark.h>
+#include "common-typedefs.h"
+#include <debug.h>
+
+//! the number of words of records the ring holds
+#ifndef TOKEN_LOG_WORDS
+#define TOKEN_LOG_WORDS 256
+#endif
+
+#if TOKEN_LOG_WORDS < 32
+#error "TOKEN_LOG_WORDS must be at least 32"
+#endif
+
+//! the first word of the ring, so the host can tell it is one
+#define TOKEN_LOG_MAGIC 0x544F4B4E
+
+//! where the number of arguments is in the header word of a record
+#define TOKEN_LOG_N_ARGS_SHIFT 24
+
+//! the ring, as laid out in SDRAM
+typedef struct token_log_t {
+    uint32_t magic;
+    //! the number of words of records the ring holds
+    uint32_t n_words;
+    //! the offset of the oldest record
+    uint32_t first;
+    //! the offset the next record is written at
+    uint32_t next;
+    //! the words holding records or unused before the end of the ring
+    uint32_t used;
+    //! the number of records overwritten by newer ones
+    uint32_t n_dropped;
+    //! the time the core was loaded, from its VCPU block
+    uint32_t load_time;
+    uint32_t data[];
+} token_log_t;
+
+//! the ring of this core, once allocated
+static token_log_t *token_log = NULL;
+
+//! whether the ring could not be allocated, so records are thrown away
+static bool token_log_failed = false;
+
+//! \brief The bits of a float argument of a record
+static inline uint32_t token_log_float(float value) {
+    union {
+        float as_float;
+        uint32_t as_bits;
+    } bits;
+    bits.as_float = value;
+    return bits.as_bits;
+}
+
+//! \brief The bits of an accum argument of a record; sources using %k
+//!     include stdfix-full-iso.h already
+#define token_log_accum(value) ((uint32_t) bitsk(value))
+
+//! \brief Find the ring of this core, made by another source file of the
+//!     binary, or allocate it and tell the host where it is; call with
+//!     interrupts disabled, so that only one ring is made
+//! \return whether there is a ring
+static inline bool token_log_allocate(void) {
+    vcpu_t *vcpu = &sv_vcpu[spin1_get_core_id()];
+    token_log_t *ring = (token_log_t *) vcpu->user2;
+    if (ring != NULL && ring->magic == TOKEN_LOG_MAGIC &&
+            ring->load_time == vcpu->time) {
+        token_log = ring;
+        return true;
+    }
+
+    ring = sark_xalloc(
+        sv->sdram_heap, sizeof(token_log_t) + TOKEN_LOG_WORDS * 4, 0,
+        ALLOC_LOCK);
+    if (ring == NULL) {
+        token_log_failed = true;
+        return false;
+    }
+    ring->magic = TOKEN_LOG_MAGIC;
+    ring->n_words = TOKEN_LOG_WORDS;
+    ring->first = 0;
+    ring->next = 0;
+    ring->used = 0;
+    ring->n_dropped = 0;
+    ring->load_time = vcpu->time;
+    vcpu->user2 = (uint) ring;
+    token_log = ring;
+    return true;
+}
+
+//! \brief Make way for a new record by forgetting the oldest
+static inline void token_log_drop_oldest(void) {
+    uint32_t header = token_log->data[token_log->first];
+    uint32_t n_words;
+    if (header == 0) {
+
+        // the rest of the ring is unused
+        n_words = token_log->n_words - token_log->first;
+    } else {
+        n_words = 1 + (header >> TOKEN_LOG_N_ARGS_SHIFT);
+        token_log->n_dropped += 1;
+    }
+    token_log->first += n_words;
+    token_log->used -= n_words;
+    if (token_log->first >= token_log->n_words) {
+        token_log->first = 0;
+    }
+}
+
+//! \brief Write a record to the ring
+//! \param[in] token: the number of the message in the dictionary
+//! \param[in] n_args: the number of arguments of the message
+//! \param[in] args: the arguments of the message, as words
+static inline void token_log_write(
+        uint32_t token, uint32_t n_args, const uint32_t *args) {
+    // records may be written from callbacks of any priority, and the ring
+    // must be made by only one of them
+    uint cpsr = spin1_int_disable();
+    if (token_log == NULL && (token_log_failed || !token_log_allocate())) {
+        spin1_mode_restore(cpsr);
+        return;
+    }
+    uint32_t n_words = 1 + n_args;
+    if (token_log->next + n_words > token_log->n_words) {
+        uint32_t unused = token_log->n_words - token_log->next;
+        while (token_log->n_words - token_log->used < unused) {
+            token_log_drop_oldest();
+        }
+        if (unused > 0) {
+            token_log->data[token_log->next] = 0;
+            token_log->used += unused;
+        }
+        token_log->next = 0;
+    }
+    while (token_log->n_words - token_log->used < n_words) {
+        token_log_drop_oldest();
+    }
+
+    uint32_t *record = &token_log->data[token_log->next];
+    record[0] = (n_args << TOKEN_LOG_N_ARGS_SHIFT) | token;
+    for (uint32_t i = 0; i < n_args; i++) {
+        record[1 + i] = args[i];
+    }
+    token_log->next += n_words;
+    token_log->used += n_words;
+    spin1_mode_restore(cpsr);
+}
+
+//! \brief Record a message of a log level, if that level is logged; the
+//!     calls are written by the converter of token_log.py, which always
+//!     passes at least one argument word
+#define token_log_record(level, token, n_args, ...) \
+    do { \
+        if ((level) <= LOG_LEVEL) { \
+            const uint32_t _token_log_args[] = {__VA_ARGS__}; \
+            token_log_write((token), (n_args), _token_log_args); \
+        } \
+    } while (0)
+
+#endif  // __TOKEN_LOG_H__
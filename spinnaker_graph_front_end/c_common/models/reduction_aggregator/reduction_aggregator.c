@@ -0,0 +1,346 @@
+
+//! imports
+#include "spin1_api.h"
+#include "common-typedefs.h"
+#include <data_specification.h>
+#include <simulation.h>
+#include <debug.h>
+#include <recording.h>
+#include <reduction.h>
+
+//! control value, which says how many timer ticks to run for before exiting
+static uint32_t simulation_ticks = 0;
+static uint32_t time = 0;
+
+//! int as a bool to represent if this simulation should run forever
+static uint32_t infinite_run;
+
+//! The recording flags
+static uint32_t recording_flags = 0;
+
+//! human readable definitions of each region in SDRAM
+typedef enum regions_e {
+    SYSTEM_REGION,
+    PARAMETERS,
+    OPERATIONS,
+    CHILDREN,
+    RECORDED_DATA
+} regions_e;
+
+//! values for the priority for each callback; the packet callback is
+//! queued, as it sends packets and records results, which needs the
+//! interrupts of the transmit queue and must not break into the recording
+//! of the timer callback
+typedef enum callback_priorities{
+    MC_PACKET = 1, SDP = 2, TIMER = 3
+} callback_priorities;
+
+//! the parameters of this aggregator
+typedef struct parameters_t {
+    //! whether this aggregator sends to a parent, or is the root
+    uint32_t has_parent;
+    //! the key of reduction 0 to the parent
+    uint32_t key;
+    uint32_t n_reductions;
+    uint32_t n_children;
+    //! whether the root sends the results back, and the key and mask they
+    //! are sent with
+    uint32_t has_results;
+    uint32_t result_key;
+    uint32_t result_mask;
+    //! the index + 1 of the reduction saying whether every core is done,
+    //! or 0 if the tree does not end the run
+    uint32_t completion_reduction;
+} parameters_t;
+
+//! the keys a child sends its values with
+typedef struct child_keys_t {
+    uint32_t key;
+    uint32_t mask;
+} child_keys_t;
+
+//! the state of one reduction in this aggregator
+typedef struct reduction_state_t {
+    uint32_t value;
+    uint32_t n_contributed;
+    uint32_t round;
+} reduction_state_t;
+
+//! what the root records for each round of a reduction
+typedef struct reduction_record_t {
+    uint32_t round;
+    uint32_t reduction;
+    uint32_t value;
+    uint32_t n_contributed;
+} reduction_record_t;
+
+static parameters_t parameters;
+static uint32_t *operations;
+static child_keys_t *children;
+static reduction_state_t *states;
+
+//! whether each child has contributed to the current round of each
+//! reduction, n_children per reduction
+static uint8_t *contributed;
+
+//! \brief End the run, as every contributor is done
+static void complete(void) {
+    log_info("Every contributor is done after %d ticks", time);
+    if (recording_flags > 0) {
+        recording_finalise();
+    }
+    spin1_callback_off(TIMER_TICK);
+    simulation_exit();
+}
+
+//! \brief Whether a reduction says whether every contributor is done
+static inline bool is_completion_reduction(uint32_t reduction) {
+    return parameters.completion_reduction != 0 &&
+        reduction == parameters.completion_reduction - 1;
+}
+
+//! \brief Whether a result ends the run
+static inline bool is_completion(uint32_t reduction, uint32_t value) {
+    return is_completion_reduction(reduction) && value != 0;
+}
+
+//! \brief Pass on the value of the current round of a reduction and start
+//!     the next round
+static void complete_round(uint32_t reduction) {
+    reduction_state_t *state = &states[reduction];
+    uint32_t value = state->value;
+    uint32_t n_contributed = state->n_contributed;
+
+    // a round missing a child cannot say that every contributor below this
+    // aggregator is done, so it says they are not; otherwise the parent
+    // could not tell a lost "not done" from a child that had nothing to add
+    if (n_contributed < parameters.n_children &&
+            is_completion_reduction(reduction)) {
+        value = 0;
+    }
+    if (parameters.has_parent) {
+        while (!spin1_send_mc_packet(
+                parameters.key + reduction, value, WITH_PAYLOAD)) {
+            spin1_delay_us(1);
+        }
+    } else {
+        reduction_record_t record = {
+            state->round, reduction, value, n_contributed};
+        recording_record(0, &record, sizeof(record));
+        if (parameters.has_results) {
+            while (!spin1_send_mc_packet(
+                    parameters.result_key + reduction, value,
+                    WITH_PAYLOAD)) {
+                spin1_delay_us(1);
+            }
+        }
+    }
+
+    if (state->n_contributed < parameters.n_children) {
+        log_debug("reduction %d round %d had %d of %d children", reduction,
+                  state->round, state->n_contributed, parameters.n_children);
+    }
+    state->n_contributed = 0;
+    state->round += 1;
+    uint8_t *flags = &contributed[reduction * parameters.n_children];
+    for (uint32_t i = 0; i < parameters.n_children; i++) {
+        flags[i] = 0;
+    }
+
+    // only a round with every child in it can say every contributor is
+    // done, and partial rounds below were sent on as not done
+    if (!parameters.has_parent && is_completion(reduction, value)) {
+        complete();
+    }
+}
+
+//! \brief Combine a value from a child into the current round, or end the
+//!     run when the root says every contributor is done
+//! \param[in] key: the key of the child, + the index of the reduction
+//! \param[in] payload: the value of the child
+void receive_data(uint key, uint payload) {
+
+    // the root tells the other aggregators when every contributor is done
+    if (parameters.has_parent && parameters.has_results &&
+            (key & parameters.result_mask) == parameters.result_key) {
+        if (is_completion(key & ~parameters.result_mask, payload)) {
+            complete();
+        }
+        return;
+    }
+
+    for (uint32_t child = 0; child < parameters.n_children; child++) {
+        if ((key & children[child].mask) != children[child].key) {
+            continue;
+        }
+        uint32_t reduction = key & ~children[child].mask;
+        if (reduction >= parameters.n_reductions) {
+            return;
+        }
+        reduction_state_t *state = &states[reduction];
+        uint8_t *flags = &contributed[reduction * parameters.n_children];
+
+        // a child already in this round has moved on, so a value has been
+        // lost; pass on what there is rather than mixing the rounds
+        if (flags[child]) {
+            complete_round(reduction);
+        }
+        if (state->n_contributed == 0) {
+            state->value = payload;
+        } else {
+            state->value = reduction_combine(
+                operations[reduction], state->value, payload);
+        }
+        flags[child] = 1;
+        state->n_contributed += 1;
+        if (state->n_contributed == parameters.n_children) {
+            complete_round(reduction);
+        }
+        return;
+    }
+    log_debug("received unexpected key 0x%08x", key);
+}
+
+/****f* reduction_aggregator.c/update
+ *
+ * SUMMARY
+ *  Keeps time so that the aggregator pauses and resumes with the rest of
+ *  the application; the values are combined as they arrive
+ *
+ * SYNOPSIS
+ *  void update (uint ticks, uint b)
+ *
+ * SOURCE
+ */
+void update(uint ticks, uint b) {
+    use(b);
+    use(ticks);
+
+    time++;
+
+    // check that the run time hasn't already elapsed and thus needs to be
+    // killed
+    if ((infinite_run != TRUE) && (time >= simulation_ticks)) {
+
+        // Finalise any recordings that are in progress, writing back the final
+        // amounts of samples recorded to SDRAM
+        if (recording_flags > 0) {
+            recording_finalise();
+        }
+
+        // falls into the pause resume mode of operating
+        simulation_handle_pause_resume(NULL);
+        time -= 1;
+        return;
+    }
+
+    if (recording_flags > 0) {
+        recording_do_timestep_update(time);
+    }
+}
+
+static bool initialize(uint32_t *timer_period) {
+    log_info("Initialise: started\n");
+
+    // Get the address this core's DTCM data starts at from SRAM
+    address_t address = data_specification_get_data_address();
+
+    // Read the header
+    if (!data_specification_read_header(address)) {
+        log_error("failed to read the data spec header");
+        return false;
+    }
+
+    // Get the timing details and set up the simulation interface
+    if (!simulation_initialise(
+            data_specification_get_region(SYSTEM_REGION, address),
+            APPLICATION_NAME_HASH, timer_period, &simulation_ticks,
+            &infinite_run, SDP, 0)) {
+        return false;
+    }
+
+    spin1_memcpy(
+        &parameters, data_specification_get_region(PARAMETERS, address),
+        sizeof(parameters));
+    log_info("%d reductions from %d children", parameters.n_reductions,
+             parameters.n_children);
+
+    uint32_t operations_size = parameters.n_reductions * sizeof(uint32_t);
+    uint32_t children_size = parameters.n_children * sizeof(child_keys_t);
+    operations = spin1_malloc(operations_size);
+    children = spin1_malloc(children_size);
+    states = spin1_malloc(parameters.n_reductions * sizeof(reduction_state_t));
+    contributed = spin1_malloc(
+        parameters.n_reductions * parameters.n_children);
+    if (operations == NULL || children == NULL || states == NULL ||
+            contributed == NULL) {
+        log_error("Could not allocate the reductions");
+        return false;
+    }
+    spin1_memcpy(
+        operations, data_specification_get_region(OPERATIONS, address),
+        operations_size);
+    spin1_memcpy(
+        children, data_specification_get_region(CHILDREN, address),
+        children_size);
+    for (uint32_t i = 0; i < parameters.n_reductions; i++) {
+        states[i].value = 0;
+        states[i].n_contributed = 0;
+        states[i].round = 0;
+    }
+    for (uint32_t i = 0; i < parameters.n_reductions * parameters.n_children;
+            i++) {
+        contributed[i] = 0;
+    }
+
+    // only the root records
+    if (!parameters.has_parent) {
+        address_t recording_region = data_specification_get_region(
+            RECORDED_DATA, address);
+        if (!recording_initialize(recording_region, &recording_flags)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/****f* reduction_aggregator.c/c_main
+ *
+ * SUMMARY
+ *  This function is called at application start-up.
+ *  It is used to register event callbacks and begin the simulation.
+ *
+ * SYNOPSIS
+ *  int c_main()
+ *
+ * SOURCE
+ */
+void c_main() {
+    log_info("starting reduction aggregator\n");
+
+    // Load DTCM data
+    uint32_t timer_period;
+
+    // initialise the model
+    if (!initialize(&timer_period)) {
+        log_error("Error in initialisation - exiting!");
+        rt_error(RTE_SWERR);
+    }
+
+    // set timer tick value to configured value
+    log_info("setting timer to execute every %d microseconds", timer_period);
+    spin1_set_timer_tick(timer_period);
+
+    // register callbacks
+    spin1_callback_on(MCPL_PACKET_RECEIVED, receive_data, MC_PACKET);
+    spin1_callback_on(TIMER_TICK, update, TIMER);
+
+    // start execution
+    log_info("Starting\n");
+
+    // Start the time at "-1" so that the first tick will be 0
+    time = UINT32_MAX;
+
+    simulation_run();
+}
@@ -0,0 +1,333 @@
+//! \file
+//! \brief Streams values from the host into the graph.  The host sends
+//!     frames of up to MAX_VALUES_PER_FRAME values through a reverse IP
+//!     tag; this core buffers them and sends each value as a multicast
+//!     packet, at most max_packets_per_tick a tick, with the key of its
+//!     channel.  The host may only have as many frames in flight as there
+//!     are slots in the buffer, and is told through an IP tag how far the
+//!     buffer has been drained (see utilities/input_stream.py, which
+//!     defines the same formats).
+
+//! imports
+#include "spin1_api.h"
+#include "common-typedefs.h"
+#include <data_specification.h>
+#include <simulation.h>
+#include <debug.h>
+
+//! control value, which says how many timer ticks to run for before exiting
+static uint32_t simulation_ticks = 0;
+static uint32_t time = 0;
+
+//! int as a bool to represent if this simulation should run forever
+static uint32_t infinite_run;
+
+//! human readable definitions of each region in SDRAM
+typedef enum regions_e {
+    SYSTEM_REGION,
+    PARAMETERS,
+    COUNTERS
+} regions_e;
+
+//! values for the priority for each callback; the frames and the timer are
+//! both queued callbacks, so neither interrupts the other
+typedef enum callback_priorities{
+    MC_PACKET = -1, SDP = 1, TIMER = 2, DMA = 3
+} callback_priorities;
+
+//! the commands of the messages between the host and this core
+typedef enum stream_commands {
+    FRAME_DATA = 1, FRAME_CREDIT_REQUEST = 2, FRAME_CREDIT = 3
+} stream_commands;
+
+//! the most values in a frame
+#define MAX_VALUES_PER_FRAME 64
+
+//! the SDP port the frames arrive on, as given to the reverse IP tag
+#define STREAM_SDP_PORT 2
+
+//! the size of the SDP header before the frame
+#define SDP_HEADER_SIZE 8
+
+//! the parameters of this core
+typedef struct parameters_t {
+    uint32_t has_key;
+    //! the key of channel 0
+    uint32_t key;
+    uint32_t n_channels;
+    //! the number of frames buffered, which is the most the host can have
+    //! in flight
+    uint32_t n_slots;
+    uint32_t max_packets_per_tick;
+    //! the number of frames drained after which the host is told
+    uint32_t credit_batch;
+    //! the IP tag the host is told through
+    uint32_t reply_tag;
+} parameters_t;
+
+//! a frame of values, as sent by the host: the value i is for channel
+//! first_channel + i * stride
+typedef struct frame_t {
+    uint16_t command;
+    uint16_t sequence;
+    uint16_t first_channel;
+    uint8_t stride;
+    uint8_t n_values;
+    uint32_t values[MAX_VALUES_PER_FRAME];
+} frame_t;
+
+//! the size of the fields of a frame before its values
+#define FRAME_HEADER_SIZE 8
+
+//! the counters of the stream, sent to the host with the credit and
+//! written to the counters region when the run pauses
+typedef struct counters_t {
+    uint32_t frames_received;
+    //! frames that never arrived, from the gaps in the sequence numbers
+    uint32_t frames_missed;
+    //! frames that arrived when the buffer was full, or out of order
+    uint32_t frames_dropped;
+    uint32_t packets_sent;
+    //! ticks which ended with values still to send because of the rate
+    uint32_t ticks_rate_limited;
+} counters_t;
+
+//! the credit sent to the host
+typedef struct credit_t {
+    uint16_t command;
+    //! the sequence number of the first frame not yet drained
+    uint16_t drained_sequence;
+    counters_t counters;
+} credit_t;
+
+static parameters_t parameters;
+static counters_t counters;
+static address_t counters_region;
+
+//! the ring buffer of frames, the value of the oldest frame to send next,
+//! and the sequence number of the next frame expected from the host
+static frame_t *slots;
+static uint32_t first_slot = 0;
+static uint32_t n_buffered = 0;
+static uint32_t next_value = 0;
+static uint16_t next_sequence = 0;
+
+//! the frames drained since the host was last told, and whether it asked
+static uint32_t n_drained_since_credit = 0;
+static bool credit_requested = false;
+
+static sdp_msg_t credit_message;
+
+//! \brief Tell the host how far the buffer has been drained
+static void send_credit(void) {
+    credit_t *credit = (credit_t *) &credit_message.cmd_rc;
+    credit->command = FRAME_CREDIT;
+    credit->drained_sequence = (uint16_t) (next_sequence - n_buffered);
+    credit->counters = counters;
+    credit_message.length = SDP_HEADER_SIZE + sizeof(credit_t);
+    spin1_send_sdp_msg(&credit_message, 1);
+    n_drained_since_credit = 0;
+    credit_requested = false;
+}
+
+//! \brief Buffer a frame from the host, or note a request for credit
+//! \param[in] mailbox: the SDP message
+//! \param[in] port: the SDP port it arrived on
+void receive_frame(uint mailbox, uint port) {
+    use(port);
+    sdp_msg_t *msg = (sdp_msg_t *) mailbox;
+    frame_t *frame = (frame_t *) &msg->cmd_rc;
+    uint32_t length = msg->length - SDP_HEADER_SIZE;
+
+    if (frame->command == FRAME_CREDIT_REQUEST) {
+        credit_requested = true;
+    } else if (frame->command == FRAME_DATA && length >= FRAME_HEADER_SIZE &&
+            frame->n_values <= MAX_VALUES_PER_FRAME &&
+            length >= FRAME_HEADER_SIZE + frame->n_values * sizeof(uint32_t)) {
+
+        // a frame behind the expected one is a duplicate, and a frame
+        // ahead of it means those between were lost
+        uint16_t ahead = frame->sequence - next_sequence;
+        if (ahead >= 0x8000) {
+            counters.frames_dropped += 1;
+        } else {
+            counters.frames_missed += ahead;
+            next_sequence = frame->sequence + 1;
+            if (n_buffered == parameters.n_slots) {
+                counters.frames_dropped += 1;
+                n_drained_since_credit += 1;
+            } else {
+                uint32_t slot = first_slot + n_buffered;
+                if (slot >= parameters.n_slots) {
+                    slot -= parameters.n_slots;
+                }
+                spin1_memcpy(&slots[slot], frame,
+                             FRAME_HEADER_SIZE +
+                             frame->n_values * sizeof(uint32_t));
+                n_buffered += 1;
+                counters.frames_received += 1;
+            }
+            n_drained_since_credit += ahead;
+        }
+    }
+    spin1_msg_free(msg);
+}
+
+//! \brief Send the buffered values, up to the most allowed in a tick
+static void drain(void) {
+    uint32_t n_sent = 0;
+    while (n_buffered > 0) {
+        frame_t *frame = &slots[first_slot];
+        if (n_sent == parameters.max_packets_per_tick) {
+            counters.ticks_rate_limited += 1;
+            break;
+        }
+        if (next_value < frame->n_values) {
+            uint32_t channel =
+                frame->first_channel + next_value * frame->stride;
+            if (parameters.has_key && channel < parameters.n_channels) {
+                if (!spin1_send_mc_packet(parameters.key + channel,
+                                          frame->values[next_value],
+                                          WITH_PAYLOAD)) {
+
+                    // the router is busy, so carry on next tick
+                    break;
+                }
+                counters.packets_sent += 1;
+            }
+            next_value += 1;
+            n_sent += 1;
+            continue;
+        }
+
+        // the frame is done, so its slot is free for the host again
+        next_value = 0;
+        first_slot = (first_slot + 1 == parameters.n_slots) ?
+            0 : first_slot + 1;
+        n_buffered -= 1;
+        n_drained_since_credit += 1;
+    }
+}
+
+/****f* stream_injector.c/update
+ *
+ * SUMMARY
+ *  Sends the values buffered from the host, and tells the host when
+ *  enough of the buffer has been freed
+ *
+ * SYNOPSIS
+ *  void update (uint ticks, uint b)
+ *
+ * SOURCE
+ */
+void update(uint ticks, uint b) {
+    use(b);
+    use(ticks);
+
+    time++;
+
+    // check that the run time hasn't already elapsed and thus needs to be
+    // killed
+    if ((infinite_run != TRUE) && (time >= simulation_ticks)) {
+        log_info("Simulation complete.\n");
+        log_info("%u frames received, %u missed, %u dropped, %u packets",
+                 counters.frames_received, counters.frames_missed,
+                 counters.frames_dropped, counters.packets_sent);
+        spin1_memcpy(counters_region, &counters, sizeof(counters));
+
+        // falls into the pause resume mode of operating
+        simulation_handle_pause_resume(NULL);
+        return;
+    }
+
+    drain();
+    if (credit_requested ||
+            n_drained_since_credit >= parameters.credit_batch) {
+        send_credit();
+    }
+}
+
+static bool initialize(uint32_t *timer_period) {
+    log_info("Initialise: started\n");
+
+    // Get the address this core's DTCM data starts at from SRAM
+    address_t address = data_specification_get_data_address();
+
+    // Read the header
+    if (!data_specification_read_header(address)) {
+        log_error("failed to read the data spec header");
+        return false;
+    }
+
+    // Get the timing details and set up the simulation interface
+    if (!simulation_initialise(
+            data_specification_get_region(SYSTEM_REGION, address),
+            APPLICATION_NAME_HASH, timer_period, &simulation_ticks,
+            &infinite_run, SDP, DMA)) {
+        return false;
+    }
+
+    spin1_memcpy(
+        &parameters, data_specification_get_region(PARAMETERS, address),
+        sizeof(parameters));
+    log_info("%d channels, %d slots, %d packets a tick",
+             parameters.n_channels, parameters.n_slots,
+             parameters.max_packets_per_tick);
+
+    slots = spin1_malloc(parameters.n_slots * sizeof(frame_t));
+    if (slots == NULL) {
+        log_error("Could not allocate the frame buffer");
+        return false;
+    }
+    counters_region = data_specification_get_region(COUNTERS, address);
+
+    // the credits go to the host through the IP tag
+    credit_message.flags = 0x07;
+    credit_message.tag = parameters.reply_tag;
+    credit_message.dest_port = PORT_ETH;
+    credit_message.dest_addr = sv->eth_addr;
+    credit_message.srce_port = (1 << PORT_SHIFT) | spin1_get_core_id();
+    credit_message.srce_addr = spin1_get_chip_id();
+
+    simulation_sdp_callback_on(STREAM_SDP_PORT, receive_frame);
+    return true;
+}
+
+/****f* stream_injector.c/c_main
+ *
+ * SUMMARY
+ *  This function is called at application start-up.
+ *  It is used to register event callbacks and begin the simulation.
+ *
+ * SYNOPSIS
+ *  int c_main()
+ *
+ * SOURCE
+ */
+void c_main() {
+    log_info("starting stream injector\n");
+
+    // Load DTCM data
+    uint32_t timer_period;
+
+    // initialise the model
+    if (!initialize(&timer_period)) {
+        log_error("Error in initialisation - exiting!");
+        rt_error(RTE_SWERR);
+    }
+
+    // set timer tick value to configured value
+    log_info("setting timer to execute every %d microseconds", timer_period);
+    spin1_set_timer_tick(timer_period);
+
+    // register callbacks
+    spin1_callback_on(TIMER_TICK, update, TIMER);
+
+    // start execution
+    log_info("Starting\n");
+
+    // Start the time at "-1" so that the first tick will be 0
+    time = UINT32_MAX;
+
+    simulation_run();
+}
@@ -0,0 +1,254 @@
+//! \file
+//! \brief Host test of fixed_point_kernels.h: every kernel is checked bit
+//!     for bit against a reference computed with 128 bit integers, on
+//!     random values and on the edges of the ranges.  Run with "bench" to
+//!     time the kernels too.
+
+#include <fixed_point_kernels.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+typedef __int128 int128_t;
+
+//! the number of random cases of each kernel
+#define N_CASES 100000
+
+//! the length of the vectors, and the size of the stencil grid
+#define VECTOR_LENGTH 64
+#define GRID_WIDTH 32
+#define GRID_HEIGHT 16
+
+static uint32_t n_failures = 0;
+static uint32_t n_checks = 0;
+
+//! values on the edges of the ranges, tried in every combination
+static const int32_t EDGES[] = {
+    0, 1, -1, 2, -2, S1615_ONE, -S1615_ONE, S1615_ONE / 2, -S1615_ONE / 2,
+    S1615_ONE - 1, S1615_ONE + 1, 181 << 15, -(181 << 15), 0x7FFF, -0x7FFF,
+    S1615_MAX, S1615_MIN, S1615_MAX - 1, S1615_MIN + 1};
+#define N_EDGES (sizeof(EDGES) / sizeof(EDGES[0]))
+
+//! \brief A xorshift random number
+static uint32_t random_u32(void) {
+    static uint32_t state = 0x12345678;
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+//! \brief A random value, mostly small, sometimes anywhere in the range
+static int32_t random_s1615(void) {
+    uint32_t value = random_u32();
+    switch (random_u32() & 3) {
+    case 0:
+        return (int32_t) value;
+    case 1:
+        return (int32_t) value >> 12;
+    default:
+        return (int32_t) value >> 8;
+    }
+}
+
+static void check(const char *kernel, int64_t got, int64_t expected,
+        int64_t a, int64_t b) {
+    n_checks++;
+    if (got != expected) {
+        if (n_failures < 20) {
+            printf("%s(%lld, %lld): got %lld, expected %lld\n", kernel,
+                   (long long) a, (long long) b, (long long) got,
+                   (long long) expected);
+        }
+        n_failures++;
+    }
+}
+
+//! \brief Round an exact sum of products to the nearest s16.15, halves up,
+//!     and saturate it
+static int32_t ref_round(int128_t products) {
+    int128_t half = 1 << (S1615_SHIFT - 1);
+    int128_t scaled = products + half;
+
+    // floor division, whatever the sign
+    int128_t result = scaled / S1615_ONE;
+    if (scaled % S1615_ONE != 0 && scaled < 0) {
+        result -= 1;
+    }
+    if (result > INT32_MAX) {
+        return INT32_MAX;
+    }
+    if (result < INT32_MIN) {
+        return INT32_MIN;
+    }
+    return (int32_t) result;
+}
+
+static int32_t ref_saturate(int128_t value) {
+    return (value > INT32_MAX) ? INT32_MAX :
+        (value < INT32_MIN) ? INT32_MIN : (int32_t) value;
+}
+
+//! \brief Round an exact sum of products of fractions to the nearest u0.32,
+//!     halves up, saturating sums of 1.0 or more
+static uint32_t ref_round_u032(unsigned __int128 products) {
+    unsigned __int128 one = (unsigned __int128) 1 << 64;
+    if (products >= one) {
+        return UINT32_MAX;
+    }
+    unsigned __int128 half = (unsigned __int128) 1 << 31;
+    unsigned __int128 result = (products + half) >> 32;
+    return (result > UINT32_MAX) ? UINT32_MAX : (uint32_t) result;
+}
+
+static void test_scalars(int32_t a, int32_t b) {
+    check("s1615_add_sat", s1615_add_sat(a, b),
+          ref_saturate((int128_t) a + b), a, b);
+    check("s1615_sub_sat", s1615_sub_sat(a, b),
+          ref_saturate((int128_t) a - b), a, b);
+    check("s1615_mul", s1615_mul(a, b),
+          ref_round((int128_t) a * b), a, b);
+
+    uint32_t ua = (uint32_t) a, ub = (uint32_t) b;
+    unsigned __int128 product = (unsigned __int128) ua * ub;
+    check("u032_mul", u032_mul(ua, ub),
+          (int64_t) ((product + ((unsigned __int128) 1 << 31)) >> 32),
+          ua, ub);
+    int128_t scaled = (int128_t) a * ub + ((int128_t) 1 << 31);
+    int128_t expected = scaled / ((int128_t) 1 << 32);
+    if (scaled < 0 && scaled % ((int128_t) 1 << 32) != 0) {
+        expected -= 1;
+    }
+    check("u032_scale", u032_scale(a, ub), (int64_t) expected, a, ub);
+
+    // a sum of two products, which may reach 1.0
+    uint64_t accumulator = u032_mac(u032_mac(0, ua, ub), ub, ua);
+    check("u032_mac", u032_from_accumulator(accumulator),
+          ref_round_u032(2 * product), ua, ub);
+}
+
+static void test_vectors(void) {
+    int32_t a[VECTOR_LENGTH], b[VECTOR_LENGTH], y[VECTOR_LENGTH];
+    for (uint32_t i = 0; i < VECTOR_LENGTH; i++) {
+        a[i] = random_s1615() >> 4;
+        b[i] = random_s1615() >> 4;
+        y[i] = random_s1615();
+    }
+
+    int128_t sum = 0;
+    for (uint32_t i = 0; i < VECTOR_LENGTH; i++) {
+        sum += (int128_t) a[i] * b[i];
+    }
+    check("s1615_dot", s1615_dot(a, b, VECTOR_LENGTH), ref_round(sum),
+          a[0], b[0]);
+
+    int32_t scale = random_s1615();
+    int32_t expected[VECTOR_LENGTH];
+    for (uint32_t i = 0; i < VECTOR_LENGTH; i++) {
+        expected[i] = ref_round(
+            (int128_t) y[i] * S1615_ONE + (int128_t) scale * a[i]);
+    }
+    s1615_axpy(y, scale, a, VECTOR_LENGTH);
+    for (uint32_t i = 0; i < VECTOR_LENGTH; i++) {
+        check("s1615_axpy", y[i], expected[i], scale, a[i]);
+    }
+}
+
+//! \brief Sums of n_terms products of fractions, each below 1 / 2^shift
+static void test_u032_mac(uint32_t n_terms, uint32_t shift) {
+    uint64_t accumulator = 0;
+    unsigned __int128 sum = 0;
+    uint32_t a = 0, b = 0;
+    for (uint32_t i = 0; i < n_terms; i++) {
+        a = random_u32() >> shift;
+        b = random_u32();
+        accumulator = u032_mac(accumulator, a, b);
+        sum += (unsigned __int128) a * b;
+    }
+    check("u032_mac", u032_from_accumulator(accumulator),
+          ref_round_u032(sum), a, b);
+}
+
+static void test_stencil(void) {
+    static int32_t in[GRID_WIDTH * GRID_HEIGHT];
+    static int32_t out[GRID_WIDTH * GRID_HEIGHT];
+    for (uint32_t i = 0; i < GRID_WIDTH * GRID_HEIGHT; i++) {
+        in[i] = random_s1615();
+    }
+    int32_t centre = random_s1615() >> 8;
+    int32_t neighbour = random_s1615() >> 8;
+    s1615_stencil_sweep(in, out, GRID_WIDTH, GRID_HEIGHT, centre, neighbour);
+
+    for (uint32_t y = 0; y < GRID_HEIGHT; y++) {
+        for (uint32_t x = 0; x < GRID_WIDTH; x++) {
+            uint32_t i = y * GRID_WIDTH + x;
+            int32_t expected = in[i];
+            if (x > 0 && y > 0 && x < GRID_WIDTH - 1 &&
+                    y < GRID_HEIGHT - 1) {
+                expected = ref_round(
+                    (int128_t) centre * in[i] +
+                    (int128_t) neighbour * ((int128_t) in[i - 1] +
+                        in[i + 1] + in[i - GRID_WIDTH] + in[i + GRID_WIDTH]));
+            }
+            check("s1615_stencil_sweep", out[i], expected, x, y);
+        }
+    }
+}
+
+//! \brief Time the kernels; the result is kept so that the work is done
+static void benchmark(void) {
+    static int32_t a[1024], b[1024], grid[2][64 * 64];
+    for (uint32_t i = 0; i < 1024; i++) {
+        a[i] = random_s1615() >> 8;
+        b[i] = random_s1615() >> 8;
+    }
+    for (uint32_t i = 0; i < 64 * 64; i++) {
+        grid[0][i] = random_s1615() >> 8;
+    }
+    volatile int32_t sink = 0;
+    clock_t start = clock();
+    for (uint32_t i = 0; i < 10000; i++) {
+        sink += s1615_dot(a, b, 1024);
+    }
+    double dot_ns = 1e9 * (clock() - start) / CLOCKS_PER_SEC / 10000 / 1024;
+
+    start = clock();
+    for (uint32_t i = 0; i < 10000; i++) {
+        s1615_axpy(a, S1615_ONE / 3, b, 1024);
+    }
+    double axpy_ns = 1e9 * (clock() - start) / CLOCKS_PER_SEC / 10000 / 1024;
+
+    start = clock();
+    for (uint32_t i = 0; i < 2000; i++) {
+        s1615_stencil_sweep(grid[i & 1], grid[(i + 1) & 1], 64, 64,
+                            S1615_ONE / 2, S1615_ONE / 8);
+    }
+    double stencil_ns =
+        1e9 * (clock() - start) / CLOCKS_PER_SEC / 2000 / (64 * 64);
+    printf("dot %.2f ns/term, axpy %.2f ns/element, "
+           "stencil %.2f ns/cell (%d)\n", dot_ns, axpy_ns, stencil_ns, sink);
+}
+
+int main(int argc, char *argv[]) {
+    for (uint32_t i = 0; i < N_EDGES; i++) {
+        for (uint32_t j = 0; j < N_EDGES; j++) {
+            test_scalars(EDGES[i], EDGES[j]);
+        }
+    }
+    for (uint32_t i = 0; i < N_CASES; i++) {
+        test_scalars(random_s1615(), random_s1615());
+    }
+    for (uint32_t i = 0; i < N_CASES / 100; i++) {
+        test_vectors();
+        test_stencil();
+        test_u032_mac(VECTOR_LENGTH, 6);
+        test_u032_mac(VECTOR_LENGTH, 5);
+        test_u032_mac(VECTOR_LENGTH, 0);
+    }
+    printf("%u of %u checks failed\n", n_failures, n_checks);
+
+    if (argc > 1 && strcmp(argv[1], "bench") == 0) {
+        benchmark();
+    }
+    return (n_failures == 0) ? 0 : 1;
+}
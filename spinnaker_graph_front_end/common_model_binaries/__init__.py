@@ -0,0 +1,3 @@
+""" The binaries of the models provided by the graph front end, built from\
+    c_common/models
+"""
@@ -217,7 +217,7 @@ class ConwayBasicCell(
         return (constants.SYSTEM_BYTES_REQUIREMENT +
                 self.TRANSMISSION_DATA_SIZE + self.STATE_DATA_SIZE +
                 self.NEIGHBOUR_INITIAL_STATES_SIZE +
-                n_machine_time_steps + 4)
+                (n_machine_time_steps * 4) + 4)
 
     def __repr__(self):
         return self.label
@@ -1,8 +1,9 @@
 # pacman imports
 from pacman.model.decorators import overrides
+from pacman.executor.injection_decorator import supports_injection, \
+    inject_items
 from pacman.model.graphs.machine import MachineVertex
-from pacman.model.resources import ResourceContainer, CPUCyclesPerTickResource
-from pacman.model.resources import DTCMResource, SDRAMResource
+from pacman.model.resources import ResourceContainer, SDRAMResource
 from pacman.utilities import utility_calls
 
 # spinn front end common imports
@@ -19,15 +20,49 @@ from spinn_front_end_common.abstract_models.impl \
 from spinn_front_end_common.abstract_models import AbstractHasAssociatedBinary
 from spinn_front_end_common.utilities.utility_objs import ExecutableStartType
 
+# graph front end imports
+from spinnaker_graph_front_end.abstract_models \
+    import AbstractCheckpointable, AbstractHasRecordingSizing, \
+    AbstractHasTickProfile, AbstractSDRAMMailboxProducer, AbstractTracesKeys
+from spinnaker_graph_front_end.utilities import key_trace
+from spinnaker_graph_front_end.utilities import sdram_mailbox_utilities
+from spinnaker_graph_front_end.utilities import tick_profile
+from spinnaker_graph_front_end.utilities.buffer_settings \
+    import get_buffer_settings
+from spinnaker_graph_front_end.utilities.delta_recording \
+    import decode_transitions, expand_transitions
+from spinnaker_graph_front_end.utilities.recording_sizing \
+    import RecordingSizing
+from spinnaker_graph_front_end.utilities.resource_model \
+    import ResourceModel, load_resource_model
+
 # general imports
 from enum import Enum
+import os
 import struct
 
+# Estimates of the resources of a cell until they have been measured with
+# front_end.profile_resources()
+_ESTIMATED_RESOURCES = ResourceModel(
+    dtcm_base=12 * 1024, dtcm_per_element=0, cycles_base=6000,
+    cycles_per_element=0)
+
 
+@supports_injection
 class ConwayBasicCell(
         MachineVertex, MachineDataSpecableVertex, AbstractHasAssociatedBinary,
-        AbstractReceiveBuffersToHost):
+        AbstractReceiveBuffersToHost, AbstractSDRAMMailboxProducer,
+        AbstractHasTickProfile, AbstractCheckpointable, AbstractTracesKeys,
+        AbstractHasRecordingSizing):
     """ Cell which represents a cell within the 2d fabric
+
+    The state and settings of the cell are only read through the\
+    properties label, state, record_changes_only, buffer_settings,\
+    _resource_model and _written_recording_sizing, and only changed by\
+    restore_checkpoint() and by setting _written_recording_sizing.  A\
+    subclass which keeps them elsewhere, such as ConwayFabricCell, may call\
+    MachineVertex.__init__() in place of the __init__() of this class, as\
+    long as it overrides all of those and _count_neighbour_states().
     """
 
     PARTITION_ID = "STATE"
@@ -35,6 +70,14 @@ class ConwayBasicCell(
     TRANSMISSION_DATA_SIZE = 2 * 4  # has key and key
     STATE_DATA_SIZE = 1 * 4  # 1 or 2 based off dead or alive
     NEIGHBOUR_INITIAL_STATES_SIZE = 2 * 4  # alive states, dead states
+    N_NEIGHBOURS = 8
+    # the state; a record of a change is 2 bytes and its padding at most 2
+    RECORDING_BYTES_PER_TICK = [4]
+    RECORDING_MODE_SIZE = 1 * 4  # 1 to record only the changes of the state
+    MAILBOX_SIZE = sdram_mailbox_utilities.get_mailbox_region_size(1)
+    MAILBOX_READS_SIZE = \
+        sdram_mailbox_utilities.get_mailbox_reads_region_size(N_NEIGHBOURS)
+    KEY_TRACE_SIZE = key_trace.get_key_trace_region_size(N_NEIGHBOURS)
 
     # Regions for populations
     DATA_REGIONS = Enum(
@@ -43,25 +86,31 @@ class ConwayBasicCell(
                ('TRANSMISSIONS', 1),
                ('STATE', 2),
                ('NEIGHBOUR_INITIAL_STATES', 3),
-               ('RESULTS', 4)])
-
-    def __init__(self, label, state):
+               ('RESULTS', 4),
+               ('SDRAM_MAILBOX', 5),
+               ('MAILBOX_READS', 6),
+               ('TICK_PROFILE', 7),
+               ('RECORDING_MODE', 8),
+               ('KEY_TRACE', 9)])
+
+    def __init__(self, label, state, record_changes_only=False):
+        """
+        :param label: the label of the cell
+        :param state: True if the cell starts alive
+        :param record_changes_only: True to record the state only when it\
+            changes, which is much less data for a mostly still fabric
+        """
         MachineVertex .__init__(self, label)
 
-        config = globals_variables.get_simulator().config
-        self._buffer_size_before_receive = None
-        if config.getboolean("Buffers", "enable_buffered_recording"):
-            self._buffer_size_before_receive = config.getint(
-                "Buffers", "buffer_size_before_receive")
-        self._time_between_requests = config.getint(
-            "Buffers", "time_between_requests")
-        self._receive_buffer_host = config.get(
-            "Buffers", "receive_buffer_host")
-        self._receive_buffer_port = helpful_functions.read_config_int(
-            config, "Buffers", "receive_buffer_port")
+        # the buffer settings are shared by all the cells
+        self._buffer_settings = get_buffer_settings()
 
         # app specific data items
         self._state = state
+        self._record_changes_only = record_changes_only
+
+        # the sizing of the recording region when it was last written
+        self._written_recording_sizing = None
 
     @overrides(AbstractHasAssociatedBinary.get_binary_file_name)
     def get_binary_file_name(self):
@@ -71,10 +120,16 @@ class ConwayBasicCell(
     def get_binary_start_type(self):
         return ExecutableStartType.USES_SIMULATION_INTERFACE
 
-    @overrides(MachineDataSpecableVertex.generate_machine_data_specification)
+    @inject_items({
+        "n_machine_time_steps": "TotalMachineTimeSteps",
+        "placements": "MemoryPlacements"})
+    @overrides(
+        MachineDataSpecableVertex.generate_machine_data_specification,
+        additional_arguments={"n_machine_time_steps", "placements"})
     def generate_machine_data_specification(
             self, spec, placement, machine_graph, routing_info, iptags,
-            reverse_iptags, machine_time_step, time_scale_factor):
+            reverse_iptags, machine_time_step, time_scale_factor,
+            n_machine_time_steps, placements):
 
         # Setup words + 1 for flags + 1 for recording size
         setup_size = constants.SYSTEM_BYTES_REQUIREMENT + 8
@@ -95,6 +150,19 @@ class ConwayBasicCell(
         spec.reserve_memory_region(
             region=self.DATA_REGIONS.RESULTS.value,
             size=recording_utilities.get_recording_header_size(1))
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.SDRAM_MAILBOX.value,
+            size=self.MAILBOX_SIZE, label="mailbox")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.MAILBOX_READS.value,
+            size=self.MAILBOX_READS_SIZE, label="mailbox_reads")
+        tick_profile.reserve_tick_profile_region(
+            spec, self.DATA_REGIONS.TICK_PROFILE.value)
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.RECORDING_MODE.value,
+            size=self.RECORDING_MODE_SIZE, label="recording_mode")
+        key_trace.reserve_key_trace_region(
+            spec, self.DATA_REGIONS.KEY_TRACE.value, self.N_NEIGHBOURS)
 
         # simulation.c requirements
         spec.switch_write_focus(self.DATA_REGIONS.SYSTEM.value)
@@ -104,10 +172,9 @@ class ConwayBasicCell(
 
         # get recorded buffered regions sorted
         spec.switch_write_focus(self.DATA_REGIONS.RESULTS.value)
-        spec.write_array(recording_utilities.get_recording_header_array(
-            [constants.MAX_SIZE_OF_BUFFERED_REGION_ON_CHIP],
-            self._time_between_requests, self._buffer_size_before_receive,
-            iptags))
+        sizing = self._recording_sizing(n_machine_time_steps)
+        spec.write_array(sizing.get_recording_header_array(iptags))
+        self._written_recording_sizing = sizing
 
         # check got right number of keys and edges going into me
         partitions = \
@@ -118,7 +185,7 @@ class ConwayBasicCell(
 
         # check for duplicates
         edges = list(machine_graph.get_edges_ending_at_vertex(self))
-        if len(set(edges)) != 8:
+        if len(set(edges)) != self.N_NEIGHBOURS:
             output = ""
             for edge in edges:
                 output += edge.pre_vertex.label + " : "
@@ -126,7 +193,7 @@ class ConwayBasicCell(
                 "I've got duplicate edges. This is a error. The edges are "
                 "connected to these vertices \n {}".format(output))
 
-        if len(edges) != 8:
+        if len(edges) != self.N_NEIGHBOURS:
             raise exceptions.ConfigurationException(
                 "I've not got the right number of connections. I have {} "
                 "instead of 9".format(
@@ -138,9 +205,13 @@ class ConwayBasicCell(
                     "I'm connected to myself, this is deemed an error"
                     " please fix.")
 
-        # write key needed to transmit with
-        key = routing_info.get_first_key_from_pre_vertex(
-            self, self.PARTITION_ID)
+        # neighbours on this chip read my state from my mailbox, so a key is
+        # only needed if there are neighbours on other chips
+        key = None
+        if sdram_mailbox_utilities.needs_multicast(
+                self, self.PARTITION_ID, machine_graph, placements):
+            key = routing_info.get_first_key_from_pre_vertex(
+                self, self.PARTITION_ID)
 
         spec.switch_write_focus(
             region=self.DATA_REGIONS.TRANSMISSIONS.value)
@@ -155,7 +226,7 @@ class ConwayBasicCell(
         spec.switch_write_focus(
             region=self.DATA_REGIONS.STATE.value)
 
-        if self._state:
+        if self.state:
             spec.write_value(1)
         else:
             spec.write_value(0)
@@ -163,23 +234,30 @@ class ConwayBasicCell(
         # write neighbours data state
         spec.switch_write_focus(
             region=self.DATA_REGIONS.NEIGHBOUR_INITIAL_STATES.value)
-        alive = 0
-        dead = 0
-        for edge in edges:
-            state = edge.pre_vertex.state
-            if state:
-                alive += 1
-            else:
-                dead += 1
-
+        alive, dead = self._count_neighbour_states(edges)
         spec.write_value(alive)
         spec.write_value(dead)
 
+        # write the mailboxes shared with the neighbours on this chip
+        sdram_mailbox_utilities.write_mailbox_region(
+            spec, self.DATA_REGIONS.SDRAM_MAILBOX.value, 1)
+        sdram_mailbox_utilities.write_mailbox_reads_region(
+            spec, self.DATA_REGIONS.MAILBOX_READS.value, self,
+            self.PARTITION_ID, machine_graph, placements, routing_info)
+
+        spec.switch_write_focus(
+            region=self.DATA_REGIONS.RECORDING_MODE.value)
+        spec.write_value(1 if self.record_changes_only else 0)
+
+        # the keys of the neighbours, to count their packets by
+        key_trace.write_key_trace_region(
+            spec, self.DATA_REGIONS.KEY_TRACE.value, self, machine_graph,
+            routing_info, self.N_NEIGHBOURS)
+
         # End-of-Spec:
         spec.end_specification()
 
-    def get_data(self, buffer_manager, placement):
-        data = list()
+    def _get_raw_data(self, buffer_manager, placement):
 
         # for buffering output info is taken form the buffer manager
         reader, data_missing = buffer_manager.get_data_for_vertex(placement, 0)
@@ -189,8 +267,35 @@ class ConwayBasicCell(
             print "missing_data from ({}, {}, {}); ".format(
                 placement.x, placement.y, placement.p)
 
+        return reader.read_all()
+
+    def get_transitions(self, buffer_manager, placement):
+        """ Get the ticks at which the state changed, when recording only\
+            the changes
+
+        :return: the (tick, alive) of each change, the first being tick 0
+        :rtype: list of (int, bool)
+        """
+        if not self.record_changes_only:
+            raise exceptions.ConfigurationException(
+                "{} records its state every tick".format(self.label))
+        return [
+            (tick, value != 0) for tick, value in decode_transitions(
+                self._get_raw_data(buffer_manager, placement))]
+
+    def get_data(self, buffer_manager, placement):
+
+        # the changes expand into the state of every tick run
+        if self.record_changes_only:
+            return expand_transitions(
+                self.get_transitions(buffer_manager, placement),
+                globals_variables.get_simulator().no_machine_time_steps,
+                self.state)
+
+        data = list()
+
         # get raw data
-        raw_data = reader.read_all()
+        raw_data = self._get_raw_data(buffer_manager, placement)
 
         elements = struct.unpack(
             "<{}I".format(len(raw_data) / 4), str(raw_data))
@@ -209,34 +314,113 @@ class ConwayBasicCell(
         resources = ResourceContainer(
             sdram=SDRAMResource(
                 self._calculate_sdram_requirement()),
-            dtcm=DTCMResource(0),
-            cpu_cycles=CPUCyclesPerTickResource(0))
-        resources.extend(recording_utilities.get_recording_resources(
-            [constants.MAX_SIZE_OF_BUFFERED_REGION_ON_CHIP],
-            self._receive_buffer_host, self._receive_buffer_port))
+            dtcm=self._resource_model.dtcm_resource(),
+            cpu_cycles=self._resource_model.cpu_cycles_resource())
+
+        # the length of the run is only known once the region is written;
+        # until then the region is sized for a run of any length
+        sizing = self._written_recording_sizing
+        if sizing is None:
+            sizing = self._recording_sizing()
+        resources.extend(sizing.get_recording_resources(
+            self.buffer_settings.receive_buffer_host,
+            self.buffer_settings.receive_buffer_port))
         return resources
 
+    @property
+    def _resource_model(self):
+        return load_resource_model(
+            self.get_binary_file_name(), [os.path.dirname(__file__)],
+            _ESTIMATED_RESOURCES)
+
     @property
     def state(self):
         return self._state
 
+    @property
+    def record_changes_only(self):
+        return self._record_changes_only
+
+    @property
+    def buffer_settings(self):
+        return self._buffer_settings
+
+    def _count_neighbour_states(self, edges):
+        """ The numbers of neighbours alive and dead at the start of the run
+
+        :rtype: (int, int)
+        """
+        alive = 0
+        dead = 0
+        for edge in edges:
+            if edge.pre_vertex.state:
+                alive += 1
+            else:
+                dead += 1
+        return alive, dead
+
+    @property
+    @overrides(AbstractHasRecordingSizing.recording_sizing)
+    def recording_sizing(self):
+        return self._written_recording_sizing
+
+    @property
+    @overrides(AbstractSDRAMMailboxProducer.sdram_mailbox_region_id)
+    def sdram_mailbox_region_id(self):
+        return self.DATA_REGIONS.SDRAM_MAILBOX.value
+
+    @property
+    @overrides(AbstractHasTickProfile.tick_profile_region_id)
+    def tick_profile_region_id(self):
+        return self.DATA_REGIONS.TICK_PROFILE.value
+
+    @property
+    @overrides(AbstractTracesKeys.key_trace_region_id)
+    def key_trace_region_id(self):
+        return self.DATA_REGIONS.KEY_TRACE.value
+
+    @property
+    @overrides(AbstractCheckpointable.checkpoint_region_id)
+    def checkpoint_region_id(self):
+        return self.DATA_REGIONS.STATE.value
+
+    @property
+    @overrides(AbstractCheckpointable.checkpoint_size_in_bytes)
+    def checkpoint_size_in_bytes(self):
+        return self.STATE_DATA_SIZE
+
+    @overrides(AbstractCheckpointable.restore_checkpoint)
+    def restore_checkpoint(self, state):
+
+        # the cell carries on from the generation it paused at, which its
+        # neighbours are told of as their initial states
+        self._state = struct.unpack("<I", state)[0] != 0
+
     def _calculate_sdram_requirement(self):
         return (constants.SYSTEM_BYTES_REQUIREMENT +
                 self.TRANSMISSION_DATA_SIZE + self.STATE_DATA_SIZE +
                 self.NEIGHBOUR_INITIAL_STATES_SIZE +
-                constants.MAX_SIZE_OF_BUFFERED_REGION_ON_CHIP)
+                self.MAILBOX_SIZE + self.MAILBOX_READS_SIZE +
+                tick_profile.TICK_PROFILE_REGION_SIZE +
+                self.RECORDING_MODE_SIZE + self.KEY_TRACE_SIZE)
+
+    def _recording_sizing(self, n_machine_time_steps=None):
+        return RecordingSizing(
+            self.RECORDING_BYTES_PER_TICK, n_machine_time_steps,
+            self.buffer_settings.buffer_size_before_receive,
+            self.buffer_settings.time_between_requests)
 
     def __repr__(self):
         return self.label
 
     @overrides(AbstractReceiveBuffersToHost.get_minimum_buffer_sdram_usage)
     def get_minimum_buffer_sdram_usage(self):
-        return 1024
+        return self._recording_sizing().minimum_buffer_sdram_usage
 
     @overrides(AbstractReceiveBuffersToHost.get_n_timesteps_in_buffer_space)
     def get_n_timesteps_in_buffer_space(self, buffer_space, machine_time_step):
-        return recording_utilities.get_n_timesteps_in_buffer_space(
-            buffer_space, [100])
+        return self._recording_sizing().get_n_timesteps_in_buffer_space(
+            buffer_space)
 
     @overrides(AbstractReceiveBuffersToHost.get_recorded_region_ids)
     def get_recorded_region_ids(self):
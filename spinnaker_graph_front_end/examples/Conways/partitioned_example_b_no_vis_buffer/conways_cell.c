@@ -7,16 +7,27 @@
 #include <debug.h>
 #include <circular_buffer.h>
 #include <recording.h>
+#include <sdram_mailbox.h>
+#include <tick_profiler.h>
+#include <delta_recording.h>
+#include <key_trace.h>
 
 /*! multicast routing keys to communicate with neighbours */
 uint my_key;
 
+/*! whether any neighbour is off chip and so needs multicast packets */
+static bool has_key;
+
 /*! buffer used to store spikes */
 static circular_buffer input_buffer;
 static uint32_t current_payload;
 
 //! conways specific data items
 uint32_t my_state = 0;
+
+//! the state region, which my state is written back to when paused so that
+//! it can be checkpointed
+static address_t state_region;
 int alive_states_recieved_this_tick = 0;
 int dead_states_recieved_this_tick = 0;
 
@@ -31,6 +42,10 @@ address_t address = NULL;
 //! The recording flags
 static uint32_t recording_flags = 0;
 
+//! whether my state is recorded only when it changes, and the changes
+static bool record_changes_only = false;
+static delta_recording_t state_changes;
+
 //! int as a bool to represent if this simulation should run forever
 static uint32_t infinite_run;
 
@@ -43,7 +58,12 @@ typedef enum regions_e {
     TRANSMISSIONS,
     STATE,
     NEIGHBOUR_INITIAL_STATES,
-    RECORDED_DATA
+    RECORDED_DATA,
+    SDRAM_MAILBOX,
+    MAILBOX_READS,
+    TICK_PROFILE,
+    RECORDING_MODE,
+    KEY_TRACE
 } regions_e;
 
 //! values for the priority for each callback
@@ -86,9 +106,28 @@ typedef enum initial_state_region_elements {
 void receive_data(uint key, uint payload) {
     //log_info("the key i've received is %d\n", key);
     //log_info("the payload i've received is %d\n", payload);
+
+    // count the packet by the neighbour it came from, filtered or not
+    key_trace_record(key);
+
+    // drop states which are also read from a neighbour's mailbox
+    if (sdram_mailbox_is_filtered_key(key)) {
+        return;
+    }
+
     // If there was space to add spike to incoming spike queue
     if (!circular_buffer_add(input_buffer, payload)) {
         log_info("Could not add state");
+        tick_profiler_record_lost_packets(1);
+    }
+}
+
+//! \brief Record my state, or only its changes if asked to
+void record_state(){
+    if (record_changes_only) {
+        delta_recording_record(&state_changes, time, my_state);
+    } else {
+        recording_record(0, &my_state, 4);
     }
 }
 
@@ -115,6 +154,10 @@ void update(uint ticks, uint b) {
 
         log_info("Simulation complete.\n");
 
+        // keep my state where front_end.checkpoint() can read it
+        state_region[INITIAL_STATE] = my_state;
+        key_trace_write_back();
+
         // falls into the pause resume mode of operating
         simulation_handle_pause_resume(NULL);
 
@@ -122,34 +165,76 @@ void update(uint ticks, uint b) {
         // amounts of samples recorded to SDRAM
         if (recording_flags > 0) {
             log_info("updating recording regions");
+            if (record_changes_only) {
+                delta_recording_flush(&state_changes);
+            }
             recording_finalise();
         }
 
         return;
     }
 
+    tick_profiler_start_tick();
+
     if (time == 0){
         next_state();
         send_state();
-        recording_record(0, &my_state, 4);
+        record_state();
         log_debug("Send my first state!");
+        tick_profiler_end_tick();
     }
     else{
 
-        read_input_buffer();
+        // the rest of the tick happens once the states of the neighbours on
+        // this chip have been read from their mailboxes
+        sdram_mailbox_read_all(time);
+    }
+}
 
-        // find my next state
-        next_state();
+void read_mailboxes(){
+    for (uint32_t i = 0; i < sdram_mailbox_n_reads(); i++) {
 
-        // do a safety check on number of states. Not like we can fix it
-        // if we've missed events
-        do_safety_check();
+        // a neighbour whose mailbox is stale is missing, as a lost packet is
+        uint32_t *data = sdram_mailbox_data(i);
+        if (data == NULL) {
+            continue;
+        }
+        uint32_t state = data[0];
+        if (state == ALIVE) {
+            alive_states_recieved_this_tick += 1;
+        } else {
+            dead_states_recieved_this_tick += 1;
+        }
+    }
+}
 
-        send_state();
+/****f* conways.c/mailboxes_read
+ *
+ * SUMMARY
+ *  Completes a timer tick once the mailboxes have been read
+ *
+ * SYNOPSIS
+ *  void mailboxes_read ()
+ *
+ * SOURCE
+ */
+void mailboxes_read() {
+    read_input_buffer();
+    read_mailboxes();
 
-        recording_record(0, &my_state, 4);
-        recording_do_timestep_update(time);
-    }
+    // find my next state
+    next_state();
+
+    // do a safety check on number of states. Not like we can fix it
+    // if we've missed events
+    do_safety_check();
+
+    send_state();
+
+    record_state();
+    recording_do_timestep_update(time);
+
+    tick_profiler_end_tick();
 }
 
 void do_safety_check(){
@@ -161,6 +246,9 @@ void do_safety_check(){
     if (total != 8){
          log_error("didn't receive the correct number of states");
          log_error("only received %d states", total);
+         if (total < 8) {
+             tick_profiler_record_lost_packets(8 - total);
+         }
     }
     log_debug("only received %d alive states",
              alive_states_recieved_this_tick);
@@ -202,14 +290,19 @@ void send_state(){
     alive_states_recieved_this_tick = 0;
     dead_states_recieved_this_tick = 0;
 
+    // hand my new state to the neighbours on this chip
+    sdram_mailbox_write(time, &my_state);
+
     // send my new state to the simulation neighbours
-    log_debug("sending my state of %d via multicast with key %d",
-              my_state, my_key);
-    while (!spin1_send_mc_packet(my_key, my_state, WITH_PAYLOAD)) {
-        spin1_delay_us(1);
-    }
+    if (has_key) {
+        log_debug("sending my state of %d via multicast with key %d",
+                  my_state, my_key);
+        while (!spin1_send_mc_packet(my_key, my_state, WITH_PAYLOAD)) {
+            spin1_delay_us(1);
+        }
 
-    log_debug("sent my state via multicast");
+        log_debug("sent my state via multicast");
+    }
 }
 
 void next_state(){
@@ -249,6 +342,15 @@ static bool initialise_recording(){
     bool success = recording_initialize(
         recording_region, &recording_flags);
     log_info("Recording flags = 0x%08x", recording_flags);
+
+    // record only the changes of my state if asked to
+    address_t recording_mode_region = data_specification_get_region(
+        RECORDING_MODE, address);
+    record_changes_only = recording_mode_region[0] == 1;
+    if (record_changes_only) {
+        delta_recording_initialise(&state_changes, 0);
+        log_info("Recording only the changes of my state");
+    }
     return success;
 }
 
@@ -275,20 +377,37 @@ static bool initialize(uint32_t *timer_period) {
     // initialise transmission keys
     address_t transmission_region_address = data_specification_get_region(
             TRANSMISSIONS, address);
-    if (transmission_region_address[HAS_KEY] == 1) {
+    has_key = transmission_region_address[HAS_KEY] == 1;
+    if (has_key) {
         my_key = transmission_region_address[MY_KEY];
         log_info("my key is %d\n", my_key);
     } else {
-        log_error(
-            "this conways cell can't effect anything, deduced as an error,"
-            "please fix the application fabric and try again\n");
+        log_info("all my neighbours are on this chip\n");
+    }
+
+    // initialise the mailbox my state is shared through on this chip, and
+    // the mailboxes of my neighbours on this chip
+    sdram_mailbox_producer_initialise(
+        data_specification_get_region(SDRAM_MAILBOX, address));
+    if (!sdram_mailbox_consumer_initialise(
+            data_specification_get_region(MAILBOX_READS, address),
+            mailboxes_read)) {
+        return false;
+    }
+
+    // measure the cost of my ticks
+    tick_profiler_initialise(
+        data_specification_get_region(TICK_PROFILE, address));
+
+    // count the packets of each neighbour, if asked to
+    if (!key_trace_initialise(
+            data_specification_get_region(KEY_TRACE, address))) {
         return false;
     }
 
     // read my state
-    address_t my_state_region_address = data_specification_get_region(
-        STATE, address);
-    my_state = my_state_region_address[INITIAL_STATE];
+    state_region = data_specification_get_region(STATE, address);
+    my_state = state_region[INITIAL_STATE];
     log_info("my initial state is %d\n", my_state);
 
     // read neighbour states for initial tick
@@ -308,6 +427,9 @@ static bool initialize(uint32_t *timer_period) {
         return false;
     }
 
+    // everything is allocated, so record how much DTCM I use
+    tick_profiler_record_dtcm_usage();
+
     return true;
 
 
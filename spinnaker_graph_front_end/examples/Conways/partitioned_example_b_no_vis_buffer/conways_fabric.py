@@ -0,0 +1,246 @@
+# pacman imports
+from pacman.model.graphs.machine import MachineVertex
+
+# spinn front end common imports
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+# graph front end imports
+from spinnaker_graph_front_end.utility_models import SDRAMMailboxMachineEdge
+from spinnaker_graph_front_end.utilities.buffer_settings \
+    import get_buffer_settings
+from spinnaker_graph_front_end.utilities.lattice_keys \
+    import LatticeKeys, morton_order
+
+from spinnaker_graph_front_end.examples.Conways.\
+    partitioned_example_b_no_vis_buffer.conways_basic_cell \
+    import ConwayBasicCell
+
+# general imports
+import struct
+
+# The neighbours of a cell, and the labels of the edges from them
+_NEIGHBOURS = [(0, 1, "N"), (1, 1, "NE"), (1, 0, "E"), (1, -1, "SE"),
+               (0, -1, "S"), (-1, -1, "SW"), (-1, 0, "W"), (-1, 1, "NW")]
+
+
+class ConwayFabricCell(ConwayBasicCell):
+    """ A cell of a ConwayFabric, which holds only its fabric and its index;\
+        its state is a byte of the fabric and its settings those of the\
+        fabric, so that a fabric of millions of cells fits in memory
+    """
+
+    def __init__(self, fabric, index):
+
+        # the cell holds none of the attributes of ConwayBasicCell, so it
+        # overrides every member which reads them, as that class requires
+        MachineVertex.__init__(self, None)
+        self._fabric = fabric
+        self._index = index
+
+    @property
+    def label(self):
+        return self._fabric.label_of(self._index)
+
+    @property
+    def coordinates(self):
+        return self._fabric.coordinates_of(self._index)
+
+    @property
+    def state(self):
+        return self._fabric.get_state(self._index)
+
+    @property
+    def record_changes_only(self):
+        return self._fabric.record_changes_only
+
+    @property
+    def buffer_settings(self):
+        return self._fabric.buffer_settings
+
+    @property
+    def _resource_model(self):
+        return self._fabric.resource_model
+
+    @property
+    def _written_recording_sizing(self):
+        return self._fabric.recording_sizing
+
+    @_written_recording_sizing.setter
+    def _written_recording_sizing(self, sizing):
+
+        # the cells are sized alike, for the same run
+        self._fabric.recording_sizing = sizing
+
+    def _count_neighbour_states(self, edges):
+        return self._fabric.count_neighbour_states(self._index)
+
+    def restore_checkpoint(self, state):
+        self._fabric.set_state(
+            self._index, struct.unpack("<I", state)[0] != 0)
+
+
+class ConwayFabric(object):
+    """ A toroidal fabric of Conway cells whose states are held in one\
+        array, indexed by y * width + x, with the settings shared by the\
+        cells held once
+    """
+
+    __slots__ = [
+        # The size of the fabric
+        "_width",
+        "_height",
+
+        # The label of the fabric, from which those of the cells are made
+        "_label",
+
+        # The state of each cell as a byte, 1 for alive
+        "_states",
+
+        # Whether the cells record only the changes of their states
+        "_record_changes_only",
+
+        # The settings shared by every cell
+        "_buffer_settings",
+        "_resource_model",
+
+        # The sizing of the recording regions of the cells when they were
+        # last written
+        "_recording_sizing",
+
+        # The cells, by index
+        "_cells"
+    ]
+
+    def __init__(self, width, height, alive=(), record_changes_only=False,
+                 label="cell"):
+        """
+        :param width: the number of cells across the fabric
+        :param height: the number of cells up the fabric
+        :param alive: the (x, y) of each cell which starts alive
+        :param record_changes_only: True to record the state of each cell\
+            only when it changes
+        :param label: the label of the fabric
+        """
+        if width < 3 or height < 3:
+            raise ConfigurationException(
+                "A fabric must be at least 3 by 3, so that each cell has 8 "
+                "different neighbours")
+        self._width = width
+        self._height = height
+        self._label = label
+        self._states = bytearray(width * height)
+        for x, y in alive:
+            self._states[self.index_of(x, y)] = 1
+        self._record_changes_only = record_changes_only
+        self._buffer_settings = get_buffer_settings()
+        self._resource_model = None
+        self._recording_sizing = None
+        self._cells = [ConwayFabricCell(self, index)
+                       for index in range(width * height)]
+
+    @property
+    def width(self):
+        return self._width
+
+    @property
+    def height(self):
+        return self._height
+
+    @property
+    def record_changes_only(self):
+        return self._record_changes_only
+
+    @property
+    def buffer_settings(self):
+        return self._buffer_settings
+
+    @property
+    def resource_model(self):
+        if self._resource_model is None:
+            self._resource_model = \
+                ConwayBasicCell._resource_model.fget(self._cells[0])
+        return self._resource_model
+
+    @property
+    def recording_sizing(self):
+        return self._recording_sizing
+
+    @recording_sizing.setter
+    def recording_sizing(self, sizing):
+        self._recording_sizing = sizing
+
+    def index_of(self, x, y):
+        return (y % self._height) * self._width + (x % self._width)
+
+    def coordinates_of(self, index):
+        y, x = divmod(index, self._width)
+        return x, y
+
+    def label_of(self, index):
+        x, y = self.coordinates_of(index)
+        return "{}_{}_{}".format(self._label, x, y)
+
+    def cell(self, x, y):
+        return self._cells[self.index_of(x, y)]
+
+    def get_state(self, index):
+        return self._states[index] != 0
+
+    def set_state(self, index, alive):
+        self._states[index] = 1 if alive else 0
+
+    def count_neighbour_states(self, index):
+        """ The numbers of neighbours of a cell alive and dead at the start\
+            of the run, from the states of the fabric
+
+        :rtype: (int, int)
+        """
+        x, y = self.coordinates_of(index)
+        alive = sum(self._states[self.index_of(x + dx, y + dy)]
+                    for dx, dy, _ in _NEIGHBOURS)
+        return alive, len(_NEIGHBOURS) - alive
+
+    def add_to_graph(self, add_vertex, add_edge, machine_graph=None):
+        """ Add the cells and the edges from their neighbours to the graph
+
+        :param add_vertex: function to add a machine vertex to the graph
+        :param add_edge: function to add a machine edge to the graph, given\
+            the edge and its partition
+        :param machine_graph: the graph, to key the cells by their\
+            coordinates, or None to leave the keys to the key allocator
+        """
+        coordinates = [(x, y) for x in range(self._width)
+                       for y in range(self._height)]
+        for x, y in morton_order(coordinates):
+            add_vertex(self.cell(x, y))
+        for x, y in coordinates:
+            cell = self.cell(x, y)
+            for dx, dy, compass in _NEIGHBOURS:
+                add_edge(
+                    SDRAMMailboxMachineEdge(
+                        cell, self.cell(x + dx, y + dy), label=compass),
+                    ConwayBasicCell.PARTITION_ID)
+        if machine_graph is not None:
+            keys = LatticeKeys(self._width, self._height)
+            for x, y in coordinates:
+                keys.add_constraint(
+                    machine_graph, self.cell(x, y),
+                    ConwayBasicCell.PARTITION_ID, x, y)
+
+    def get_states(self, buffer_manager, placements):
+        """ Get the recorded states of every cell
+
+        :return: the states of the fabric at each tick, each as a bytearray\
+            indexed by y * width + x with 1 for alive
+        :rtype: list of bytearray
+        """
+        states = list()
+        for index, cell in enumerate(self._cells):
+            data = cell.get_data(
+                buffer_manager, placements.get_placement_of_vertex(cell))
+            while len(states) < len(data):
+                states.append(bytearray(len(self._cells)))
+            for tick, alive in enumerate(data):
+                if alive:
+                    states[tick][index] = 1
+        return states
@@ -0,0 +1,38 @@
+import spinnaker_graph_front_end as front_end
+
+from spinnaker_graph_front_end.examples.Conways.\
+    partitioned_example_b_no_vis_buffer.conways_fabric import ConwayFabric
+
+import os
+import random
+
+runtime = 50
+WIDTH = 64
+HEIGHT = 64
+ALIVE_FRACTION = 0.3
+
+front_end.setup(model_binary_folder=os.path.dirname(__file__))
+
+cores = front_end.get_number_of_available_cores_on_machine()
+if cores <= WIDTH * HEIGHT:
+    raise KeyError("Don't have enough cores to run simulation")
+
+# the states of the cells are held by the fabric, and the cells hold only
+# their index into it, so this scales to very large fabrics
+random.seed(1)
+fabric = ConwayFabric(
+    WIDTH, HEIGHT,
+    alive=[(x, y) for x in range(WIDTH) for y in range(HEIGHT)
+           if random.random() < ALIVE_FRACTION],
+    record_changes_only=True)
+fabric.add_to_graph(
+    front_end.add_machine_vertex_instance,
+    front_end.add_machine_edge_instance, front_end.machine_graph())
+
+front_end.run(runtime)
+
+states = fabric.get_states(front_end.buffer_manager(), front_end.placements())
+for time, state in enumerate(states):
+    print "at time {}: {} cells alive".format(time, sum(state))
+
+front_end.stop()
@@ -1,11 +1,14 @@
-from pacman.model.graphs.machine import MachineEdge
 import spinnaker_graph_front_end as front_end
+from spinnaker_graph_front_end.utility_models import SDRAMMailboxMachineEdge
+from spinnaker_graph_front_end.utilities.lattice_keys \
+    import LatticeKeys, morton_order
 
 from spinnaker_graph_front_end.examples.Conways.\
     partitioned_example_b_no_vis_buffer.conways_basic_cell \
     import ConwayBasicCell
 
 import os
+import sys
 
 runtime = 50
 # machine_time_step = 100
@@ -13,9 +16,23 @@ runtime = 50
 MAX_X_SIZE_OF_FABRIC = 7
 MAX_Y_SIZE_OF_FABRIC = 7
 
+# record the state of a cell only when it changes, rather than every tick
+RECORD_CHANGES_ONLY = True
+
+# when run as a script, the states of the cells are saved to the checkpoint
+# file given, if any, after the run; if it already exists, the cells carry on
+# from there
+checkpoint_file = None
+if __name__ == "__main__" and len(sys.argv) > 1:
+    checkpoint_file = sys.argv[1]
+restore_from = None
+if checkpoint_file is not None and os.path.exists(checkpoint_file):
+    restore_from = checkpoint_file
+
 # set up the front end and ask for the detected machines dimensions
 front_end.setup(
-    n_chips_required=2, model_binary_folder=os.path.dirname(__file__))
+    n_chips_required=2, model_binary_folder=os.path.dirname(__file__),
+    restore_from=restore_from)
 
 # figure out if machine can handle simulation
 cores = front_end.get_number_of_available_cores_on_machine()
@@ -29,14 +46,16 @@ vertices = [
 
 active_states = [(2, 2), (3, 2), (3, 3), (4, 3), (2, 4)]
 
-# build vertices
-for x in range(0, MAX_X_SIZE_OF_FABRIC):
-    for y in range(0, MAX_Y_SIZE_OF_FABRIC):
-        vert = ConwayBasicCell(
-            "cell{}".format((x * MAX_X_SIZE_OF_FABRIC) + y),
-            (x, y) in active_states)
-        vertices[x][y] = vert
-        front_end.add_machine_vertex_instance(vert)
+# build vertices, adding them in Morton order so that square blocks of cells
+# are placed together
+for x, y in morton_order(
+        (x, y) for x in range(0, MAX_X_SIZE_OF_FABRIC)
+        for y in range(0, MAX_Y_SIZE_OF_FABRIC)):
+    vert = ConwayBasicCell(
+        "cell{}".format((x * MAX_X_SIZE_OF_FABRIC) + y),
+        (x, y) in active_states, RECORD_CHANGES_ONLY)
+    vertices[x][y] = vert
+    front_end.add_machine_vertex_instance(vert)
 
 # verify the initial state
 output = ""
@@ -68,13 +87,24 @@ for x in range(0, MAX_X_SIZE_OF_FABRIC):
             ((x - 1) % MAX_X_SIZE_OF_FABRIC,
                 (y + 1) % MAX_Y_SIZE_OF_FABRIC, "NW")]
 
+        # neighbours which end up on the same chip share their states
+        # through SDRAM rather than multicast packets
         for (dest_x, dest_y, compass) in positions:
             front_end.add_machine_edge_instance(
-                MachineEdge(
+                SDRAMMailboxMachineEdge(
                     vertices[x][y], vertices[dest_x][dest_y],
                     label=compass),
                 ConwayBasicCell.PARTITION_ID)
 
+# key each cell by its coordinates, so that the routes of a block of cells
+# compress into one router entry
+lattice_keys = LatticeKeys(MAX_X_SIZE_OF_FABRIC, MAX_Y_SIZE_OF_FABRIC)
+for x in range(0, MAX_X_SIZE_OF_FABRIC):
+    for y in range(0, MAX_Y_SIZE_OF_FABRIC):
+        lattice_keys.add_constraint(
+            front_end.machine_graph(), vertices[x][y],
+            ConwayBasicCell.PARTITION_ID, x, y)
+
 # run the simulation
 front_end.run(runtime)
 
@@ -102,5 +132,9 @@ for time in range(0, runtime):
     print output
     print "\n\n"
 
+# save the states to carry on from in a later run
+if checkpoint_file is not None:
+    front_end.checkpoint(checkpoint_file)
+
 # clear the machine
 front_end.stop()
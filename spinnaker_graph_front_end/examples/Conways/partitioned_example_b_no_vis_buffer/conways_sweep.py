@@ -0,0 +1,78 @@
+import spinnaker_graph_front_end as front_end
+from spinnaker_graph_front_end.utility_models import SDRAMMailboxMachineEdge
+from spinnaker_graph_front_end.utilities.lattice_keys import morton_order
+
+from spinnaker_graph_front_end.examples.Conways.\
+    partitioned_example_b_no_vis_buffer.conways_basic_cell \
+    import ConwayBasicCell
+
+import os
+
+runtime = 50
+MAX_X_SIZE_OF_FABRIC = 7
+MAX_Y_SIZE_OF_FABRIC = 7
+
+# the starting patterns swept over, each a separate graph of the batch run
+# side by side on one allocation
+VARIANTS = {
+    "glider": [(2, 2), (3, 2), (3, 3), (4, 3), (2, 4)],
+    "blinker": [(2, 3), (3, 3), (4, 3)],
+    "toad": [(2, 3), (3, 3), (4, 3), (3, 4), (4, 4), (5, 4)],
+    "r_pentomino": [(3, 2), (2, 3), (3, 3), (3, 4), (4, 4)]}
+
+COMPASS = [(0, 1, "N"), (1, 1, "NE"), (1, 0, "E"), (1, -1, "SE"),
+           (0, -1, "S"), (-1, -1, "SW"), (-1, 0, "W"), (-1, 1, "NW")]
+
+front_end.setup(
+    n_chips_required=2 * len(VARIANTS),
+    model_binary_folder=os.path.dirname(__file__))
+
+cores = front_end.get_number_of_available_cores_on_machine()
+if cores <= (MAX_X_SIZE_OF_FABRIC * MAX_Y_SIZE_OF_FABRIC * len(VARIANTS)):
+    raise KeyError("Don't have enough cores to run simulation")
+
+batch = front_end.create_graph_batch()
+for name, active_states in sorted(VARIANTS.items()):
+    graph = batch.add_graph(name)
+
+    # build the cells of the variant in Morton order
+    vertices = dict()
+    for x, y in morton_order(
+            (x, y) for x in range(0, MAX_X_SIZE_OF_FABRIC)
+            for y in range(0, MAX_Y_SIZE_OF_FABRIC)):
+        vertices[x, y] = ConwayBasicCell(
+            "{}_cell{}".format(name, (x * MAX_X_SIZE_OF_FABRIC) + y),
+            (x, y) in active_states)
+        graph.add_machine_vertex_instance(vertices[x, y])
+
+    # connect each cell to its neighbours in the same variant only
+    for (x, y), vertex in vertices.items():
+        for dx, dy, compass in COMPASS:
+            graph.add_machine_edge_instance(
+                SDRAMMailboxMachineEdge(
+                    vertex, vertices[(x + dx) % MAX_X_SIZE_OF_FABRIC,
+                                     (y + dy) % MAX_Y_SIZE_OF_FABRIC],
+                    label=compass),
+                ConwayBasicCell.PARTITION_ID)
+
+    # the lattice keys of each variant are in its own range
+    lattice_keys = graph.lattice_keys(
+        MAX_X_SIZE_OF_FABRIC, MAX_Y_SIZE_OF_FABRIC)
+    for (x, y), vertex in vertices.items():
+        lattice_keys.add_constraint(
+            front_end.machine_graph(), vertex, ConwayBasicCell.PARTITION_ID,
+            x, y)
+
+front_end.run(runtime)
+
+# the recorded states of each variant
+results = front_end.get_graph_batch_results(
+    batch, lambda vertex, placement: vertex.get_data(
+        front_end.buffer_manager(), placement))
+
+for name, cells in results.items():
+    n_alive = [sum(1 for states in cells.values() if states[time])
+               for time in range(runtime)]
+    print "{}: cells alive at each step {}".format(name, n_alive)
+
+front_end.stop()
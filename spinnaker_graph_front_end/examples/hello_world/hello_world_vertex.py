@@ -1,6 +1,5 @@
 from pacman.model.decorators import overrides
 from pacman.model.graphs.machine import MachineVertex
-from pacman.model.resources import CPUCyclesPerTickResource, DTCMResource
 from pacman.model.resources import ResourceContainer, SDRAMResource
 
 from spinn_front_end_common.utilities import globals_variables
@@ -15,11 +14,19 @@ from spinn_front_end_common.interface.buffer_management\
     import recording_utilities
 from spinn_front_end_common.utilities.utility_objs import ExecutableStartType
 
+from spinnaker_graph_front_end.utilities.resource_model \
+    import ResourceModel, load_resource_model
+
 from enum import Enum
 import logging
+import os
 
 logger = logging.getLogger(__name__)
 
+# Estimates of the resources of the binary until they have been measured
+_ESTIMATED_RESOURCES = ResourceModel(
+    dtcm_base=100, dtcm_per_element=0, cycles_base=45, cycles_per_element=0)
+
 
 class HelloWorldVertex(
         MachineVertex, MachineDataSpecableVertex, AbstractHasAssociatedBinary,
@@ -54,9 +61,12 @@ class HelloWorldVertex(
     @property
     @overrides(MachineVertex.resources_required)
     def resources_required(self):
+        model = load_resource_model(
+            self.get_binary_file_name(), [os.path.dirname(__file__)],
+            _ESTIMATED_RESOURCES)
         resources = ResourceContainer(
-            cpu_cycles=CPUCyclesPerTickResource(45),
-            dtcm=DTCMResource(100), sdram=SDRAMResource(100))
+            cpu_cycles=model.cpu_cycles_resource(),
+            dtcm=model.dtcm_resource(), sdram=SDRAMResource(100))
 
         resources.extend(recording_utilities.get_recording_resources(
             [self._string_data_size],
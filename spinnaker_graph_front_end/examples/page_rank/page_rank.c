@@ -0,0 +1,389 @@
+
+//! imports
+#include "spin1_api.h"
+#include "common-typedefs.h"
+#include <data_specification.h>
+#include <simulation.h>
+#include <debug.h>
+#include <reduction.h>
+#include <dma_stream.h>
+#include <tick_profiler.h>
+#include <key_trace.h>
+
+//! control value, which says how many timer ticks to run for before exiting
+static uint32_t simulation_ticks = 0;
+static uint32_t time = 0;
+
+//! int as a bool to represent if this simulation should run forever
+static uint32_t infinite_run;
+
+//! human readable definitions of each region in SDRAM
+typedef enum regions_e {
+    SYSTEM_REGION,
+    PARAMETERS,
+    NODES,
+    INCOMING_KEYS,
+    INCOMING_EDGES,
+    RANKS,
+    REDUCTION,
+    TICK_PROFILE,
+    KEY_TRACE
+} regions_e;
+
+//! values for the priority for each callback; the DMA callback must be able
+//! to interrupt the timer callback, which waits for the incoming edges to
+//! be streamed in
+typedef enum callback_priorities{
+    MC_PACKET = -1, DMA = 0, SDP = 1, TIMER = 2
+} callback_priorities;
+
+//! the parameters of this core; ranks are unsigned 1.31 fixed point
+typedef struct parameters_t {
+    uint32_t has_key;
+    uint32_t key;
+    uint32_t n_nodes;
+    uint32_t damping;
+    uint32_t teleport;
+    uint32_t n_incoming;
+    uint32_t n_slots;
+    uint32_t n_expected_packets;
+    //! the change of the ranks of this core in an iteration below which
+    //! this core is done
+    uint32_t tolerance;
+} parameters_t;
+
+//! a node of this core: its rank, and the share of it passed along each of
+//! its outgoing edges (one over its out degree, or 0 if it has none)
+typedef struct node_t {
+    uint32_t rank;
+    uint32_t out_scale;
+} node_t;
+
+//! the keys of a vertex with nodes linking to nodes of this core, and the
+//! slot of the contribution of its first node
+typedef struct incoming_keys_t {
+    uint32_t key;
+    uint32_t mask;
+    uint32_t slot_offset;
+} incoming_keys_t;
+
+static parameters_t parameters;
+static node_t *nodes;
+static incoming_keys_t *incoming_keys;
+
+//! the sum of the contributions to each node of this core
+static uint32_t *sums;
+
+//! the contributions received from each incoming node, by the parity of
+//! the iteration they are for
+static uint32_t *contributions[2];
+static volatile uint32_t n_received[2];
+
+//! the incoming edges; for each slot, the number of nodes of this core it
+//! links to followed by their indices
+static dma_stream_t incoming_edges;
+
+//! where the ranks are written for the host when the run pauses
+static address_t ranks_region;
+
+//! the total absolute change of the ranks of this core in this iteration
+static uint32_t residual;
+
+//! \brief Multiply two unsigned 1.31 fixed point numbers
+static inline uint32_t mul_u1_31(uint32_t a, uint32_t b) {
+    return (uint32_t) (((uint64_t) a * b) >> 31);
+}
+
+//! \brief Store a contribution of an incoming node, or take the result of
+//!     a reduction
+//! \param[in] key: the key of the node, with the parity of the iteration in
+//!     the bottom bit
+//! \param[in] payload: the contribution
+void receive_data(uint key, uint payload) {
+    key_trace_record(key);
+    if (reduction_receive(key, payload)) {
+        return;
+    }
+    for (uint32_t i = 0; i < parameters.n_incoming; i++) {
+        incoming_keys_t *incoming = &incoming_keys[i];
+        if ((key & incoming->mask) == incoming->key) {
+            uint32_t slot = incoming->slot_offset +
+                ((key & ~incoming->mask) >> 1);
+            uint32_t parity = key & 1;
+            if (slot < parameters.n_slots) {
+                contributions[parity][slot] = payload;
+                n_received[parity] += 1;
+            }
+            return;
+        }
+    }
+    log_debug("received unexpected key 0x%08x", key);
+}
+
+//! \brief Sum the contributions to each node of this core sent in an
+//!     iteration, streaming in the incoming edges
+//! \param[in] iteration: the iteration the contributions were sent in
+static void gather_contributions(uint32_t iteration) {
+    uint32_t parity = iteration & 1;
+    uint32_t *contribution = contributions[parity];
+    for (uint32_t i = 0; i < parameters.n_nodes; i++) {
+        sums[i] = 0;
+    }
+
+    uint32_t slot = 0;
+    uint32_t remaining = 0;
+    uint32_t value = 0;
+    uint32_t n_bytes;
+    uint32_t *block;
+    dma_stream_begin(&incoming_edges);
+    while ((block = dma_stream_next(&incoming_edges, &n_bytes)) != NULL) {
+        uint32_t n_words = n_bytes >> 2;
+        for (uint32_t i = 0; i < n_words; i++) {
+            if (remaining == 0) {
+                remaining = block[i];
+                value = contribution[slot++];
+            } else {
+                sums[block[i]] += value;
+                remaining -= 1;
+            }
+        }
+    }
+
+    // a lost contribution is replaced by the one from two iterations ago
+    uint cpsr = spin1_int_disable();
+    if (n_received[parity] < parameters.n_expected_packets) {
+        tick_profiler_record_lost_packets(
+            parameters.n_expected_packets - n_received[parity]);
+    }
+    n_received[parity] = 0;
+    spin1_mode_restore(cpsr);
+}
+
+//! \brief Work out the new ranks of the nodes of this core
+static void update_ranks(void) {
+    uint32_t total_change = 0;
+    for (uint32_t i = 0; i < parameters.n_nodes; i++) {
+        uint32_t rank = parameters.teleport +
+            mul_u1_31(parameters.damping, sums[i]);
+        uint32_t change = (rank > nodes[i].rank) ?
+            rank - nodes[i].rank : nodes[i].rank - rank;
+        if (total_change + change < total_change) {
+            total_change = UINT32_MAX;
+        } else {
+            total_change += change;
+        }
+        nodes[i].rank = rank;
+    }
+    residual = total_change;
+}
+
+//! \brief Send the contributions of the nodes of this core to the nodes
+//!     they link to
+//! \param[in] iteration: the iteration the contributions are for
+static void send_contributions(uint32_t iteration) {
+    if (!parameters.has_key) {
+        return;
+    }
+    uint32_t parity = iteration & 1;
+    for (uint32_t i = 0; i < parameters.n_nodes; i++) {
+        if (nodes[i].out_scale == 0) {
+            continue;
+        }
+        uint32_t contribution = mul_u1_31(nodes[i].rank, nodes[i].out_scale);
+        while (!spin1_send_mc_packet(
+                parameters.key + (i << 1) + parity, contribution,
+                WITH_PAYLOAD)) {
+            spin1_delay_us(1);
+        }
+    }
+}
+
+//! \brief Write the ranks to SDRAM for the host
+static void write_ranks(void) {
+    for (uint32_t i = 0; i < parameters.n_nodes; i++) {
+        ranks_region[i] = nodes[i].rank;
+    }
+}
+
+/****f* page_rank.c/update
+ *
+ * SUMMARY
+ *  Runs an iteration each timer tick: the contributions sent in the
+ *  previous tick are summed into new ranks, and the contributions of the new
+ *  ranks are sent
+ *
+ * SYNOPSIS
+ *  void update (uint ticks, uint b)
+ *
+ * SOURCE
+ */
+void update(uint ticks, uint b) {
+    use(b);
+    use(ticks);
+
+    time++;
+
+    // every core is done, so the ranks have converged
+    if (reduction_is_complete()) {
+        log_info("Converged after %d iterations", time - 1);
+        write_ranks();
+        key_trace_write_back();
+        spin1_callback_off(TIMER_TICK);
+        simulation_exit();
+        return;
+    }
+
+    // check that the run time hasn't already elapsed and thus needs to be
+    // killed
+    if ((infinite_run != TRUE) && (time >= simulation_ticks)) {
+        log_info("Simulation complete.\n");
+        write_ranks();
+        key_trace_write_back();
+
+        // falls into the pause resume mode of operating
+        simulation_handle_pause_resume(NULL);
+
+        // do this tick again when resumed, so the iterations carry on
+        time -= 1;
+        return;
+    }
+
+    tick_profiler_start_tick();
+
+    if (time > 0) {
+        gather_contributions(time - 1);
+        update_ranks();
+
+        // the residuals of all the cores are summed by the reduction tree,
+        // which also ends the run once every core is within its tolerance
+        reduction_contribute(0, time, residual);
+        reduction_signal_done(time, residual <= parameters.tolerance);
+    }
+    send_contributions(time);
+    tick_profiler_end_tick();
+}
+
+static bool initialize(uint32_t *timer_period) {
+    log_info("Initialise: started\n");
+
+    // Get the address this core's DTCM data starts at from SRAM
+    address_t address = data_specification_get_data_address();
+
+    // Read the header
+    if (!data_specification_read_header(address)) {
+        log_error("failed to read the data spec header");
+        return false;
+    }
+
+    // Get the timing details and set up the simulation interface
+    if (!simulation_initialise(
+            data_specification_get_region(SYSTEM_REGION, address),
+            APPLICATION_NAME_HASH, timer_period, &simulation_ticks,
+            &infinite_run, SDP, DMA)) {
+        return false;
+    }
+
+    spin1_memcpy(
+        &parameters, data_specification_get_region(PARAMETERS, address),
+        sizeof(parameters));
+    log_info("%d nodes, %d incoming vertices, %d slots",
+             parameters.n_nodes, parameters.n_incoming, parameters.n_slots);
+
+    // the nodes are updated every tick, so keep them in DTCM
+    uint32_t nodes_size = parameters.n_nodes * sizeof(node_t);
+    nodes = spin1_malloc(nodes_size);
+    sums = spin1_malloc(parameters.n_nodes * sizeof(uint32_t));
+    if (nodes == NULL || sums == NULL) {
+        log_error("Could not allocate the nodes");
+        return false;
+    }
+    spin1_memcpy(
+        nodes, data_specification_get_region(NODES, address), nodes_size);
+
+    uint32_t incoming_size = parameters.n_incoming * sizeof(incoming_keys_t);
+    incoming_keys = spin1_malloc(incoming_size);
+    if (incoming_keys == NULL && parameters.n_incoming > 0) {
+        log_error("Could not allocate the incoming keys");
+        return false;
+    }
+    spin1_memcpy(
+        incoming_keys, data_specification_get_region(INCOMING_KEYS, address),
+        incoming_size);
+
+    for (uint32_t parity = 0; parity < 2; parity++) {
+        n_received[parity] = 0;
+        contributions[parity] = spin1_malloc(
+            parameters.n_slots * sizeof(uint32_t));
+        if (contributions[parity] == NULL && parameters.n_slots > 0) {
+            log_error("Could not allocate the contributions");
+            return false;
+        }
+        for (uint32_t i = 0; i < parameters.n_slots; i++) {
+            contributions[parity][i] = 0;
+        }
+    }
+
+    if (!dma_stream_initialise(
+            &incoming_edges,
+            data_specification_get_region(INCOMING_EDGES, address))) {
+        return false;
+    }
+
+    ranks_region = data_specification_get_region(RANKS, address);
+
+    if (!reduction_initialise(
+            data_specification_get_region(REDUCTION, address))) {
+        return false;
+    }
+
+    if (!key_trace_initialise(
+            data_specification_get_region(KEY_TRACE, address))) {
+        return false;
+    }
+
+    tick_profiler_initialise(
+        data_specification_get_region(TICK_PROFILE, address));
+    tick_profiler_record_dtcm_usage();
+
+    return true;
+}
+
+/****f* page_rank.c/c_main
+ *
+ * SUMMARY
+ *  This function is called at application start-up.
+ *  It is used to register event callbacks and begin the simulation.
+ *
+ * SYNOPSIS
+ *  int c_main()
+ *
+ * SOURCE
+ */
+void c_main() {
+    log_info("starting page rank\n");
+
+    // Load DTCM data
+    uint32_t timer_period;
+
+    // initialise the model
+    if (!initialize(&timer_period)) {
+        log_error("Error in initialisation - exiting!");
+        rt_error(RTE_SWERR);
+    }
+
+    // set timer tick value to configured value
+    log_info("setting timer to execute every %d microseconds", timer_period);
+    spin1_set_timer_tick(timer_period);
+
+    // register callbacks
+    spin1_callback_on(MCPL_PACKET_RECEIVED, receive_data, MC_PACKET);
+    spin1_callback_on(TIMER_TICK, update, TIMER);
+
+    // start execution
+    log_info("Starting\n");
+
+    // Start the time at "-1" so that the first tick will be 0
+    time = UINT32_MAX;
+
+    simulation_run();
+}
@@ -0,0 +1,63 @@
+import spinnaker_graph_front_end as front_end
+
+from spinnaker_graph_front_end.examples.page_rank.page_rank_graph \
+    import PageRankGraph
+from spinnaker_graph_front_end.examples.page_rank.page_rank_builder \
+    import add_page_rank_graph, get_ranks, get_residuals, rebalance_page_rank
+from spinnaker_graph_front_end.examples.page_rank.page_rank_reference \
+    import page_rank, converged_iteration
+
+import os
+import sys
+
+N_NODES = 1000
+N_EDGES = 8000
+NODES_PER_CORE = 100
+DAMPING = 0.85
+TOLERANCE = 1e-6
+
+# the iterations run before the nodes are split again by the cost of ranking
+# them, so that the slowest core is closer to the average one
+REBALANCE_AFTER = 10
+
+# rank a graph read from an edge list if given one, or a random graph
+if len(sys.argv) > 1:
+    graph = PageRankGraph.from_edge_list(sys.argv[1])
+else:
+    graph = PageRankGraph.random(N_NODES, N_EDGES, seed=1)
+print "ranking {} nodes with {} edges".format(graph.n_nodes, graph.n_edges)
+
+setup_args = dict(model_binary_folder=os.path.dirname(__file__))
+front_end.setup(**setup_args)
+vertices, residual_tree = add_page_rank_graph(
+    graph, NODES_PER_CORE, DAMPING, TOLERANCE)
+front_end.run(REBALANCE_AFTER)
+residuals = get_residuals(residual_tree)
+
+vertices, residual_tree, rebalancing = rebalance_page_rank(
+    graph, vertices, residual_tree, DAMPING, TOLERANCE, **setup_args)
+print "rebalanced: {}".format(rebalancing)
+
+# the residuals of a graph that was kept are read again from the start
+if not rebalancing.is_worthwhile:
+    residuals = list()
+
+# run until every core's ranks have converged
+front_end.run_until_complete()
+
+ranks = get_ranks(vertices)
+residuals += get_residuals(residual_tree)
+front_end.stop()
+
+# check against the same number of iterations on the host
+expected_ranks, expected_residuals = page_rank(graph, DAMPING, len(residuals))
+max_error = max(
+    abs(rank - expected) for rank, expected in zip(ranks, expected_ranks))
+print "largest difference from the host ranks: {}".format(max_error)
+print "converged to {} after {} iterations ({} on the host)".format(
+    TOLERANCE, converged_iteration(residuals, TOLERANCE),
+    converged_iteration(expected_residuals, TOLERANCE))
+
+top = sorted(range(graph.n_nodes), key=lambda node: -ranks[node])[:10]
+for node in top:
+    print "{:>10} {:.6f}".format(graph.node_name(node), ranks[node])
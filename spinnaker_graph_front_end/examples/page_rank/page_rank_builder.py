@@ -0,0 +1,126 @@
+from pacman.model.graphs.machine import MachineEdge
+
+import spinnaker_graph_front_end as front_end
+from spinnaker_graph_front_end.utilities.node_slicing import NodeSlicing
+from spinnaker_graph_front_end.utilities.rebalance \
+    import get_vertex_cycles, plan_rebalance
+from spinnaker_graph_front_end.examples.page_rank.page_rank_vertex \
+    import PageRankVertex, RANK_SCALE
+
+
+def add_page_rank_graph(
+        graph, nodes_per_core=256, damping=0.85, tolerance=None,
+        lo_atoms=None, initial_ranks=None):
+    """ Add the vertices and edges to rank the nodes of a graph to the\
+        front end; the nodes are split into contiguous slices, each ranked\
+        by one core, and the total change of the ranks in each iteration is\
+        summed by a reduction tree.  Given a tolerance, the tree ends a\
+        run_until_complete() run once the ranks have converged.
+
+    :param graph: the graph to rank
+    :type graph: PageRankGraph
+    :param nodes_per_core: the maximum number of nodes to rank on a core
+    :param damping: the probability of following an edge, e.g. 0.85
+    :param tolerance: the total change of the ranks in an iteration below\
+        which the ranks have converged, or None to run for as long as asked
+    :param lo_atoms: the first node of each slice, to use slices of other\
+        sizes than nodes_per_core
+    :param initial_ranks: the rank of each node to start from, or None to\
+        start every node with the same rank
+    :return: the vertices, in the order of their nodes, and the tree\
+        summing the residuals
+    :rtype: (list of PageRankVertex, ReductionTree)
+    """
+    slicing = NodeSlicing(graph.n_nodes, nodes_per_core, lo_atoms)
+    for index in range(slicing.n_slices):
+        ranks = None
+        if initial_ranks is not None:
+            node_slice = slicing.get_slice(index)
+            ranks = initial_ranks[node_slice.lo_atom:node_slice.hi_atom + 1]
+        vertex = PageRankVertex(
+            "page_rank{}".format(index), graph, slicing, index, damping,
+            tolerance, ranks)
+        slicing.vertices.append(vertex)
+        front_end.add_machine_vertex_instance(vertex)
+
+    # an edge from each vertex with nodes linking to nodes of another
+    vertices = slicing.vertices
+    for vertex in vertices:
+        for index in vertex.incoming_vertex_indices:
+            front_end.add_machine_edge_instance(
+                MachineEdge(vertices[index], vertex),
+                PageRankVertex.PARTITION_ID)
+
+    residual_tree = front_end.add_reduction_tree(
+        vertices, [front_end.ReductionOperation.SUM],
+        label="page_rank_residual", completion=tolerance is not None)
+    return vertices, residual_tree
+
+
+def get_ranks(vertices):
+    """ Read the ranks of all the nodes at the end of a run
+
+    :rtype: list of float
+    """
+    ranks = list()
+    for vertex in vertices:
+        ranks.extend(vertex.read_ranks(
+            front_end.transceiver(),
+            front_end.placements().get_placement_of_vertex(vertex)))
+    return ranks
+
+
+def get_residuals(residual_tree):
+    """ Get the total absolute change of the ranks of all the nodes in\
+        each iteration
+
+    :rtype: list of float
+    """
+    return [
+        residual / RANK_SCALE
+        for residual in front_end.get_reduction_results(residual_tree)[0]]
+
+
+def rebalance_page_rank(
+        graph, vertices, residual_tree, damping=0.85, tolerance=None,
+        n_slices=None, max_nodes_per_core=None, **setup_args):
+    """ After a run, split the nodes again so that each core takes about as\
+        long over its ticks as the others, from the cost of the ticks each\
+        core measured, and carry the ranking on with the new slices.  The\
+        ranks are read from the checkpoint region of each vertex, the front\
+        end is stopped and set up again, and the graph is added again\
+        starting from the ranks read; the iterations of later runs are\
+        counted from 0 again.  Nothing is changed if the new slices are not\
+        expected to be faster.
+
+    :param graph: the graph being ranked
+    :type graph: PageRankGraph
+    :param vertices: the vertices ranking the graph, from\
+        add_page_rank_graph()
+    :param residual_tree: the tree summing their residuals
+    :param damping: the probability of following an edge, e.g. 0.85
+    :param tolerance: as for add_page_rank_graph()
+    :param n_slices: the most new slices, or None for as many as before
+    :param max_nodes_per_core: the most nodes a core can rank, or None for\
+        no limit
+    :param setup_args: the arguments to pass to setup()
+    :return: the vertices and the tree summing the residuals, new or not,\
+        and the rebalancing planned
+    :rtype: (list of PageRankVertex, ReductionTree, Rebalancing)
+    """
+    cycles, n_lost_packets = get_vertex_cycles(
+        front_end.get_tick_profiles(), vertices)
+    rebalancing = plan_rebalance(
+        [vertex.node_slice for vertex in vertices], cycles,
+        PageRankVertex.CYCLES_BASE, n_slices, max_nodes_per_core,
+        n_lost_packets)
+    if not rebalancing.is_worthwhile:
+        return vertices, residual_tree, rebalancing
+
+    ranks = get_ranks(vertices)
+    front_end.stop()
+    front_end.setup(**setup_args)
+    vertices, residual_tree = add_page_rank_graph(
+        graph, damping=damping, tolerance=tolerance,
+        lo_atoms=rebalancing.lo_atoms, initial_ranks=ranks)
+    return vertices, residual_tree, rebalancing
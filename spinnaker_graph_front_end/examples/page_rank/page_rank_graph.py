@@ -0,0 +1,99 @@
+import random
+
+
+class PageRankGraph(object):
+    """ A directed graph whose nodes are ranked, held as adjacency lists\
+        over nodes numbered from 0
+    """
+
+    __slots__ = [
+        # The names of the nodes, by number
+        "_node_names",
+
+        # The nodes each node links to, by number
+        "_successors",
+
+        # The nodes linking to each node, by number
+        "_predecessors"
+    ]
+
+    def __init__(self, n_nodes, edges, node_names=None):
+        """
+        :param n_nodes: the number of nodes
+        :param edges: iterable of (source, target) node numbers; repeated\
+            edges are ignored
+        :param node_names: the names of the nodes, by number
+        """
+        self._node_names = node_names
+        successors = [set() for _ in range(n_nodes)]
+        for source, target in edges:
+            successors[source].add(target)
+        self._successors = [sorted(targets) for targets in successors]
+        self._predecessors = [list() for _ in range(n_nodes)]
+        for source, targets in enumerate(self._successors):
+            for target in targets:
+                self._predecessors[target].append(source)
+
+    @staticmethod
+    def from_edge_list(path):
+        """ Load a graph from a file of edges, one "source target" pair of\
+            node names per line; blank lines and lines starting with # are\
+            skipped.  Nodes are numbered in the order they first appear.
+
+        :param path: the path of the file
+        :rtype: :py:class:`PageRankGraph`
+        """
+        numbers = dict()
+        names = list()
+        edges = list()
+        with open(path) as f:
+            for line in f:
+                line = line.strip()
+                if not line or line.startswith("#"):
+                    continue
+                ends = line.split()
+                if len(ends) < 2:
+                    raise ValueError("Not an edge: {}".format(line))
+                edge = list()
+                for name in ends[:2]:
+                    if name not in numbers:
+                        numbers[name] = len(names)
+                        names.append(name)
+                    edge.append(numbers[name])
+                edges.append(tuple(edge))
+        return PageRankGraph(len(names), edges, names)
+
+    @staticmethod
+    def random(n_nodes, n_edges, seed=None):
+        """ Make a graph with edges between random pairs of distinct nodes
+        """
+        rng = random.Random(seed)
+        edges = list()
+        while len(edges) < n_edges:
+            source = rng.randrange(n_nodes)
+            target = rng.randrange(n_nodes)
+            if source != target:
+                edges.append((source, target))
+        return PageRankGraph(n_nodes, edges)
+
+    @property
+    def n_nodes(self):
+        return len(self._successors)
+
+    @property
+    def n_edges(self):
+        return sum(len(targets) for targets in self._successors)
+
+    def node_name(self, node):
+        if self._node_names is None:
+            return str(node)
+        return self._node_names[node]
+
+    def successors(self, node):
+        return self._successors[node]
+
+    def predecessors(self, node):
+        return self._predecessors[node]
+
+    def out_degree(self, node):
+        return len(self._successors[node])
@@ -0,0 +1,46 @@
+""" A host implementation of the iteration run on the machine, to check its\
+    results against
+"""
+
+
+def page_rank(graph, damping, n_iterations):
+    """ Rank the nodes of a graph by power iteration.  As on the machine,\
+        the rank of nodes with no outgoing edges is not redistributed, so\
+        the ranks sum to less than one if there are any.
+
+    :param graph: the graph to rank
+    :type graph: PageRankGraph
+    :param damping: the probability of following an edge, e.g. 0.85
+    :param n_iterations: the number of iterations to run
+    :return: the ranks of the nodes, and the total absolute change of the\
+        ranks in each iteration
+    :rtype: (list of float, list of float)
+    """
+    n_nodes = graph.n_nodes
+    teleport = (1.0 - damping) / n_nodes
+    ranks = [1.0 / n_nodes] * n_nodes
+    residuals = list()
+    for _ in range(n_iterations):
+        sums = [0.0] * n_nodes
+        for node in range(n_nodes):
+            if graph.out_degree(node):
+                contribution = ranks[node] / graph.out_degree(node)
+                for target in graph.successors(node):
+                    sums[target] += contribution
+        new_ranks = [teleport + damping * total for total in sums]
+        residuals.append(sum(
+            abs(new - old) for new, old in zip(new_ranks, ranks)))
+        ranks = new_ranks
+    return ranks, residuals
+
+
+def converged_iteration(residuals, tolerance):
+    """ Find the first iteration whose total change was below a tolerance
+
+    :param residuals: the total absolute change of the ranks per iteration
+    :return: the number of the iteration from 1, or None if none was
+    """
+    for iteration, residual in enumerate(residuals):
+        if residual < tolerance:
+            return iteration + 1
+    return None
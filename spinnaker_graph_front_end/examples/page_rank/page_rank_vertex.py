@@ -0,0 +1,357 @@
+# pacman imports
+from pacman.model.decorators import overrides
+from pacman.model.graphs.machine import MachineVertex
+from pacman.model.resources import ResourceContainer
+from pacman.model.resources import CPUCyclesPerTickResource, DTCMResource
+from pacman.model.resources import SDRAMResource
+
+# spinn front end common imports
+from spinn_front_end_common.utilities import constants, helpful_functions
+from spinn_front_end_common.interface.simulation import simulation_utilities
+from spinn_front_end_common.abstract_models.impl \
+    import MachineDataSpecableVertex
+from spinn_front_end_common.abstract_models \
+    import AbstractHasAssociatedBinary, AbstractProvidesNKeysForPartition
+from spinn_front_end_common.utilities.utility_objs import ExecutableStartType
+
+# graph front end imports
+from spinnaker_graph_front_end.abstract_models \
+    import AbstractCheckpointable, AbstractHasTickProfile, \
+    AbstractReductionContributor, AbstractTracesKeys
+from spinnaker_graph_front_end.utilities import key_trace, tick_profile
+from spinnaker_graph_front_end.utilities.reduction_tree \
+    import CONTRIBUTOR_REGION_SIZE, REDUCTION_PARTITION_ID
+from spinnaker_graph_front_end.utilities.streamed_region \
+    import StreamedRegion
+
+# general imports
+from enum import Enum
+import numpy
+import struct
+
+# The scale of the unsigned 1.31 fixed point ranks
+RANK_SCALE = float(1 << 31)
+
+
+def to_u1_31(value):
+    return int(round(value * RANK_SCALE))
+
+
+class PageRankVertex(
+        MachineVertex, MachineDataSpecableVertex, AbstractHasAssociatedBinary,
+        AbstractProvidesNKeysForPartition, AbstractHasTickProfile,
+        AbstractReductionContributor, AbstractCheckpointable,
+        AbstractTracesKeys):
+    """ A core ranking a contiguous slice of the nodes of a graph; the\
+        ranks written at each pause are its checkpoint, so that the ranking\
+        can be carried on by vertices with other slices (see\
+        rebalance_page_rank())
+    """
+
+    PARTITION_ID = "RANK"
+
+    # has key, key, n nodes, damping, teleport, n incoming, n slots,
+    # n expected packets, tolerance
+    PARAMETERS_SIZE = 9 * 4
+
+    # rank and out scale
+    NODE_SIZE = 2 * 4
+
+    # key, mask and slot offset
+    INCOMING_KEYS_SIZE = 3 * 4
+
+    # Estimates of the cost of the binary
+    DTCM_BASE = 8 * 1024
+    CYCLES_BASE = 2000
+    CYCLES_PER_NODE = 100
+    CYCLES_PER_SLOT = 20
+    CYCLES_PER_EDGE = 10
+
+    DATA_REGIONS = Enum(
+        value="DATA_REGIONS",
+        names=[('SYSTEM', 0),
+               ('PARAMETERS', 1),
+               ('NODES', 2),
+               ('INCOMING_KEYS', 3),
+               ('INCOMING_EDGES', 4),
+               ('RANKS', 5),
+               ('REDUCTION', 6),
+               ('TICK_PROFILE', 7),
+               ('KEY_TRACE', 8)])
+
+    def __init__(self, label, graph, slicing, index, damping,
+                 tolerance=None, initial_ranks=None):
+        """
+        :param label: the label of the vertex
+        :param graph: the graph being ranked
+        :type graph: PageRankGraph
+        :param slicing: the slices of the nodes over all the vertices
+        :type slicing: NodeSlicing
+        :param index: the index of the slice of this vertex
+        :param damping: the probability of following an edge, e.g. 0.85
+        :param tolerance: the total change of the ranks of all the nodes in\
+            an iteration below which the ranking is done, or None to run\
+            for as long as asked; each vertex is done when the change of\
+            its ranks is below its share of this, by its number of nodes
+        """
+        MachineVertex.__init__(self, label)
+        self._graph = graph
+        self._slicing = slicing
+        self._index = index
+        self._damping = damping
+        self._tolerance = tolerance
+        self._incoming = None
+        self._reduction_tree = None
+        self._initial_ranks = None
+        if initial_ranks is not None:
+            self._initial_ranks = [to_u1_31(rank) for rank in initial_ranks]
+
+    @property
+    def node_slice(self):
+        return self._slicing.get_slice(self._index)
+
+    @property
+    def n_nodes(self):
+        return self.node_slice.n_atoms
+
+    @property
+    def incoming_vertex_indices(self):
+        """ The indices of the slices with nodes linking to nodes of this\
+            vertex
+        """
+        if self._incoming is None:
+            node_slice = self.node_slice
+            self._incoming = sorted(set(
+                self._slicing.index_of(source)
+                for node in range(node_slice.lo_atom, node_slice.hi_atom + 1)
+                for source in self._graph.predecessors(node)))
+        return self._incoming
+
+    @property
+    def _n_slots(self):
+        return sum(
+            self._slicing.get_slice(index).n_atoms
+            for index in self.incoming_vertex_indices)
+
+    @property
+    def _n_traced(self):
+
+        # the incoming vertices, and the results of the reductions
+        return len(self.incoming_vertex_indices) + 1
+
+    @property
+    def _n_incoming_edges(self):
+        node_slice = self.node_slice
+        return sum(
+            len(self._graph.predecessors(node))
+            for node in range(node_slice.lo_atom, node_slice.hi_atom + 1))
+
+    @property
+    def _incoming_edges_region(self):
+
+        # a count per slot, and a word per edge
+        return StreamedRegion(
+            self.DATA_REGIONS.INCOMING_EDGES.value,
+            (self._n_slots + self._n_incoming_edges) * 4,
+            label="incoming_edges")
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_file_name)
+    def get_binary_file_name(self):
+        return "page_rank.aplx"
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_start_type)
+    def get_binary_start_type(self):
+        return ExecutableStartType.USES_SIMULATION_INTERFACE
+
+    @overrides(AbstractReductionContributor.set_reduction_tree)
+    def set_reduction_tree(self, reduction_tree):
+
+        # the residual is the only value contributed
+        self._reduction_tree = reduction_tree
+
+    @overrides(AbstractProvidesNKeysForPartition.get_n_keys_for_partition)
+    def get_n_keys_for_partition(self, partition, graph_mapper):
+        if partition.identifier == REDUCTION_PARTITION_ID:
+            return self._reduction_tree.n_reductions
+
+        # a key per node for each parity of iteration
+        return 2 * self.n_nodes
+
+    @overrides(MachineDataSpecableVertex.generate_machine_data_specification)
+    def generate_machine_data_specification(
+            self, spec, placement, machine_graph, routing_info, iptags,
+            reverse_iptags, machine_time_step, time_scale_factor):
+        incoming_edges = self._incoming_edges_region
+        incoming = self.incoming_vertex_indices
+        vertices = self._slicing.vertices
+
+        # reserve memory regions
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.SYSTEM.value,
+            size=constants.SYSTEM_BYTES_REQUIREMENT, label='systemInfo')
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.PARAMETERS.value,
+            size=self.PARAMETERS_SIZE, label="parameters")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.NODES.value,
+            size=self.n_nodes * self.NODE_SIZE, label="nodes")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.INCOMING_KEYS.value,
+            size=max(len(incoming) * self.INCOMING_KEYS_SIZE, 4),
+            label="incoming_keys")
+        incoming_edges.reserve_memory_region(spec)
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.RANKS.value,
+            size=self.n_nodes * 4, label="ranks")
+        self._reduction_tree.reserve_contributor_region(
+            spec, self.DATA_REGIONS.REDUCTION.value)
+        tick_profile.reserve_tick_profile_region(
+            spec, self.DATA_REGIONS.TICK_PROFILE.value)
+        key_trace.reserve_key_trace_region(
+            spec, self.DATA_REGIONS.KEY_TRACE.value, self._n_traced)
+
+        # simulation.c requirements
+        spec.switch_write_focus(self.DATA_REGIONS.SYSTEM.value)
+        spec.write_array(simulation_utilities.get_simulation_header_array(
+            self.get_binary_file_name(), machine_time_step,
+            time_scale_factor))
+
+        # the parameters; there is no key if no node has outgoing edges
+        key = routing_info.get_first_key_from_pre_vertex(
+            self, self.PARTITION_ID)
+        n_expected_packets = sum(
+            1 for index in incoming
+            for node in self._slicing.nodes_of(index)
+            if self._graph.out_degree(node) > 0)
+        spec.switch_write_focus(self.DATA_REGIONS.PARAMETERS.value)
+        spec.write_value(0 if key is None else 1)
+        spec.write_value(0 if key is None else key)
+        spec.write_value(self.n_nodes)
+        spec.write_value(to_u1_31(self._damping))
+        spec.write_value(to_u1_31(
+            (1.0 - self._damping) / self._graph.n_nodes))
+        spec.write_value(len(incoming))
+        spec.write_value(self._n_slots)
+        spec.write_value(n_expected_packets)
+        if self._tolerance is None:
+            spec.write_value(0)
+        else:
+            spec.write_value(to_u1_31(
+                self._tolerance * self.n_nodes / self._graph.n_nodes))
+
+        # the initial rank and out scale of each node
+        spec.switch_write_focus(self.DATA_REGIONS.NODES.value)
+        initial_ranks = self._initial_ranks
+        if initial_ranks is None:
+            initial_ranks = [to_u1_31(1.0 / self._graph.n_nodes)] * \
+                self.n_nodes
+        nodes = list()
+        for node, rank in zip(
+                self._slicing.nodes_of(self._index), initial_ranks):
+            out_degree = self._graph.out_degree(node)
+            nodes.append(rank)
+            nodes.append(to_u1_31(1.0 / out_degree) if out_degree else 0)
+        spec.write_array(nodes)
+
+        # the keys of the incoming vertices and the slots of their nodes
+        spec.switch_write_focus(self.DATA_REGIONS.INCOMING_KEYS.value)
+        slot_offset = 0
+        for index in incoming:
+            key_and_mask = routing_info.get_routing_info_from_pre_vertex(
+                vertices[index], self.PARTITION_ID).first_key_and_mask
+            spec.write_value(key_and_mask.key)
+            spec.write_value(key_and_mask.mask)
+            spec.write_value(slot_offset)
+            slot_offset += self._slicing.get_slice(index).n_atoms
+
+        # the nodes of this vertex each incoming node links to, in slot order
+        lo_atom = self.node_slice.lo_atom
+        hi_atom = self.node_slice.hi_atom
+        words = list()
+        for index in incoming:
+            for source in self._slicing.nodes_of(index):
+                targets = [
+                    target - lo_atom
+                    for target in self._graph.successors(source)
+                    if lo_atom <= target <= hi_atom]
+                words.append(len(targets))
+                words.extend(targets)
+        incoming_edges.write(spec, numpy.array(words, dtype="uint32"))
+
+        # the tree summing the residuals
+        self._reduction_tree.write_contributor_region(
+            spec, self.DATA_REGIONS.REDUCTION.value, self, routing_info)
+
+        # the keys of the incoming vertices, to count their packets by
+        key_trace.write_key_trace_region(
+            spec, self.DATA_REGIONS.KEY_TRACE.value, self, machine_graph,
+            routing_info, self._n_traced)
+
+        spec.end_specification()
+
+    @property
+    @overrides(MachineVertex.resources_required)
+    def resources_required(self):
+        n_slots = self._n_slots
+        n_incoming = len(self.incoming_vertex_indices)
+        incoming_edges = self._incoming_edges_region
+        sdram = (
+            constants.SYSTEM_BYTES_REQUIREMENT + self.PARAMETERS_SIZE +
+            self.n_nodes * self.NODE_SIZE +
+            max(n_incoming * self.INCOMING_KEYS_SIZE, 4) +
+            incoming_edges.sdram_size + self.n_nodes * 4 +
+            CONTRIBUTOR_REGION_SIZE + tick_profile.TICK_PROFILE_REGION_SIZE +
+            key_trace.get_key_trace_region_size(self._n_traced))
+        dtcm = (
+            self.DTCM_BASE + self.n_nodes * (self.NODE_SIZE + 4) +
+            n_incoming * self.INCOMING_KEYS_SIZE + n_slots * 2 * 4 +
+            incoming_edges.dtcm_size +
+            key_trace.get_key_trace_region_size(self._n_traced))
+        cycles = (
+            self.CYCLES_BASE + self.n_nodes * self.CYCLES_PER_NODE +
+            n_slots * self.CYCLES_PER_SLOT +
+            self._n_incoming_edges * self.CYCLES_PER_EDGE)
+        return ResourceContainer(
+            sdram=SDRAMResource(sdram), dtcm=DTCMResource(dtcm),
+            cpu_cycles=CPUCyclesPerTickResource(cycles))
+
+    def read_ranks(self, transceiver, placement):
+        """ Read the ranks of the nodes of this vertex at the end of the run
+
+        :return: the ranks, in the order of the nodes
+        :rtype: list of float
+        """
+        address = helpful_functions.locate_memory_region_for_placement(
+            placement, self.DATA_REGIONS.RANKS.value, transceiver)
+        data = transceiver.read_memory(
+            placement.x, placement.y, address, self.n_nodes * 4)
+        return [value / RANK_SCALE for value in struct.unpack(
+            "<{}I".format(self.n_nodes), bytes(data))]
+
+    @property
+    @overrides(AbstractCheckpointable.checkpoint_region_id)
+    def checkpoint_region_id(self):
+        return self.DATA_REGIONS.RANKS.value
+
+    @property
+    @overrides(AbstractCheckpointable.checkpoint_size_in_bytes)
+    def checkpoint_size_in_bytes(self):
+        return self.n_nodes * 4
+
+    @overrides(AbstractCheckpointable.restore_checkpoint)
+    def restore_checkpoint(self, state):
+        self._initial_ranks = list(struct.unpack(
+            "<{}I".format(self.n_nodes), bytes(state)))
+
+    @property
+    @overrides(AbstractHasTickProfile.tick_profile_region_id)
+    def tick_profile_region_id(self):
+        return self.DATA_REGIONS.TICK_PROFILE.value
+
+    @property
+    @overrides(AbstractTracesKeys.key_trace_region_id)
+    def key_trace_region_id(self):
+        return self.DATA_REGIONS.KEY_TRACE.value
+
+    def __repr__(self):
+        return self.label
@@ -0,0 +1,378 @@
+
+//! imports
+#include "spin1_api.h"
+#include "common-typedefs.h"
+#include <data_specification.h>
+#include <simulation.h>
+#include <debug.h>
+#include <tick_profiler.h>
+
+//! the distance of a node not yet reached
+#define UNREACHED UINT32_MAX
+
+//! control value, which says how many timer ticks to run for before exiting
+static uint32_t simulation_ticks = 0;
+static uint32_t time = 0;
+
+//! int as a bool to represent if this simulation should run forever
+static uint32_t infinite_run;
+
+//! human readable definitions of each region in SDRAM
+typedef enum regions_e {
+    SYSTEM_REGION,
+    PARAMETERS,
+    NODES,
+    INCOMING_KEYS,
+    ROW_OFFSETS,
+    EDGES,
+    DISTANCES,
+    TICK_PROFILE
+} regions_e;
+
+//! values for the priority for each callback
+typedef enum callback_priorities{
+    MC_PACKET = -1, SDP = 0, TIMER = 2
+} callback_priorities;
+
+//! the parameters of this core
+typedef struct parameters_t {
+    uint32_t has_key;
+    uint32_t key;
+    uint32_t n_nodes;
+    uint32_t n_incoming;
+    uint32_t n_slots;
+
+    //! the number of cores each packet sent reaches
+    uint32_t n_destinations;
+
+    //! the keys to report the packets sent and received to the monitor with
+    uint32_t report_key;
+
+    //! the key the monitor sends when every core is quiet
+    uint32_t stop_key;
+} parameters_t;
+
+//! a node of this core: its distance from the source, and whether it links
+//! to any node, and so has its distance sent when it changes
+typedef struct node_t {
+    uint32_t distance;
+    uint32_t has_successors;
+} node_t;
+
+//! the keys of a vertex with nodes linking to nodes of this core, and the
+//! slot of its first node
+typedef struct incoming_keys_t {
+    uint32_t key;
+    uint32_t mask;
+    uint32_t slot_offset;
+} incoming_keys_t;
+
+//! an edge from an incoming node to a node of this core
+typedef struct edge_t {
+    uint32_t target;
+    uint32_t weight;
+} edge_t;
+
+static parameters_t parameters;
+static node_t *nodes;
+static incoming_keys_t *incoming_keys;
+
+//! the edges of each slot are edges[row_offsets[slot]:row_offsets[slot + 1]]
+//! in SDRAM; the rows read are few and short, so they are read directly
+//! rather than by DMA
+static uint32_t *row_offsets;
+static edge_t *edges;
+
+//! the shortest distance received from each incoming node
+static uint32_t *received_distances;
+
+//! the slots whose distance has dropped since they were last relaxed
+static uint32_t *dirty_slots;
+static uint8_t *slot_is_dirty;
+static volatile uint32_t n_dirty_slots = 0;
+
+//! the nodes whose distance has dropped since they were last sent
+static uint32_t *frontier;
+static uint8_t *node_in_frontier;
+static uint32_t n_frontier = 0;
+
+//! the number of packets sent, counting each core reached, and received
+static uint32_t n_sent = 0;
+static volatile uint32_t n_received = 0;
+
+//! set when the monitor finds every core quiet
+static volatile bool stop_requested = false;
+
+//! where the distances are written for the host
+static address_t distances_region;
+
+//! \brief Store a distance of an incoming node if it is shorter than any
+//!     received before, to be relaxed in the next timer tick
+//! \param[in] key: the key of the node
+//! \param[in] payload: the distance of the node
+void receive_data(uint key, uint payload) {
+    if (key == parameters.stop_key) {
+        stop_requested = true;
+        return;
+    }
+    n_received += 1;
+    for (uint32_t i = 0; i < parameters.n_incoming; i++) {
+        incoming_keys_t *incoming = &incoming_keys[i];
+        if ((key & incoming->mask) == incoming->key) {
+            uint32_t slot = incoming->slot_offset + (key & ~incoming->mask);
+            if (slot < parameters.n_slots &&
+                    payload < received_distances[slot]) {
+                received_distances[slot] = payload;
+                if (!slot_is_dirty[slot]) {
+                    slot_is_dirty[slot] = 1;
+                    dirty_slots[n_dirty_slots++] = slot;
+                }
+            }
+            return;
+        }
+    }
+    log_debug("received unexpected key 0x%08x", key);
+}
+
+//! \brief Add a node to the frontier if it is not already in it
+static inline void add_to_frontier(uint32_t node) {
+    if (!node_in_frontier[node] && nodes[node].has_successors) {
+        node_in_frontier[node] = 1;
+        frontier[n_frontier++] = node;
+    }
+}
+
+//! \brief Relax the edges from the incoming nodes whose distance dropped;
+//!     only the edges of those nodes are touched
+static void relax_dirty_slots(void) {
+    while (true) {
+        uint cpsr = spin1_int_disable();
+        if (n_dirty_slots == 0) {
+            spin1_mode_restore(cpsr);
+            return;
+        }
+        uint32_t slot = dirty_slots[--n_dirty_slots];
+        uint32_t distance = received_distances[slot];
+        slot_is_dirty[slot] = 0;
+        spin1_mode_restore(cpsr);
+
+        for (uint32_t i = row_offsets[slot]; i < row_offsets[slot + 1]; i++) {
+            uint32_t target = edges[i].target;
+            uint32_t new_distance = distance + edges[i].weight;
+            if (new_distance < distance) {
+                new_distance = UNREACHED;
+            }
+            if (new_distance < nodes[target].distance) {
+                nodes[target].distance = new_distance;
+                add_to_frontier(target);
+            }
+        }
+    }
+}
+
+//! \brief Send the distances of the nodes in the frontier, emptying it
+static void send_frontier(void) {
+    for (uint32_t i = 0; i < n_frontier; i++) {
+        uint32_t node = frontier[i];
+        node_in_frontier[node] = 0;
+        if (parameters.has_key) {
+            while (!spin1_send_mc_packet(
+                    parameters.key + node, nodes[node].distance,
+                    WITH_PAYLOAD)) {
+                spin1_delay_us(1);
+            }
+            n_sent += parameters.n_destinations;
+        }
+    }
+    n_frontier = 0;
+}
+
+//! \brief Tell the monitor how many packets this core has sent and received
+static void send_report(void) {
+    while (!spin1_send_mc_packet(
+            parameters.report_key, n_sent, WITH_PAYLOAD)) {
+        spin1_delay_us(1);
+    }
+    while (!spin1_send_mc_packet(
+            parameters.report_key + 1, n_received, WITH_PAYLOAD)) {
+        spin1_delay_us(1);
+    }
+}
+
+//! \brief Write the distances to SDRAM for the host
+static void write_distances(void) {
+    for (uint32_t i = 0; i < parameters.n_nodes; i++) {
+        distances_region[i] = nodes[i].distance;
+    }
+}
+
+/****f* sssp.c/update
+ *
+ * SUMMARY
+ *  Each timer tick, relaxes the edges from nodes whose distance has dropped
+ *  and sends the distances of the nodes of this core which have dropped
+ *
+ * SYNOPSIS
+ *  void update (uint ticks, uint b)
+ *
+ * SOURCE
+ */
+void update(uint ticks, uint b) {
+    use(b);
+    use(ticks);
+
+    time++;
+
+    // every core is quiet, so the distances are final
+    if (stop_requested) {
+        log_info("Quiescent after %d ticks", time);
+        write_distances();
+        spin1_callback_off(TIMER_TICK);
+        simulation_exit();
+        return;
+    }
+
+    // check that the run time hasn't already elapsed and thus needs to be
+    // killed
+    if ((infinite_run != TRUE) && (time >= simulation_ticks)) {
+        log_info("Simulation complete.\n");
+        write_distances();
+
+        // falls into the pause resume mode of operating
+        simulation_handle_pause_resume(NULL);
+
+        // do this tick again when resumed, so the search carries on
+        time -= 1;
+        return;
+    }
+
+    tick_profiler_start_tick();
+    relax_dirty_slots();
+    send_frontier();
+    send_report();
+    tick_profiler_end_tick();
+}
+
+static bool initialize(uint32_t *timer_period) {
+    log_info("Initialise: started\n");
+
+    // Get the address this core's DTCM data starts at from SRAM
+    address_t address = data_specification_get_data_address();
+
+    // Read the header
+    if (!data_specification_read_header(address)) {
+        log_error("failed to read the data spec header");
+        return false;
+    }
+
+    // Get the timing details and set up the simulation interface
+    if (!simulation_initialise(
+            data_specification_get_region(SYSTEM_REGION, address),
+            APPLICATION_NAME_HASH, timer_period, &simulation_ticks,
+            &infinite_run, SDP, 0)) {
+        return false;
+    }
+
+    spin1_memcpy(
+        &parameters, data_specification_get_region(PARAMETERS, address),
+        sizeof(parameters));
+    log_info("%d nodes, %d incoming vertices, %d slots",
+             parameters.n_nodes, parameters.n_incoming, parameters.n_slots);
+
+    // the distances are read and written as packets arrive, so are kept in
+    // DTCM
+    uint32_t nodes_size = parameters.n_nodes * sizeof(node_t);
+    nodes = spin1_malloc(nodes_size);
+    frontier = spin1_malloc(parameters.n_nodes * sizeof(uint32_t));
+    node_in_frontier = spin1_malloc(parameters.n_nodes);
+    if (nodes == NULL || frontier == NULL || node_in_frontier == NULL) {
+        log_error("Could not allocate the nodes");
+        return false;
+    }
+    spin1_memcpy(
+        nodes, data_specification_get_region(NODES, address), nodes_size);
+
+    uint32_t incoming_size = parameters.n_incoming * sizeof(incoming_keys_t);
+    incoming_keys = spin1_malloc(incoming_size);
+    uint32_t row_offsets_size = (parameters.n_slots + 1) * sizeof(uint32_t);
+    row_offsets = spin1_malloc(row_offsets_size);
+    received_distances = spin1_malloc(parameters.n_slots * sizeof(uint32_t));
+    dirty_slots = spin1_malloc(parameters.n_slots * sizeof(uint32_t));
+    slot_is_dirty = spin1_malloc(parameters.n_slots);
+    if (row_offsets == NULL || (parameters.n_slots > 0 && (
+            incoming_keys == NULL || received_distances == NULL ||
+            dirty_slots == NULL || slot_is_dirty == NULL))) {
+        log_error("Could not allocate the incoming nodes");
+        return false;
+    }
+    spin1_memcpy(
+        incoming_keys, data_specification_get_region(INCOMING_KEYS, address),
+        incoming_size);
+    spin1_memcpy(
+        row_offsets, data_specification_get_region(ROW_OFFSETS, address),
+        row_offsets_size);
+    edges = (edge_t *) data_specification_get_region(EDGES, address);
+
+    for (uint32_t i = 0; i < parameters.n_slots; i++) {
+        received_distances[i] = UNREACHED;
+        slot_is_dirty[i] = 0;
+    }
+
+    // the source starts the frontier
+    for (uint32_t i = 0; i < parameters.n_nodes; i++) {
+        node_in_frontier[i] = 0;
+        if (nodes[i].distance != UNREACHED) {
+            add_to_frontier(i);
+        }
+    }
+
+    distances_region = data_specification_get_region(DISTANCES, address);
+    write_distances();
+
+    tick_profiler_initialise(
+        data_specification_get_region(TICK_PROFILE, address));
+    tick_profiler_record_dtcm_usage();
+
+    return true;
+}
+
+/****f* sssp.c/c_main
+ *
+ * SUMMARY
+ *  This function is called at application start-up.
+ *  It is used to register event callbacks and begin the simulation.
+ *
+ * SYNOPSIS
+ *  int c_main()
+ *
+ * SOURCE
+ */
+void c_main() {
+    log_info("starting shortest paths\n");
+
+    // Load DTCM data
+    uint32_t timer_period;
+
+    // initialise the model
+    if (!initialize(&timer_period)) {
+        log_error("Error in initialisation - exiting!");
+        rt_error(RTE_SWERR);
+    }
+
+    // set timer tick value to configured value
+    log_info("setting timer to execute every %d microseconds", timer_period);
+    spin1_set_timer_tick(timer_period);
+
+    // register callbacks
+    spin1_callback_on(MCPL_PACKET_RECEIVED, receive_data, MC_PACKET);
+    spin1_callback_on(MC_PACKET_RECEIVED, receive_data, MC_PACKET);
+    spin1_callback_on(TIMER_TICK, update, TIMER);
+
+    // start execution
+    log_info("Starting\n");
+
+    // Start the time at "-1" so that the first tick will be 0
+    time = UINT32_MAX;
+
+    simulation_run();
+}
@@ -0,0 +1,44 @@
+import spinnaker_graph_front_end as front_end
+
+from spinnaker_graph_front_end.examples.sssp.sssp_graph import WeightedGraph
+from spinnaker_graph_front_end.examples.sssp.sssp_builder \
+    import add_sssp_graph, get_distances, get_result
+from spinnaker_graph_front_end.examples.sssp.sssp_reference \
+    import shortest_paths
+
+import os
+import sys
+
+N_NODES = 2000
+N_EDGES = 6000
+MAX_WEIGHT = 10
+NODES_PER_CORE = 200
+SOURCE = 0
+
+# search a graph read from an edge list if given one, or a random graph
+if len(sys.argv) > 1:
+    graph = WeightedGraph.from_edge_list(sys.argv[1])
+else:
+    graph = WeightedGraph.random(N_NODES, N_EDGES, MAX_WEIGHT, seed=1)
+print "searching {} nodes with {} edges from {}".format(
+    graph.n_nodes, graph.n_edges, graph.node_name(SOURCE))
+
+front_end.setup(model_binary_folder=os.path.dirname(__file__))
+vertices, monitor = add_sssp_graph(graph, SOURCE, NODES_PER_CORE)
+
+# runs until the monitor finds that no core has anything left to send
+front_end.run_until_complete()
+
+distances = get_distances(vertices)
+result = get_result(monitor)
+front_end.stop()
+
+print "finished after {} ticks and {} packets".format(
+    result.n_ticks, result.n_packets)
+expected = shortest_paths(graph, SOURCE)
+n_wrong = sum(
+    1 for distance, expected_distance in zip(distances, expected)
+    if distance != expected_distance)
+print "{} of {} nodes reached; {} distances differ from the host".format(
+    sum(1 for distance in distances if distance is not None),
+    graph.n_nodes, n_wrong)
@@ -0,0 +1,71 @@
+from pacman.model.graphs.machine import MachineEdge
+
+import spinnaker_graph_front_end as front_end
+from spinnaker_graph_front_end.utilities.node_slicing import NodeSlicing
+from spinnaker_graph_front_end.examples.sssp.sssp_vertex import SSSPVertex
+from spinnaker_graph_front_end.examples.sssp.sssp_monitor_vertex \
+    import SSSPMonitorVertex
+
+
+def add_sssp_graph(graph, source, nodes_per_core=256):
+    """ Add the vertices and edges to find the distances of the nodes of a\
+        graph from a source to the front end; the nodes are split into\
+        contiguous slices, each searched by one core, with one more core\
+        to stop the search when every core is quiet
+
+    :param graph: the graph to search
+    :type graph: WeightedGraph
+    :param source: the number of the node to search from
+    :param nodes_per_core: the maximum number of nodes to search on a core
+    :return: the vertices, in the order of their nodes, and the monitor
+    :rtype: (list of SSSPVertex, SSSPMonitorVertex)
+    """
+    slicing = NodeSlicing(graph.n_nodes, nodes_per_core)
+    for index in range(slicing.n_slices):
+        vertex = SSSPVertex(
+            "sssp{}".format(index), graph, slicing, index, source)
+        slicing.vertices.append(vertex)
+        front_end.add_machine_vertex_instance(vertex)
+    vertices = slicing.vertices
+    monitor = SSSPMonitorVertex("sssp_monitor", vertices)
+    front_end.add_machine_vertex_instance(monitor)
+
+    # an edge from each vertex with nodes linking to nodes of another
+    for vertex in vertices:
+        for index in vertex.incoming_vertex_indices:
+            front_end.add_machine_edge_instance(
+                MachineEdge(vertices[index], vertex),
+                SSSPVertex.PARTITION_ID)
+
+    # the reports to the monitor, and the monitor telling them to stop
+    for vertex in vertices:
+        vertex.monitor = monitor
+        front_end.add_machine_edge_instance(
+            MachineEdge(vertex, monitor), SSSPVertex.REPORT_PARTITION_ID)
+        front_end.add_machine_edge_instance(
+            MachineEdge(monitor, vertex), SSSPMonitorVertex.PARTITION_ID)
+    return vertices, monitor
+
+
+def get_distances(vertices):
+    """ Read the distances of all the nodes at the end of a search
+
+    :return: the distance of each node, or None for those not reached
+    :rtype: list of int
+    """
+    distances = list()
+    for vertex in vertices:
+        distances.extend(vertex.read_distances(
+            front_end.transceiver(),
+            front_end.placements().get_placement_of_vertex(vertex)))
+    return distances
+
+
+def get_result(monitor):
+    """ Read what the monitor of a search found
+
+    :rtype: SSSPResult
+    """
+    return monitor.read_result(
+        front_end.transceiver(),
+        front_end.placements().get_placement_of_vertex(monitor))
@@ -0,0 +1,110 @@
+import random
+
+
+class WeightedGraph(object):
+    """ A directed graph with a non-negative integer weight on each edge,\
+        held as adjacency lists over nodes numbered from 0
+    """
+
+    __slots__ = [
+        # The names of the nodes, by number
+        "_node_names",
+
+        # The (node, weight) of the edges from each node, by number
+        "_successors",
+
+        # The nodes linking to each node, by number
+        "_predecessors"
+    ]
+
+    def __init__(self, n_nodes, edges, node_names=None):
+        """
+        :param n_nodes: the number of nodes
+        :param edges: iterable of (source, target, weight); of repeated\
+            edges, the lightest is kept
+        :param node_names: the names of the nodes, by number
+        """
+        self._node_names = node_names
+        successors = [dict() for _ in range(n_nodes)]
+        for source, target, weight in edges:
+            if weight < 0:
+                raise ValueError("Negative weight on edge {}->{}".format(
+                    source, target))
+            if weight < successors[source].get(target, weight + 1):
+                successors[source][target] = weight
+        self._successors = [
+            sorted(targets.items()) for targets in successors]
+        self._predecessors = [list() for _ in range(n_nodes)]
+        for source, targets in enumerate(self._successors):
+            for target, _ in targets:
+                self._predecessors[target].append(source)
+
+    @staticmethod
+    def from_edge_list(path):
+        """ Load a graph from a file of edges, one "source target [weight]"\
+            per line, weights defaulting to 1; blank lines and lines\
+            starting with # are skipped.  Nodes are numbered in the order\
+            they first appear.
+
+        :param path: the path of the file
+        :rtype: :py:class:`WeightedGraph`
+        """
+        numbers = dict()
+        names = list()
+        edges = list()
+        with open(path) as f:
+            for line in f:
+                line = line.strip()
+                if not line or line.startswith("#"):
+                    continue
+                fields = line.split()
+                if len(fields) < 2:
+                    raise ValueError("Not an edge: {}".format(line))
+                ends = list()
+                for name in fields[:2]:
+                    if name not in numbers:
+                        numbers[name] = len(names)
+                        names.append(name)
+                    ends.append(numbers[name])
+                weight = int(fields[2]) if len(fields) > 2 else 1
+                edges.append((ends[0], ends[1], weight))
+        return WeightedGraph(len(names), edges, names)
+
+    @staticmethod
+    def random(n_nodes, n_edges, max_weight=1, seed=None):
+        """ Make a graph with edges between random pairs of distinct nodes,\
+            with weights from 1 to max_weight; with the default of 1, a\
+            shortest path search is a breadth first search
+        """
+        rng = random.Random(seed)
+        edges = list()
+        while len(edges) < n_edges:
+            source = rng.randrange(n_nodes)
+            target = rng.randrange(n_nodes)
+            if source != target:
+                edges.append((source, target, rng.randint(1, max_weight)))
+        return WeightedGraph(n_nodes, edges)
+
+    @property
+    def n_nodes(self):
+        return len(self._successors)
+
+    @property
+    def n_edges(self):
+        return sum(len(targets) for targets in self._successors)
+
+    def node_name(self, node):
+        if self._node_names is None:
+            return str(node)
+        return self._node_names[node]
+
+    def successors(self, node):
+        """ The (target, weight) of each edge from a node
+        """
+        return self._successors[node]
+
+    def predecessors(self, node):
+        return self._predecessors[node]
+
+    def out_degree(self, node):
+        return len(self._successors[node])
@@ -0,0 +1,263 @@
+
+//! imports
+#include "spin1_api.h"
+#include "common-typedefs.h"
+#include <data_specification.h>
+#include <simulation.h>
+#include <debug.h>
+
+//! the number of successive checks which must find every core quiet before
+//! the search is stopped
+#define N_QUIET_CHECKS 2
+
+//! control value, which says how many timer ticks to run for before exiting
+static uint32_t simulation_ticks = 0;
+static uint32_t time = 0;
+
+//! int as a bool to represent if this simulation should run forever
+static uint32_t infinite_run;
+
+//! human readable definitions of each region in SDRAM
+typedef enum regions_e {
+    SYSTEM_REGION,
+    PARAMETERS,
+    REPORT_KEYS,
+    RESULT
+} regions_e;
+
+//! values for the priority for each callback
+typedef enum callback_priorities{
+    MC_PACKET = -1, SDP = 0, TIMER = 2
+} callback_priorities;
+
+//! the parameters of the monitor
+typedef struct parameters_t {
+    uint32_t stop_key;
+    uint32_t n_cores;
+} parameters_t;
+
+//! the keys a core reports with; the packets sent is reported with the
+//! key, and the packets received with the key + 1
+typedef struct report_keys_t {
+    uint32_t key;
+    uint32_t mask;
+} report_keys_t;
+
+//! the latest report of a core
+typedef struct report_t {
+    uint32_t n_sent;
+    uint32_t n_received;
+
+    //! whether the core has reported since the last check
+    uint32_t fresh;
+} report_t;
+
+//! what the host reads back
+typedef struct result_t {
+    uint32_t quiescent;
+    uint32_t n_ticks;
+    uint32_t n_packets;
+} result_t;
+
+static parameters_t parameters;
+static report_keys_t *report_keys;
+static report_t *reports;
+static result_t *result;
+
+//! the totals found by the last check, and the number of quiet checks in a
+//! row
+static uint32_t last_sent = UINT32_MAX;
+static uint32_t last_received = 0;
+static uint32_t n_quiet_checks = 0;
+
+static bool stopping = false;
+
+//! \brief Store the report of a core
+//! \param[in] key: the report key of the core, + 1 for packets received
+//! \param[in] payload: the number of packets
+void receive_data(uint key, uint payload) {
+    for (uint32_t i = 0; i < parameters.n_cores; i++) {
+        if ((key & report_keys[i].mask) == report_keys[i].key) {
+            if (key & 1) {
+                reports[i].n_received = payload;
+                reports[i].fresh = 1;
+            } else {
+                reports[i].n_sent = payload;
+            }
+            return;
+        }
+    }
+    log_debug("received unexpected key 0x%08x", key);
+}
+
+//! \brief Check whether every core is quiet: every packet sent has been
+//!     received, and no core has sent or received anything since the last
+//!     check.  Every core must have reported since the last check, so that
+//!     any node changed by a packet counted in the last check has been sent
+//!     and counted by now.
+//! \return true if every core has been quiet for long enough to stop
+static bool check_quiescence(void) {
+    uint32_t total_sent = 0;
+    uint32_t total_received = 0;
+    uint cpsr = spin1_int_disable();
+    for (uint32_t i = 0; i < parameters.n_cores; i++) {
+        if (!reports[i].fresh) {
+            spin1_mode_restore(cpsr);
+            return false;
+        }
+    }
+    for (uint32_t i = 0; i < parameters.n_cores; i++) {
+        total_sent += reports[i].n_sent;
+        total_received += reports[i].n_received;
+        reports[i].fresh = 0;
+    }
+    spin1_mode_restore(cpsr);
+
+    if (total_sent == total_received && total_sent == last_sent &&
+            total_received == last_received) {
+        n_quiet_checks += 1;
+    } else {
+        n_quiet_checks = 0;
+    }
+    last_sent = total_sent;
+    last_received = total_received;
+    result->n_packets = total_sent;
+    return n_quiet_checks >= N_QUIET_CHECKS;
+}
+
+/****f* sssp_monitor.c/update
+ *
+ * SUMMARY
+ *  Checks each timer tick whether every core is quiet, and if so tells them
+ *  all to stop
+ *
+ * SYNOPSIS
+ *  void update (uint ticks, uint b)
+ *
+ * SOURCE
+ */
+void update(uint ticks, uint b) {
+    use(b);
+    use(ticks);
+
+    time++;
+
+    if (stopping) {
+        spin1_callback_off(TIMER_TICK);
+        simulation_exit();
+        return;
+    }
+
+    // check that the run time hasn't already elapsed and thus needs to be
+    // killed
+    if ((infinite_run != TRUE) && (time >= simulation_ticks)) {
+        log_info("Simulation complete.\n");
+        result->n_ticks = time;
+
+        // falls into the pause resume mode of operating
+        simulation_handle_pause_resume(NULL);
+
+        // do this tick again when resumed, so the checks carry on
+        time -= 1;
+        return;
+    }
+
+    if (check_quiescence()) {
+        log_info("Every core quiet at tick %d after %d packets", time,
+                 result->n_packets);
+        result->quiescent = 1;
+        result->n_ticks = time;
+        while (!spin1_send_mc_packet(parameters.stop_key, 0, NO_PAYLOAD)) {
+            spin1_delay_us(1);
+        }
+        stopping = true;
+    }
+}
+
+static bool initialize(uint32_t *timer_period) {
+    log_info("Initialise: started\n");
+
+    // Get the address this core's DTCM data starts at from SRAM
+    address_t address = data_specification_get_data_address();
+
+    // Read the header
+    if (!data_specification_read_header(address)) {
+        log_error("failed to read the data spec header");
+        return false;
+    }
+
+    // Get the timing details and set up the simulation interface
+    if (!simulation_initialise(
+            data_specification_get_region(SYSTEM_REGION, address),
+            APPLICATION_NAME_HASH, timer_period, &simulation_ticks,
+            &infinite_run, SDP, 0)) {
+        return false;
+    }
+
+    spin1_memcpy(
+        &parameters, data_specification_get_region(PARAMETERS, address),
+        sizeof(parameters));
+
+    uint32_t report_keys_size = parameters.n_cores * sizeof(report_keys_t);
+    report_keys = spin1_malloc(report_keys_size);
+    reports = spin1_malloc(parameters.n_cores * sizeof(report_t));
+    if (report_keys == NULL || reports == NULL) {
+        log_error("Could not allocate the reports");
+        return false;
+    }
+    spin1_memcpy(
+        report_keys, data_specification_get_region(REPORT_KEYS, address),
+        report_keys_size);
+    for (uint32_t i = 0; i < parameters.n_cores; i++) {
+        reports[i].n_sent = 0;
+        reports[i].n_received = 0;
+        reports[i].fresh = 0;
+    }
+
+    result = (result_t *) data_specification_get_region(RESULT, address);
+    result->quiescent = 0;
+    result->n_ticks = 0;
+    result->n_packets = 0;
+
+    return true;
+}
+
+/****f* sssp_monitor.c/c_main
+ *
+ * SUMMARY
+ *  This function is called at application start-up.
+ *  It is used to register event callbacks and begin the simulation.
+ *
+ * SYNOPSIS
+ *  int c_main()
+ *
+ * SOURCE
+ */
+void c_main() {
+    log_info("starting shortest paths monitor\n");
+
+    // Load DTCM data
+    uint32_t timer_period;
+
+    // initialise the model
+    if (!initialize(&timer_period)) {
+        log_error("Error in initialisation - exiting!");
+        rt_error(RTE_SWERR);
+    }
+
+    // set timer tick value to configured value
+    log_info("setting timer to execute every %d microseconds", timer_period);
+    spin1_set_timer_tick(timer_period);
+
+    // register callbacks
+    spin1_callback_on(MCPL_PACKET_RECEIVED, receive_data, MC_PACKET);
+    spin1_callback_on(TIMER_TICK, update, TIMER);
+
+    // start execution
+    log_info("Starting\n");
+
+    // Start the time at "-1" so that the first tick will be 0
+    time = UINT32_MAX;
+
+    simulation_run();
+}
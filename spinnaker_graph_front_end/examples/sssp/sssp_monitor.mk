@@ -0,0 +1,23 @@
+# If SPINN_DIRS is not defined, this is an error!
+ifndef SPINN_DIRS
+    $(error SPINN_DIRS is not set.  Please define SPINN_DIRS (possibly by running "source setup" in the spinnaker package folder))
+endif
+
+APP = sssp_monitor
+BUILD_DIR = build/sssp_monitor/
+SOURCES = sssp_monitor.c
+
+MAKEFILE_PATH := $(abspath $(lastword $(MAKEFILE_LIST)))
+CURRENT_DIR := $(dir $(MAKEFILE_PATH))
+SOURCE_DIR := $(abspath $(CURRENT_DIR))
+SOURCE_DIRS += $(SOURCE_DIR)
+APP_OUTPUT_DIR := $(abspath $(CURRENT_DIR))/
+
+# The graph front end runtime headers
+GFE_C_COMMON_DIR := $(abspath $(CURRENT_DIR)/../../c_common)
+CFLAGS += -I $(GFE_C_COMMON_DIR)/include
+
+# Build with TOKEN_LOGGING=1 to log tokens rather than text
+include $(GFE_C_COMMON_DIR)/Makefile.token_log
+
+include $(SPINN_DIRS)/make/Makefile.SpiNNFrontEndCommon
@@ -0,0 +1,174 @@
+# pacman imports
+from pacman.model.decorators import overrides
+from pacman.model.graphs.machine import MachineVertex
+from pacman.model.resources import ResourceContainer
+from pacman.model.resources import CPUCyclesPerTickResource, DTCMResource
+from pacman.model.resources import SDRAMResource
+
+# spinn front end common imports
+from spinn_front_end_common.utilities import constants, helpful_functions
+from spinn_front_end_common.interface.simulation import simulation_utilities
+from spinn_front_end_common.abstract_models.impl \
+    import MachineDataSpecableVertex
+from spinn_front_end_common.abstract_models import AbstractHasAssociatedBinary
+from spinn_front_end_common.utilities.utility_objs import ExecutableStartType
+
+# general imports
+from enum import Enum
+import struct
+
+
+class SSSPResult(object):
+    """ What the monitor of a search found
+    """
+
+    __slots__ = [
+        # True if every core went quiet before the run time ran out
+        "_quiescent",
+
+        # The tick at which every core was found quiet, or the run ended
+        "_n_ticks",
+
+        # The packets sent by the search, counting each core reached
+        "_n_packets"
+    ]
+
+    def __init__(self, quiescent, n_ticks, n_packets):
+        self._quiescent = quiescent
+        self._n_ticks = n_ticks
+        self._n_packets = n_packets
+
+    @property
+    def quiescent(self):
+        return self._quiescent
+
+    @property
+    def n_ticks(self):
+        return self._n_ticks
+
+    @property
+    def n_packets(self):
+        return self._n_packets
+
+
+class SSSPMonitorVertex(
+        MachineVertex, MachineDataSpecableVertex,
+        AbstractHasAssociatedBinary):
+    """ A core which detects when no core of a search has anything left to\
+        send, by counting the packets they report sending and receiving\
+        every tick, and then tells them all to stop so that\
+        run_until_complete() returns.  A lost packet is never counted as\
+        received, so a search which loses packets only stops at the end of\
+        its run time.
+    """
+
+    # The packet telling every core to stop
+    PARTITION_ID = "STOP"
+
+    # stop key, n cores
+    PARAMETERS_SIZE = 2 * 4
+
+    # key and mask
+    REPORT_KEYS_SIZE = 2 * 4
+
+    # quiescent, n ticks, n packets
+    RESULT_SIZE = 3 * 4
+
+    # Estimates of the cost of the binary
+    DTCM_BASE = 4 * 1024
+    CYCLES_BASE = 500
+    CYCLES_PER_CORE = 50
+
+    DATA_REGIONS = Enum(
+        value="DATA_REGIONS",
+        names=[('SYSTEM', 0),
+               ('PARAMETERS', 1),
+               ('REPORT_KEYS', 2),
+               ('RESULT', 3)])
+
+    def __init__(self, label, vertices):
+        """
+        :param label: the label of the vertex
+        :param vertices: the vertices of the search to monitor
+        :type vertices: list of SSSPVertex
+        """
+        MachineVertex.__init__(self, label)
+        self._vertices = vertices
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_file_name)
+    def get_binary_file_name(self):
+        return "sssp_monitor.aplx"
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_start_type)
+    def get_binary_start_type(self):
+        return ExecutableStartType.USES_SIMULATION_INTERFACE
+
+    @overrides(MachineDataSpecableVertex.generate_machine_data_specification)
+    def generate_machine_data_specification(
+            self, spec, placement, machine_graph, routing_info, iptags,
+            reverse_iptags, machine_time_step, time_scale_factor):
+
+        # reserve memory regions
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.SYSTEM.value,
+            size=constants.SYSTEM_BYTES_REQUIREMENT, label='systemInfo')
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.PARAMETERS.value,
+            size=self.PARAMETERS_SIZE, label="parameters")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.REPORT_KEYS.value,
+            size=len(self._vertices) * self.REPORT_KEYS_SIZE,
+            label="report_keys")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.RESULT.value,
+            size=self.RESULT_SIZE, label="result")
+
+        # simulation.c requirements
+        spec.switch_write_focus(self.DATA_REGIONS.SYSTEM.value)
+        spec.write_array(simulation_utilities.get_simulation_header_array(
+            self.get_binary_file_name(), machine_time_step,
+            time_scale_factor))
+
+        spec.switch_write_focus(self.DATA_REGIONS.PARAMETERS.value)
+        spec.write_value(routing_info.get_first_key_from_pre_vertex(
+            self, self.PARTITION_ID))
+        spec.write_value(len(self._vertices))
+
+        spec.switch_write_focus(self.DATA_REGIONS.REPORT_KEYS.value)
+        for vertex in self._vertices:
+            key_and_mask = routing_info.get_routing_info_from_pre_vertex(
+                vertex, vertex.REPORT_PARTITION_ID).first_key_and_mask
+            spec.write_value(key_and_mask.key)
+            spec.write_value(key_and_mask.mask)
+
+        spec.end_specification()
+
+    @property
+    @overrides(MachineVertex.resources_required)
+    def resources_required(self):
+        n_cores = len(self._vertices)
+        sdram = (
+            constants.SYSTEM_BYTES_REQUIREMENT + self.PARAMETERS_SIZE +
+            n_cores * self.REPORT_KEYS_SIZE + self.RESULT_SIZE)
+
+        # the keys and latest report of each core
+        dtcm = self.DTCM_BASE + n_cores * (self.REPORT_KEYS_SIZE + 3 * 4)
+        cycles = self.CYCLES_BASE + n_cores * self.CYCLES_PER_CORE
+        return ResourceContainer(
+            sdram=SDRAMResource(sdram), dtcm=DTCMResource(dtcm),
+            cpu_cycles=CPUCyclesPerTickResource(cycles))
+
+    def read_result(self, transceiver, placement):
+        """ Read what the monitor found
+
+        :rtype: :py:class:`SSSPResult`
+        """
+        address = helpful_functions.locate_memory_region_for_placement(
+            placement, self.DATA_REGIONS.RESULT.value, transceiver)
+        data = transceiver.read_memory(
+            placement.x, placement.y, address, self.RESULT_SIZE)
+        quiescent, n_ticks, n_packets = struct.unpack("<3I", bytes(data))
+        return SSSPResult(bool(quiescent), n_ticks, n_packets)
+
+    def __repr__(self):
+        return self.label
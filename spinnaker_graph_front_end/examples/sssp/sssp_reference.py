@@ -0,0 +1,28 @@
+""" A host implementation of the search run on the machine, to check its\
+    results against
+"""
+import heapq
+
+
+def shortest_paths(graph, source):
+    """ Find the distance of each node from a source by Dijkstra's algorithm
+
+    :param graph: the graph to search
+    :type graph: WeightedGraph
+    :param source: the number of the node to search from
+    :return: the distance of each node, or None for those not reachable
+    :rtype: list of int
+    """
+    distances = [None] * graph.n_nodes
+    distances[source] = 0
+    queue = [(0, source)]
+    while queue:
+        distance, node = heapq.heappop(queue)
+        if distance > distances[node]:
+            continue
+        for target, weight in graph.successors(node):
+            new_distance = distance + weight
+            if distances[target] is None or new_distance < distances[target]:
+                distances[target] = new_distance
+                heapq.heappush(queue, (new_distance, target))
+    return distances
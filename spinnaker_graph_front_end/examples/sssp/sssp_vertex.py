@@ -0,0 +1,305 @@
+# pacman imports
+from pacman.model.decorators import overrides
+from pacman.model.graphs.machine import MachineVertex
+from pacman.model.resources import ResourceContainer
+from pacman.model.resources import CPUCyclesPerTickResource, DTCMResource
+from pacman.model.resources import SDRAMResource
+
+# spinn front end common imports
+from spinn_front_end_common.utilities import constants, helpful_functions
+from spinn_front_end_common.interface.simulation import simulation_utilities
+from spinn_front_end_common.abstract_models.impl \
+    import MachineDataSpecableVertex
+from spinn_front_end_common.abstract_models \
+    import AbstractHasAssociatedBinary, AbstractProvidesNKeysForPartition
+from spinn_front_end_common.utilities.utility_objs import ExecutableStartType
+
+# graph front end imports
+from spinnaker_graph_front_end.abstract_models import AbstractHasTickProfile
+from spinnaker_graph_front_end.utilities import tick_profile
+
+# general imports
+from enum import Enum
+import struct
+
+# The distance of a node not reached from the source
+UNREACHED = 0xFFFFFFFF
+
+
+class SSSPVertex(
+        MachineVertex, MachineDataSpecableVertex, AbstractHasAssociatedBinary,
+        AbstractProvidesNKeysForPartition, AbstractHasTickProfile):
+    """ A core finding the distance from a source of a contiguous slice of\
+        the nodes of a graph.  Only the distances which drop are sent, so\
+        the packets sent scale with the edges touched by the search.
+    """
+
+    # The distances of the nodes
+    PARTITION_ID = "DISTANCE"
+
+    # The packets sent and received, to the monitor
+    REPORT_PARTITION_ID = "REPORT"
+
+    # has key, key, n nodes, n incoming, n slots, n destinations,
+    # report key, stop key
+    PARAMETERS_SIZE = 8 * 4
+
+    # distance and has successors
+    NODE_SIZE = 2 * 4
+
+    # key, mask and slot offset
+    INCOMING_KEYS_SIZE = 3 * 4
+
+    # target and weight
+    EDGE_SIZE = 2 * 4
+
+    # Estimates of the cost of the binary
+    DTCM_BASE = 8 * 1024
+    CYCLES_BASE = 1000
+    CYCLES_PER_NODE = 20
+    CYCLES_PER_SLOT = 20
+    CYCLES_PER_EDGE = 10
+
+    DATA_REGIONS = Enum(
+        value="DATA_REGIONS",
+        names=[('SYSTEM', 0),
+               ('PARAMETERS', 1),
+               ('NODES', 2),
+               ('INCOMING_KEYS', 3),
+               ('ROW_OFFSETS', 4),
+               ('EDGES', 5),
+               ('DISTANCES', 6),
+               ('TICK_PROFILE', 7)])
+
+    def __init__(self, label, graph, slicing, index, source):
+        """
+        :param label: the label of the vertex
+        :param graph: the graph being searched
+        :type graph: WeightedGraph
+        :param slicing: the slices of the nodes over all the vertices
+        :type slicing: NodeSlicing
+        :param index: the index of the slice of this vertex
+        :param source: the number of the node to search from
+        """
+        MachineVertex.__init__(self, label)
+        self._graph = graph
+        self._slicing = slicing
+        self._index = index
+        self._source = source
+        self._incoming = None
+        self._monitor = None
+
+    @property
+    def node_slice(self):
+        return self._slicing.get_slice(self._index)
+
+    @property
+    def n_nodes(self):
+        return self.node_slice.n_atoms
+
+    @property
+    def monitor(self):
+        return self._monitor
+
+    @monitor.setter
+    def monitor(self, monitor):
+        """ The monitor which stops the search when every core is quiet
+        """
+        self._monitor = monitor
+
+    @property
+    def incoming_vertex_indices(self):
+        """ The indices of the slices with nodes linking to nodes of this\
+            vertex
+        """
+        if self._incoming is None:
+            self._incoming = sorted(set(
+                self._slicing.index_of(source)
+                for node in self._slicing.nodes_of(self._index)
+                for source in self._graph.predecessors(node)))
+        return self._incoming
+
+    @property
+    def _n_destinations(self):
+        # every packet sent reaches every vertex with nodes linked to
+        return len(set(
+            self._slicing.index_of(target)
+            for node in self._slicing.nodes_of(self._index)
+            for target, _ in self._graph.successors(node)))
+
+    @property
+    def _n_slots(self):
+        return sum(
+            self._slicing.get_slice(index).n_atoms
+            for index in self.incoming_vertex_indices)
+
+    @property
+    def _n_incoming_edges(self):
+        return sum(
+            len(self._graph.predecessors(node))
+            for node in self._slicing.nodes_of(self._index))
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_file_name)
+    def get_binary_file_name(self):
+        return "sssp.aplx"
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_start_type)
+    def get_binary_start_type(self):
+        return ExecutableStartType.USES_SIMULATION_INTERFACE
+
+    @overrides(AbstractProvidesNKeysForPartition.get_n_keys_for_partition)
+    def get_n_keys_for_partition(self, partition, graph_mapper):
+        if partition.identifier == self.REPORT_PARTITION_ID:
+
+            # packets sent, and packets received
+            return 2
+        return self.n_nodes
+
+    @overrides(MachineDataSpecableVertex.generate_machine_data_specification)
+    def generate_machine_data_specification(
+            self, spec, placement, machine_graph, routing_info, iptags,
+            reverse_iptags, machine_time_step, time_scale_factor):
+        incoming = self.incoming_vertex_indices
+        vertices = self._slicing.vertices
+        n_slots = self._n_slots
+
+        # reserve memory regions
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.SYSTEM.value,
+            size=constants.SYSTEM_BYTES_REQUIREMENT, label='systemInfo')
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.PARAMETERS.value,
+            size=self.PARAMETERS_SIZE, label="parameters")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.NODES.value,
+            size=self.n_nodes * self.NODE_SIZE, label="nodes")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.INCOMING_KEYS.value,
+            size=max(len(incoming) * self.INCOMING_KEYS_SIZE, 4),
+            label="incoming_keys")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.ROW_OFFSETS.value,
+            size=(n_slots + 1) * 4, label="row_offsets")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.EDGES.value,
+            size=max(self._n_incoming_edges * self.EDGE_SIZE, 4),
+            label="edges")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.DISTANCES.value,
+            size=self.n_nodes * 4, label="distances")
+        tick_profile.reserve_tick_profile_region(
+            spec, self.DATA_REGIONS.TICK_PROFILE.value)
+
+        # simulation.c requirements
+        spec.switch_write_focus(self.DATA_REGIONS.SYSTEM.value)
+        spec.write_array(simulation_utilities.get_simulation_header_array(
+            self.get_binary_file_name(), machine_time_step,
+            time_scale_factor))
+
+        # the parameters; there is no key if no node has outgoing edges
+        key = routing_info.get_first_key_from_pre_vertex(
+            self, self.PARTITION_ID)
+        spec.switch_write_focus(self.DATA_REGIONS.PARAMETERS.value)
+        spec.write_value(0 if key is None else 1)
+        spec.write_value(0 if key is None else key)
+        spec.write_value(self.n_nodes)
+        spec.write_value(len(incoming))
+        spec.write_value(n_slots)
+        spec.write_value(self._n_destinations)
+        spec.write_value(routing_info.get_first_key_from_pre_vertex(
+            self, self.REPORT_PARTITION_ID))
+        spec.write_value(routing_info.get_first_key_from_pre_vertex(
+            self._monitor, self._monitor.PARTITION_ID))
+
+        # the initial distance of each node
+        spec.switch_write_focus(self.DATA_REGIONS.NODES.value)
+        nodes = list()
+        for node in self._slicing.nodes_of(self._index):
+            nodes.append(0 if node == self._source else UNREACHED)
+            nodes.append(1 if self._graph.out_degree(node) else 0)
+        spec.write_array(nodes)
+
+        # the keys of the incoming vertices and the slots of their nodes
+        spec.switch_write_focus(self.DATA_REGIONS.INCOMING_KEYS.value)
+        slot_offset = 0
+        for index in incoming:
+            key_and_mask = routing_info.get_routing_info_from_pre_vertex(
+                vertices[index], self.PARTITION_ID).first_key_and_mask
+            spec.write_value(key_and_mask.key)
+            spec.write_value(key_and_mask.mask)
+            spec.write_value(slot_offset)
+            slot_offset += self._slicing.get_slice(index).n_atoms
+
+        # the edges from each incoming node to the nodes of this vertex, in
+        # slot order
+        lo_atom = self.node_slice.lo_atom
+        hi_atom = self.node_slice.hi_atom
+        row_offsets = [0]
+        edges = list()
+        for index in incoming:
+            for source in self._slicing.nodes_of(index):
+                for target, weight in self._graph.successors(source):
+                    if lo_atom <= target <= hi_atom:
+                        edges.append(target - lo_atom)
+                        edges.append(weight)
+                row_offsets.append(len(edges) // 2)
+        spec.switch_write_focus(self.DATA_REGIONS.ROW_OFFSETS.value)
+        spec.write_array(row_offsets)
+        if edges:
+            spec.switch_write_focus(self.DATA_REGIONS.EDGES.value)
+            spec.write_array(edges)
+
+        spec.end_specification()
+
+    @property
+    @overrides(MachineVertex.resources_required)
+    def resources_required(self):
+        n_slots = self._n_slots
+        n_incoming = len(self.incoming_vertex_indices)
+        n_edges = self._n_incoming_edges
+        sdram = (
+            constants.SYSTEM_BYTES_REQUIREMENT + self.PARAMETERS_SIZE +
+            self.n_nodes * self.NODE_SIZE +
+            max(n_incoming * self.INCOMING_KEYS_SIZE, 4) +
+            (n_slots + 1) * 4 + max(n_edges * self.EDGE_SIZE, 4) +
+            self.n_nodes * 4 + tick_profile.TICK_PROFILE_REGION_SIZE)
+
+        # the nodes and frontier, and the distances, row offsets and dirty
+        # list of the slots
+        dtcm = (
+            self.DTCM_BASE + self.n_nodes * (self.NODE_SIZE + 4 + 1) +
+            n_incoming * self.INCOMING_KEYS_SIZE + (n_slots + 1) * 4 +
+            n_slots * (4 + 4 + 1))
+
+        # the worst tick touches every node and edge
+        cycles = (
+            self.CYCLES_BASE + self.n_nodes * self.CYCLES_PER_NODE +
+            n_slots * self.CYCLES_PER_SLOT + n_edges * self.CYCLES_PER_EDGE)
+        return ResourceContainer(
+            sdram=SDRAMResource(sdram), dtcm=DTCMResource(dtcm),
+            cpu_cycles=CPUCyclesPerTickResource(cycles))
+
+    def read_distances(self, transceiver, placement):
+        """ Read the distances of the nodes of this vertex at the end of the\
+            search
+
+        :return: the distances, in the order of the nodes, with None for\
+            those not reached
+        :rtype: list of int
+        """
+        address = helpful_functions.locate_memory_region_for_placement(
+            placement, self.DATA_REGIONS.DISTANCES.value, transceiver)
+        data = transceiver.read_memory(
+            placement.x, placement.y, address, self.n_nodes * 4)
+        return [
+            None if distance == UNREACHED else distance
+            for distance in struct.unpack(
+                "<{}I".format(self.n_nodes), bytes(data))]
+
+    @property
+    @overrides(AbstractHasTickProfile.tick_profile_region_id)
+    def tick_profile_region_id(self):
+        return self.DATA_REGIONS.TICK_PROFILE.value
+
+    def __repr__(self):
+        return self.label
@@ -0,0 +1,47 @@
+import spinnaker_graph_front_end as front_end
+
+from spinnaker_graph_front_end.utilities.stencil_spec import MOORE, UINT8
+
+import random
+
+GRID_SIZE = 32
+TILE_SIZE = 8
+N_GENERATIONS = 50
+
+
+def life(state, n_alive):
+    """ Conway's rule: the generated kernel holds it as a lookup table
+    """
+    return 1 if n_alive == 3 or (state and n_alive == 2) else 0
+
+
+def host_generation(cells):
+    size = len(cells)
+    return [[life(cells[y][x], sum(
+        cells[(y + dy) % size][(x + dx) % size] for dx, dy in MOORE))
+        for x in range(size)] for y in range(size)]
+
+
+spec = front_end.StencilSpec(
+    neighbourhood=MOORE, cell_type=UINT8, tile_width=TILE_SIZE,
+    tile_height=TILE_SIZE, rule=life)
+states = random.Random(1)
+cells = [[1 if states.random() < 0.3 else 0 for _ in range(GRID_SIZE)]
+         for _ in range(GRID_SIZE)]
+
+front_end.setup()
+grid = front_end.add_stencil_grid(spec, cells, label="life")
+
+# the first tick only sends the initial borders, so each generation after
+# that takes one tick
+front_end.run(N_GENERATIONS + 1)
+result = front_end.get_stencil_cells(grid)
+front_end.stop()
+
+expected = cells
+for _ in range(N_GENERATIONS):
+    expected = host_generation(expected)
+print "{} of {} cells alive after {} generations, {} on the host".format(
+    sum(map(sum, result)), GRID_SIZE * GRID_SIZE, N_GENERATIONS,
+    sum(map(sum, expected)))
+print "matches the host" if result == expected else "differs from the host"
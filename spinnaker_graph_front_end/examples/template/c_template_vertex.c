@@ -141,6 +141,10 @@ void update(uint ticks, uint unused) {
             recording_finalise();
         }
 
+        // TODO: If the vertex is an AbstractCheckpointable, write any state
+        //       held in DTCM back to its checkpoint region here, so that
+        //       front_end.checkpoint() reads the state it paused with
+
         // falls into the pause resume mode of operating
         simulation_handle_pause_resume(resume_callback);
 
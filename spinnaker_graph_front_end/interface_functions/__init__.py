@@ -0,0 +1,3 @@
+from .resource_usage_checker import ResourceUsageChecker
+
+__all__ = ["ResourceUsageChecker"]
@@ -0,0 +1,28 @@
+from spinnaker_graph_front_end.utilities.resource_model \
+    import check_resource_usage
+
+
+class ResourceUsageChecker(object):
+    """ Warns about the vertices which need more CPU time per tick or more\
+        DTCM than a core has.  This runs during mapping after the placer,\
+        as the resources of some vertices depend on the length of the run,\
+        which is only known to them then.
+    """
+
+    __slots__ = []
+
+    def __call__(
+            self, machine_graph, placements, machine_time_step,
+            time_scale_factor, cpu_clock_mhz):
+        """
+        :param machine_graph: the machine graph
+        :param placements: the placements, only so that this runs after\
+            the placer
+        :param machine_time_step: the machine time step in microseconds
+        :param time_scale_factor: the time scale factor
+        :param cpu_clock_mhz: the clock speed of the cores in MHz
+        :return: the vertices which are overloaded
+        """
+        return check_resource_usage(
+            machine_graph.vertices, machine_time_step * time_scale_factor,
+            cpu_clock_mhz)
@@ -2,22 +2,44 @@
 from spinn_front_end_common.interface.abstract_spinnaker_base \
     import AbstractSpinnakerBase
 from spinn_front_end_common.utilities import globals_variables
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
 
 # graph front end imports
 from spinnaker_graph_front_end.utilities.graph_front_end_failed_state \
     import GraphFrontEndFailedState
 from spinnaker_graph_front_end.graph_front_end_simulator_interface \
     import GraphFrontEndSimulatorInterface
+from spinnaker_graph_front_end import interface_functions
+from spinnaker_graph_front_end.utilities import tick_profile
+from spinnaker_graph_front_end.utilities.checkpoint \
+    import Checkpoint, restore_vertex, take_checkpoint
+from spinnaker_graph_front_end.utilities.recording_sizing \
+    import check_recording_sizes
+from spinnaker_graph_front_end.utilities.router_table_usage \
+    import check_router_table_usage
+from spinnaker_graph_front_end.utilities.key_trace \
+    import get_key_trace_report
+from spinnaker_graph_front_end.utilities.token_log import read_token_logs
+from spinnaker_graph_front_end.utilities.phase_timing_report \
+    import AlgorithmTiming, PhaseTimingReport, get_peak_memory_kb
 from _version import __version__ as version
 
 # general imports
+from collections import OrderedDict
 import logging
 import os
+import time
 
 logger = logging.getLogger(__name__)
 
 SPALLOC_CORES = 48
 
+# The algorithms provided by the graph front end
+INTERFACE_FUNCTIONS_XML = "gfe_interface_functions.xml"
+
+# The mapping algorithm which warns about vertices a core cannot hold
+RESOURCE_USAGE_CHECKER = "ResourceUsageChecker"
+
 # At import time change the default FailedState
 globals_variables.set_failed_state(GraphFrontEndFailedState())
 
@@ -37,16 +59,50 @@ class SpiNNaker(AbstractSpinnakerBase, GraphFrontEndSimulatorInterface):
             database_socket_addresses=None, dsg_algorithm=None,
             n_chips_required=None, extra_pre_run_algorithms=None,
             extra_post_run_algorithms=None, time_scale_factor=None,
-            machine_time_step=None):
+            machine_time_step=None, restore_from=None):
 
         global CONFIG_FILE_NAME, SPALLOC_CORES
 
         # dsg algorithm store for user defined algorithms
         self._user_dsg_algorithm = dsg_algorithm
 
+        # the timing reports of the runs so far, and the one being filled
+        self._timing_reports = list()
+        self._current_timing_report = None
+        self._active_phase = None
+
+        # the extra algorithms given by the user, to be picked out of the
+        # timings of the tool chain
+        self._extra_algorithms = dict()
+        for algorithm in extra_pre_run_algorithms or []:
+            self._extra_algorithms[algorithm] = "pre_run"
+        for algorithm in extra_post_run_algorithms or []:
+            self._extra_algorithms[algorithm] = "post_run"
+
+        # the checkpoint the vertices added are restored from, whose timing
+        # is used unless other timing is given
+        self._restored_checkpoint = None
+        self._n_restored_vertices = 0
+
+        # the batches of independent graphs sharing the machine graph
+        self._graph_batches = list()
+        if restore_from is not None:
+            self._restored_checkpoint = Checkpoint.load(restore_from)
+            if machine_time_step is None:
+                machine_time_step = \
+                    self._restored_checkpoint.machine_time_step
+            if time_scale_factor is None:
+                time_scale_factor = \
+                    self._restored_checkpoint.time_scale_factor
+            logger.info("Restoring vertices from {}".format(
+                self._restored_checkpoint))
+
         # create xml path for where to locate GFE related functions when
         # using auto pause and resume
         extra_xml_path = list()
+        extra_xml_path.append(os.path.join(
+            os.path.dirname(interface_functions.__file__),
+            INTERFACE_FUNCTIONS_XML))
 
         front_end_versions = [("SpiNNakerGraphFrontEnd", version)]
 
@@ -69,6 +125,14 @@ class SpiNNaker(AbstractSpinnakerBase, GraphFrontEndSimulatorInterface):
         extra_mapping_inputs["CreateAtomToEventIdMapping"] = self.config.\
             getboolean("Database", "create_routing_info_to_atom_id_mapping")
 
+
+        # warn about vertices that cannot keep up before they fail to, once
+        # they are placed and know the length of the run
+        if self.config.getboolean("Resources", "check_resource_usage"):
+            extra_mapping_inputs["CPUClockMHz"] = self.config.getint(
+                "Resources", "cpu_clock_mhz")
+            self.extend_extra_mapping_algorithms([RESOURCE_USAGE_CHECKER])
+
         self.update_extra_mapping_inputs(extra_mapping_inputs)
         self.prepend_extra_pre_run_algorithms(extra_pre_run_algorithms)
         self.extend_extra_post_run_algorithms(extra_post_run_algorithms)
@@ -88,6 +152,9 @@ class SpiNNaker(AbstractSpinnakerBase, GraphFrontEndSimulatorInterface):
         logger.info("Setting machine time step to {} micro-seconds."
                     .format(self._machine_time_step))
 
+        # the graph is built from now until the first run
+        self._last_phase_end = time.time()
+
     def get_machine_dimensions(self):
         """ Get the machine dimensions
         """
@@ -109,14 +176,226 @@ class SpiNNaker(AbstractSpinnakerBase, GraphFrontEndSimulatorInterface):
         """
         self._add_socket_address(socket_address)
 
+    def add_binary_folder(self, folder):
+        """ Add a folder to those searched for the binaries of the vertices,\
+            such as one holding generated binaries
+
+        :param folder: the folder to add
+        """
+        self._executable_finder.add_path(folder)
+
+    def add_machine_vertex(self, vertex):
+        if self._restored_checkpoint is not None and restore_vertex(
+                self._restored_checkpoint, vertex):
+            self._n_restored_vertices += 1
+        AbstractSpinnakerBase.add_machine_vertex(self, vertex)
+
+    def add_graph_batch(self, batch):
+        """ Add a batch of graphs whose keys are checked before each run
+
+        :type batch: GraphBatch
+        """
+        self._graph_batches.append(batch)
+
+    def checkpoint(self, path):
+        """ Save the state of every vertex that can be checkpointed to a\
+            file, while the application is paused between runs
+
+        :param path: the file to write
+        :return: the checkpoint written
+        :rtype: Checkpoint
+        """
+        if not self.has_ran:
+            raise ConfigurationException(
+                "There is no state to checkpoint until the graph has run")
+        checkpoint = take_checkpoint(
+            self.transceiver, self.placements, self.no_machine_time_steps,
+            self._machine_time_step, self._time_scale_factor)
+        checkpoint.save(path)
+        logger.info("Saved {} to {}".format(checkpoint, path))
+        return checkpoint
+
+    def get_tick_profiles(self):
+        """ Read the tick profiles of the vertices which measure them
+
+        :return: dict of placement to TickProfile
+        """
+        return tick_profile.get_tick_profiles(
+            self.transceiver, self.placements)
+
+    def get_token_logs(self):
+        """ Read the messages logged by the binaries built with tokenised\
+            logging
+
+        :return: dict of placement to its messages, oldest first
+        """
+        if not self.has_ran:
+            raise ConfigurationException(
+                "There are no messages to read until the graph has run")
+        return read_token_logs(
+            self.transceiver, self.placements, self._executable_finder)
+
+    def get_key_trace_report(self):
+        """ Read the packets counted by the vertices which trace their keys\
+            and the packets dropped by the routers, and write the report of\
+            the traffic on each edge, link and chip
+
+        :rtype: KeyTraceReport
+        """
+        if not self.has_ran:
+            raise ConfigurationException(
+                "There is no traffic to report until the graph has run")
+        return get_key_trace_report(
+            self.transceiver, self.placements, self.machine_graph,
+            self.routing_infos, self.machine, self._router_tables,
+            self._report_default_directory)
+
+    @property
+    def phase_timings(self):
+        """ The seconds spent in each phase of the tool chain (graph\
+            building, mapping, data generation, loading, running and\
+            extraction) over all the runs so far
+        """
+        timings = OrderedDict()
+        for report in self._timing_reports:
+            for phase in report.phases:
+                timings[phase.name] = (
+                    timings.get(phase.name, 0.0) + phase.seconds)
+        return timings
+
+    @property
+    def timing_reports(self):
+        """ The timing reports of the runs so far, oldest first
+
+        :rtype: list of PhaseTimingReport
+        """
+        return list(self._timing_reports)
+
+    @property
+    def timing_report(self):
+        """ The timing report of the latest run, or None before the first
+
+        :rtype: PhaseTimingReport
+        """
+        if not self._timing_reports:
+            return None
+        return self._timing_reports[-1]
+
+    def _time_phase(self, phase, method, *args, **kwargs):
+
+        # a phase entered from within another is part of the outer one
+        report = self._current_timing_report
+        if report is None or self._active_phase is not None:
+            return method(self, *args, **kwargs)
+        self._active_phase = phase
+        memory_before = get_peak_memory_kb()
+        start = time.time()
+        try:
+            return method(self, *args, **kwargs)
+        finally:
+            report.phase(phase).add_time(
+                time.time() - start, memory_before, get_peak_memory_kb())
+            self._active_phase = None
+
+    def _run(self, *args, **kwargs):
+        report = PhaseTimingReport()
+        report.phase("graph_building").add_time(
+            time.time() - self._last_phase_end, None, get_peak_memory_kb())
+        self._timing_reports.append(report)
+        self._current_timing_report = report
+        try:
+            return AbstractSpinnakerBase._run(self, *args, **kwargs)
+        finally:
+            self._last_phase_end = time.time()
+
+    def _run_algorithms(self, *args, **kwargs):
+        executor = AbstractSpinnakerBase._run_algorithms(
+            self, *args, **kwargs)
+
+        # file the timings of the algorithms under the phase running them
+        report = self._current_timing_report
+        if report is not None:
+            phase = report.phase(self._active_phase or "other")
+            for timing in getattr(executor, "algorithm_timings", []):
+                name, run_time = timing[0], timing[1]
+                if hasattr(run_time, "total_seconds"):
+                    run_time = run_time.total_seconds()
+                phase.add_algorithm(AlgorithmTiming(
+                    name, run_time, self._extra_algorithms.get(name)))
+        return executor
+
+    def _do_mapping(self, *args, **kwargs):
+        result = self._time_phase(
+            "mapping", AbstractSpinnakerBase._do_mapping, *args, **kwargs)
+
+        # report how full the router tables are before they are loaded
+        if (self._router_tables is not None and self.config.getboolean(
+                "Mapping", "check_router_table_usage")):
+            check_router_table_usage(
+                self._router_tables, self._report_default_directory)
+        return result
+
+    def _do_data_generation(self, *args, **kwargs):
+        return self._time_phase(
+            "data_generation", AbstractSpinnakerBase._do_data_generation,
+            *args, **kwargs)
+
+    def _do_load(self, *args, **kwargs):
+        return self._time_phase(
+            "loading", AbstractSpinnakerBase._do_load, *args, **kwargs)
+
+    def _do_run(self, *args, **kwargs):
+        return self._time_phase(
+            "running", AbstractSpinnakerBase._do_run, *args, **kwargs)
+
+    def _do_extract_from_machine(self, *args, **kwargs):
+        return self._time_phase(
+            "extraction", AbstractSpinnakerBase._do_extract_from_machine,
+            *args, **kwargs)
+
     def run(self, run_time):
 
         # set up the correct dsg algorithm
         if self._user_dsg_algorithm is not None:
             self.dsg_algorithm = self._user_dsg_algorithm
 
+        # the graphs of a batch must keep to their own keys
+        for batch in self._graph_batches:
+            batch.check(self.machine_graph)
+
+        # recording regions not read during the run keep the size they were
+        # given for the first run, so the ticks of all the runs must fit
+        if self.has_ran:
+            n_machine_time_steps = None
+            if run_time is not None:
+                n_machine_time_steps = self.no_machine_time_steps + int(
+                    (run_time * 1000.0) / self._machine_time_step)
+            check_recording_sizes(
+                self.machine_graph.vertices, n_machine_time_steps)
+
+        # vertices missing from a checkpoint start from their initial state
+        checkpoint = self._restored_checkpoint
+        if (checkpoint is not None and not self.has_ran and
+                self._n_restored_vertices < len(checkpoint.labels)):
+            logger.warning(
+                "Only {} of the {} vertices in the checkpoint were restored; "
+                "check the graph is labelled as it was".format(
+                    self._n_restored_vertices, len(checkpoint.labels)))
+
         # run normal procedure
         AbstractSpinnakerBase.run(self, run_time)
+        return self.timing_report
+
+    def run_until_complete(self):
+        AbstractSpinnakerBase.run_until_complete(self)
+        return self.timing_report
+
+    def stop(self, *args, **kwargs):
+
+        # the time to stop, which includes any final extraction, is added to
+        # the report of the last run
+        return self._time_phase(
+            "stopping", AbstractSpinnakerBase.stop, *args, **kwargs)
 
     def __repr__(self):
         return "SpiNNaker Graph Front End object for machine {}"\
@@ -0,0 +1,71 @@
+""" The [Buffers] settings of the recording of vertices, read from the\
+    config once per simulator rather than once per vertex
+"""
+from spinn_front_end_common.utilities import globals_variables
+from spinn_front_end_common.utilities import helpful_functions
+
+
+class BufferSettings(object):
+    """ How the recorded data of vertices is buffered
+    """
+
+    __slots__ = [
+        # The number of bytes recorded before the host is asked to read the
+        # data, or None if recording is not buffered
+        "_buffer_size_before_receive",
+
+        # The fewest ticks between requests to the host to read the data
+        "_time_between_requests",
+
+        # Where the requests to read the data are sent
+        "_receive_buffer_host",
+        "_receive_buffer_port"
+    ]
+
+    def __init__(self, config):
+        """
+        :param config: the config of the simulator
+        """
+        self._buffer_size_before_receive = None
+        if config.getboolean("Buffers", "enable_buffered_recording"):
+            self._buffer_size_before_receive = config.getint(
+                "Buffers", "buffer_size_before_receive")
+        self._time_between_requests = config.getint(
+            "Buffers", "time_between_requests")
+        self._receive_buffer_host = config.get(
+            "Buffers", "receive_buffer_host")
+        self._receive_buffer_port = helpful_functions.read_config_int(
+            config, "Buffers", "receive_buffer_port")
+
+    @property
+    def buffer_size_before_receive(self):
+        return self._buffer_size_before_receive
+
+    @property
+    def time_between_requests(self):
+        return self._time_between_requests
+
+    @property
+    def receive_buffer_host(self):
+        return self._receive_buffer_host
+
+    @property
+    def receive_buffer_port(self):
+        return self._receive_buffer_port
+
+
+# The simulator the settings were last read for, and the settings
+_cached = (None, None)
+
+
+def get_buffer_settings():
+    """ The buffer settings of the current simulator, shared by all its\
+        vertices
+
+    :rtype: BufferSettings
+    """
+    global _cached
+    simulator = globals_variables.get_simulator()
+    if _cached[0] is not simulator:
+        _cached = (simulator, BufferSettings(simulator.config))
+    return _cached[1]
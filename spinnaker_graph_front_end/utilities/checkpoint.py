@@ -0,0 +1,182 @@
+""" Saving the state of the vertices of a paused application to a file, so\
+    that it can be carried on from there by a later setup() (see\
+    AbstractCheckpointable)
+"""
+import json
+import struct
+import zlib
+
+from spinn_front_end_common.utilities import helpful_functions
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.abstract_models import AbstractCheckpointable
+
+# The start of every checkpoint file
+CHECKPOINT_MAGIC = b"GFECKPT1"
+
+# The length of the header that follows the magic
+_HEADER_LENGTH = struct.Struct("<I")
+
+
+class Checkpoint(object):
+    """ The states of the vertices of an application at a pause, by the\
+        label of the vertex, with the timing they were run with.  The file\
+        holds a small JSON header followed by all of the states compressed\
+        together.
+    """
+
+    __slots__ = [
+        # The number of machine time steps run before the checkpoint
+        "_n_machine_time_steps",
+
+        # The machine time step and time scale factor of the runs
+        "_machine_time_step",
+        "_time_scale_factor",
+
+        # The state of each vertex, by label, in the order they were added
+        "_labels",
+        "_states"
+    ]
+
+    def __init__(self, n_machine_time_steps, machine_time_step,
+                 time_scale_factor):
+        self._n_machine_time_steps = n_machine_time_steps
+        self._machine_time_step = machine_time_step
+        self._time_scale_factor = time_scale_factor
+        self._labels = list()
+        self._states = dict()
+
+    @property
+    def n_machine_time_steps(self):
+        return self._n_machine_time_steps
+
+    @property
+    def machine_time_step(self):
+        return self._machine_time_step
+
+    @property
+    def time_scale_factor(self):
+        return self._time_scale_factor
+
+    @property
+    def labels(self):
+        return list(self._labels)
+
+    def add_state(self, label, state):
+        """ Add the state of a vertex
+
+        :param label: the label of the vertex, unique in the checkpoint
+        :param state: the bytes of the state
+        :raise ConfigurationException: if the label is already used
+        """
+        if label in self._states:
+            raise ConfigurationException(
+                "Cannot checkpoint two vertices labelled {}; give the "
+                "checkpointed vertices unique labels".format(label))
+        self._labels.append(label)
+        self._states[label] = bytes(state)
+
+    def get_state(self, label):
+        """ Get the state of a vertex
+
+        :param label: the label of the vertex
+        :return: the bytes of the state, or None if the vertex has none
+        """
+        return self._states.get(label)
+
+    def save(self, path):
+        """ Write the checkpoint to a file
+        """
+        header = json.dumps({
+            "n_machine_time_steps": self._n_machine_time_steps,
+            "machine_time_step": self._machine_time_step,
+            "time_scale_factor": self._time_scale_factor,
+            "sizes": [[label, len(self._states[label])]
+                      for label in self._labels]}).encode("utf-8")
+        with open(path, "wb") as f:
+            f.write(CHECKPOINT_MAGIC)
+            f.write(_HEADER_LENGTH.pack(len(header)))
+            f.write(header)
+            f.write(zlib.compress(
+                b"".join(self._states[label] for label in self._labels)))
+
+    @staticmethod
+    def load(path):
+        """ Read a checkpoint written by save()
+
+        :rtype: :py:class:`Checkpoint`
+        :raise ConfigurationException: if the file is not a checkpoint
+        """
+        with open(path, "rb") as f:
+            data = f.read()
+        start = len(CHECKPOINT_MAGIC)
+        if data[:start] != CHECKPOINT_MAGIC:
+            raise ConfigurationException(
+                "{} is not a checkpoint".format(path))
+        header_length, = _HEADER_LENGTH.unpack_from(data, start)
+        start += _HEADER_LENGTH.size
+        header = json.loads(
+            data[start:start + header_length].decode("utf-8"))
+        states = zlib.decompress(data[start + header_length:])
+        if len(states) != sum(size for _, size in header["sizes"]):
+            raise ConfigurationException(
+                "The states in checkpoint {} are truncated".format(path))
+
+        checkpoint = Checkpoint(
+            header["n_machine_time_steps"], header["machine_time_step"],
+            header["time_scale_factor"])
+        offset = 0
+        for label, size in header["sizes"]:
+            checkpoint.add_state(label, states[offset:offset + size])
+            offset += size
+        return checkpoint
+
+    def __repr__(self):
+        return "Checkpoint({} vertices after {} time steps)".format(
+            len(self._labels), self._n_machine_time_steps)
+
+
+def take_checkpoint(
+        transceiver, placements, n_machine_time_steps, machine_time_step,
+        time_scale_factor):
+    """ Read the state of every vertex which can be checkpointed
+
+    :param transceiver: the transceiver to read with
+    :param placements: the placements of the machine graph
+    :param n_machine_time_steps: the time steps run so far
+    :param machine_time_step: the machine time step of the runs
+    :param time_scale_factor: the time scale factor of the runs
+    :rtype: :py:class:`Checkpoint`
+    """
+    checkpoint = Checkpoint(
+        n_machine_time_steps, machine_time_step, time_scale_factor)
+    for placement in placements.placements:
+        vertex = placement.vertex
+        if isinstance(vertex, AbstractCheckpointable):
+            address = helpful_functions.locate_memory_region_for_placement(
+                placement, vertex.checkpoint_region_id, transceiver)
+            checkpoint.add_state(vertex.label, transceiver.read_memory(
+                placement.x, placement.y, address,
+                vertex.checkpoint_size_in_bytes))
+    return checkpoint
+
+
+def restore_vertex(checkpoint, vertex):
+    """ Give a vertex its state from a checkpoint, if it has one
+
+    :param checkpoint: the checkpoint being restored
+    :param vertex: a vertex being added to the graph
+    :return: True if the vertex was given a state
+    :raise ConfigurationException: if the state is the wrong size
+    """
+    if not isinstance(vertex, AbstractCheckpointable):
+        return False
+    state = checkpoint.get_state(vertex.label)
+    if state is None:
+        return False
+    if len(state) != vertex.checkpoint_size_in_bytes:
+        raise ConfigurationException(
+            "The checkpoint of {} has {} bytes rather than {}".format(
+                vertex.label, len(state), vertex.checkpoint_size_in_bytes))
+    vertex.restore_checkpoint(state)
+    return True
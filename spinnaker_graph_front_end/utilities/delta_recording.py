@@ -0,0 +1,94 @@
+""" Reading of the records of the changes of values made with\
+    delta_recording.h: a record of (tick, value) is made only when a value\
+    changes, as the ticks since the last record and the value, each an\
+    unsigned LEB128 varint, in blocks padded to whole words with zeros
+"""
+from spinn_front_end_common.utilities.exceptions import SpinnFrontEndException
+
+
+def encode_varint(value):
+    """ The bytes of an unsigned LEB128 varint
+
+    :rtype: bytearray
+    """
+    data = bytearray()
+    while value >= 0x80:
+        data.append((value & 0x7F) | 0x80)
+        value >>= 7
+    data.append(value)
+    return data
+
+
+def encode_transitions(transitions):
+    """ The records of some changes, as made by delta_recording.h, without\
+        padding
+
+    :param transitions: the (tick, value) of each change, in tick order
+    :rtype: bytearray
+    """
+    data = bytearray()
+    last_tick = -1
+    for tick, value in transitions:
+        data += encode_varint(tick - last_tick)
+        data += encode_varint(value)
+        last_tick = tick
+    return data
+
+
+def _read_varint(data, offset):
+    value = 0
+    shift = 0
+    while True:
+        if offset >= len(data):
+            raise SpinnFrontEndException(
+                "The recorded changes end part way through a record")
+        byte = data[offset]
+        offset += 1
+        value |= (byte & 0x7F) << shift
+        if not byte & 0x80:
+            return value, offset
+        shift += 7
+
+
+def decode_transitions(data):
+    """ Read the records of the changes of a value
+
+    :param data: the recorded bytes, of one or more runs
+    :return: the (tick, value) of each change, in tick order
+    :rtype: list of (int, int)
+    """
+    data = bytearray(data)
+    transitions = list()
+    tick = -1
+    offset = 0
+    while offset < len(data):
+
+        # a record never starts with zero, so zeros are padding
+        if data[offset] == 0:
+            offset += 1
+            continue
+        delta, offset = _read_varint(data, offset)
+        value, offset = _read_varint(data, offset)
+        tick += delta
+        transitions.append((tick, value))
+    return transitions
+
+
+def expand_transitions(transitions, n_ticks, initial_value=0):
+    """ The value at every tick from the changes of the value
+
+    :param transitions: the (tick, value) of each change, in tick order
+    :param n_ticks: the number of ticks run
+    :param initial_value: the value before the first change
+    :return: the value at each tick
+    :rtype: list
+    """
+    values = list()
+    value = initial_value
+    for tick, new_value in transitions:
+        if tick >= n_ticks:
+            break
+        values.extend([value] * (tick - len(values)))
+        value = new_value
+    values.extend([value] * (n_ticks - len(values)))
+    return values
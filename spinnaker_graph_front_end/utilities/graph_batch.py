@@ -0,0 +1,228 @@
+""" Several independent machine graphs, such as the variants of a parameter\
+    sweep, mapped side by side onto one allocation and run, recorded and\
+    extracted together.  Each graph of the batch has its own range of keys:\
+    the top bits of a key say which graph sends it, so fixed keys, such as\
+    those of LatticeKeys, can be given the same way in every graph without\
+    clashing, while the keys left to the key allocator are unique anyway.
+"""
+from pacman.model.constraints.key_allocator_constraints \
+    import FixedKeyAndMaskConstraint
+
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.utilities.lattice_keys import LatticeKeys
+
+from collections import OrderedDict
+
+
+class BatchedGraph(object):
+    """ One of the graphs of a batch, to which its vertices and edges are\
+        added instead of to the front end
+    """
+
+    __slots__ = [
+        # The name of the graph in the batch
+        "_name",
+
+        # The first key of the graph, and the mask of the bits saying which
+        # graph a key is from
+        "_base_key",
+        "_prefix_mask",
+
+        # The functions adding vertices and edges to the machine graph
+        "_add_vertex",
+        "_add_edge",
+
+        # The vertices of the graph, in the order added
+        "_vertices"
+    ]
+
+    def __init__(self, name, base_key, prefix_mask, add_vertex, add_edge):
+        self._name = name
+        self._base_key = base_key
+        self._prefix_mask = prefix_mask
+        self._add_vertex = add_vertex
+        self._add_edge = add_edge
+        self._vertices = OrderedDict()
+
+    @property
+    def name(self):
+        return self._name
+
+    @property
+    def base_key(self):
+        """ The first key of the range of the graph
+        """
+        return self._base_key
+
+    @property
+    def n_keys(self):
+        """ The number of keys in the range of the graph
+        """
+        return (~self._prefix_mask & 0xFFFFFFFF) + 1
+
+    @property
+    def vertices(self):
+        return list(self._vertices)
+
+    def has_vertex(self, vertex):
+        return vertex in self._vertices
+
+    def owns_key(self, key):
+        return key & self._prefix_mask == self._base_key
+
+    def add_machine_vertex_instance(self, vertex):
+        """ Add a vertex to the graph and so to the machine graph
+        """
+        self._vertices[vertex] = None
+        self._add_vertex(vertex)
+
+    def add_machine_edge_instance(self, edge, partition_id):
+        """ Add an edge between two vertices of the graph
+
+        :raise ConfigurationException: if either end is in another graph
+        """
+        if (edge.pre_vertex not in self._vertices or
+                edge.post_vertex not in self._vertices):
+            raise ConfigurationException(
+                "Edge {} joins a vertex outside graph {} of the batch; the "
+                "graphs of a batch are independent".format(
+                    edge.label, self._name))
+        self._add_edge(edge, partition_id)
+
+    def lattice_keys(self, width, height, keys_per_vertex=1):
+        """ Keys for a lattice of the vertices of the graph, in its range
+
+        :rtype: LatticeKeys
+        """
+        return LatticeKeys(width, height, keys_per_vertex, self._base_key)
+
+    def collect(self, placements, read):
+        """ Read a result from each vertex of the graph
+
+        :param placements: the placements of the vertices
+        :param read: function of a vertex and its placement giving the\
+            result of the vertex
+        :return: the result of each vertex, in the order the vertices were\
+            added
+        :rtype: OrderedDict of vertex to result
+        """
+        return OrderedDict(
+            (vertex, read(vertex, placements.get_placement_of_vertex(vertex)))
+            for vertex in self._vertices)
+
+    def __repr__(self):
+        return "BatchedGraph({}, {} vertices, keys from 0x{:08x})".format(
+            self._name, len(self._vertices), self._base_key)
+
+
+class GraphBatch(object):
+    """ Independent graphs sharing one machine graph, and so one\
+        allocation; see front_end.create_graph_batch()
+    """
+
+    __slots__ = [
+        # The number of top bits of a key which say which graph sends it
+        "_prefix_bits",
+
+        # The functions adding vertices and edges to the machine graph
+        "_add_vertex",
+        "_add_edge",
+
+        # The graphs, by name
+        "_graphs"
+    ]
+
+    def __init__(self, add_vertex, add_edge, prefix_bits=8):
+        """
+        :param add_vertex: function to add a machine vertex to the graph
+        :param add_edge: function to add a machine edge to the graph, given\
+            the edge and its partition
+        :param prefix_bits: the top bits of each key saying which graph\
+            sends it, so there can be up to 2^prefix_bits graphs
+        """
+        if not 0 < prefix_bits < 32:
+            raise ConfigurationException(
+                "The prefix of a graph batch is between 1 and 31 bits")
+        self._prefix_bits = prefix_bits
+        self._add_vertex = add_vertex
+        self._add_edge = add_edge
+        self._graphs = OrderedDict()
+
+    @property
+    def graphs(self):
+        return list(self._graphs.values())
+
+    def add_graph(self, name):
+        """ Add an empty graph to the batch
+
+        :param name: the name of the graph, by which its results are given
+        :rtype: BatchedGraph
+        :raise ConfigurationException: if the name is taken, or the batch\
+            is full
+        """
+        if name in self._graphs:
+            raise ConfigurationException(
+                "The batch already has a graph called {}".format(name))
+        index = len(self._graphs)
+        if index >> self._prefix_bits:
+            raise ConfigurationException(
+                "A batch with {} prefix bits holds at most {} graphs".format(
+                    self._prefix_bits, 1 << self._prefix_bits))
+        shift = 32 - self._prefix_bits
+        graph = BatchedGraph(
+            name, index << shift, (0xFFFFFFFF << shift) & 0xFFFFFFFF,
+            self._add_vertex, self._add_edge)
+        self._graphs[name] = graph
+        return graph
+
+    def graph(self, name):
+        return self._graphs[name]
+
+    def graph_of(self, vertex):
+        """ The graph of the batch a vertex was added to, or None
+        """
+        for graph in self._graphs.values():
+            if graph.has_vertex(vertex):
+                return graph
+        return None
+
+    def check(self, machine_graph):
+        """ Check that the fixed keys of the partitions of each graph are in\
+            its range; called before each run
+
+        :raise ConfigurationException: if a graph has keys of another
+        """
+        for graph in self._graphs.values():
+            for vertex in graph.vertices:
+                for partition in machine_graph.\
+                        get_outgoing_edge_partitions_starting_at_vertex(
+                            vertex):
+                    for constraint in partition.constraints:
+                        if not isinstance(
+                                constraint, FixedKeyAndMaskConstraint):
+                            continue
+                        for key_and_mask in constraint.keys_and_masks:
+                            if not graph.owns_key(key_and_mask.key):
+                                raise ConfigurationException(
+                                    "The key 0x{:08x} of {} is outside the "
+                                    "range of graph {} of the batch".format(
+                                        key_and_mask.key, vertex,
+                                        graph.name))
+
+    def collect(self, placements, read):
+        """ Read a result from each vertex of each graph
+
+        :param placements: the placements of the vertices
+        :param read: function of a vertex and its placement giving the\
+            result of the vertex
+        :return: the results of the vertices of each graph, by the name of\
+            the graph
+        :rtype: OrderedDict of name to OrderedDict of vertex to result
+        """
+        return OrderedDict(
+            (name, graph.collect(placements, read))
+            for name, graph in self._graphs.items())
+
+    def __repr__(self):
+        return "GraphBatch({} graphs)".format(len(self._graphs))
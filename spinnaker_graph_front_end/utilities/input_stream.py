@@ -0,0 +1,455 @@
+""" Streaming values from the host into a running graph through a stream\
+    injector core (see StreamInjectorVertex).  Values are batched into\
+    frames of up to MAX_VALUES_PER_FRAME values, each sent as one UDP\
+    packet to the reverse IP tag of the injector, which sends each value on\
+    as a multicast packet with the key of its channel.  The host may have\
+    at most a window of frames in flight, and the injector tells it how far\
+    it has got, with its counters, through an IP tag back to the socket the\
+    frames are sent from.  The formats are the same as in\
+    stream_injector.c.
+"""
+from spinn_front_end_common.utilities.exceptions import SpinnFrontEndException
+
+import logging
+import select
+import socket
+import struct
+import time
+
+logger = logging.getLogger(__name__)
+
+# The commands of the messages between the host and the injector
+FRAME_DATA = 1
+FRAME_CREDIT_REQUEST = 2
+FRAME_CREDIT = 3
+
+# The most values in a frame, which fits in one SDP message
+MAX_VALUES_PER_FRAME = 64
+
+# The SDP port the frames are delivered to the injector on
+STREAM_SDP_PORT = 2
+
+# command, sequence, first channel, stride, number of values
+_FRAME_HEADER = struct.Struct("<HHHBB")
+
+# command, drained sequence, frames received, frames missed, frames
+# dropped, packets sent, ticks rate limited
+_CREDIT = struct.Struct("<HHIIIII")
+
+# The most a channel can be, and a stride
+MAX_CHANNEL = 0xFFFF
+MAX_STRIDE = 0xFF
+
+_SEQUENCE_MASK = 0xFFFF
+
+
+class InjectorCounters(object):
+    """ The counters of a stream injector core
+    """
+
+    __slots__ = [
+        # The frames buffered by the injector
+        "_frames_received",
+
+        # The frames which never arrived, from gaps in the sequence
+        "_frames_missed",
+
+        # The frames which arrived with the buffer full, or out of order
+        "_frames_dropped",
+
+        # The multicast packets sent
+        "_packets_sent",
+
+        # The ticks which ended with values left to send because of the
+        # rate limit
+        "_ticks_rate_limited"
+    ]
+
+    def __init__(self, frames_received=0, frames_missed=0, frames_dropped=0,
+                 packets_sent=0, ticks_rate_limited=0):
+        self._frames_received = frames_received
+        self._frames_missed = frames_missed
+        self._frames_dropped = frames_dropped
+        self._packets_sent = packets_sent
+        self._ticks_rate_limited = ticks_rate_limited
+
+    @property
+    def frames_received(self):
+        return self._frames_received
+
+    @property
+    def frames_missed(self):
+        return self._frames_missed
+
+    @property
+    def frames_dropped(self):
+        return self._frames_dropped
+
+    @property
+    def packets_sent(self):
+        return self._packets_sent
+
+    @property
+    def ticks_rate_limited(self):
+        return self._ticks_rate_limited
+
+    def as_words(self):
+        return (self._frames_received, self._frames_missed,
+                self._frames_dropped, self._packets_sent,
+                self._ticks_rate_limited)
+
+    def __repr__(self):
+        return (
+            "InjectorCounters({} frames received, {} missed, {} dropped, "
+            "{} packets sent, {} ticks rate limited)".format(
+                *self.as_words()))
+
+
+def make_runs(items):
+    """ Group (channel, value) pairs into runs which fit in a frame: values\
+        for the same channel one after another (stride 0), or for channels\
+        one after another (stride 1)
+
+    :param items: the (channel, value) pairs, in the order to be sent
+    :return: (first channel, stride, values) of each run
+    :rtype: list of (int, int, list of int)
+    """
+    runs = list()
+    first_channel = None
+    stride = None
+    values = list()
+    last_channel = None
+    for channel, value in items:
+        if not 0 <= channel <= MAX_CHANNEL:
+            raise SpinnFrontEndException(
+                "Channel {} is out of range".format(channel))
+        if values and len(values) < MAX_VALUES_PER_FRAME:
+            step = channel - last_channel
+            if stride is None and step in (0, 1):
+                stride = step
+            if step == stride:
+                values.append(value)
+                last_channel = channel
+                continue
+        if values:
+            runs.append((first_channel, stride or 0, values))
+        first_channel = channel
+        last_channel = channel
+        stride = None
+        values = [value]
+    if values:
+        runs.append((first_channel, stride or 0, values))
+    return runs
+
+
+def encode_frame(sequence, first_channel, stride, values):
+    """ The bytes of a frame of values
+
+    :param sequence: the sequence number of the frame
+    :param first_channel: the channel of the first value
+    :param stride: what is added to the channel for each value
+    :param values: the 32-bit values, as ints
+    :rtype: bytes
+    """
+    if len(values) > MAX_VALUES_PER_FRAME or not 0 <= stride <= MAX_STRIDE:
+        raise SpinnFrontEndException(
+            "A frame holds at most {} values with a stride of at most "
+            "{}".format(MAX_VALUES_PER_FRAME, MAX_STRIDE))
+    return _FRAME_HEADER.pack(
+        FRAME_DATA, sequence & _SEQUENCE_MASK, first_channel, stride,
+        len(values)) + struct.pack(
+            "<{}I".format(len(values)),
+            *[value & 0xFFFFFFFF for value in values])
+
+
+def decode_frame(data):
+    """ Split a message to the injector into its fields
+
+    :return: command, sequence, first channel, stride and values
+    :rtype: (int, int, int, int, list of int)
+    """
+    command, sequence, first_channel, stride, n_values = \
+        _FRAME_HEADER.unpack_from(data)
+    values = list(struct.unpack_from(
+        "<{}I".format(n_values), data, _FRAME_HEADER.size))
+    return command, sequence, first_channel, stride, values
+
+
+def encode_credit_request(sequence):
+    return _FRAME_HEADER.pack(
+        FRAME_CREDIT_REQUEST, sequence & _SEQUENCE_MASK, 0, 0, 0)
+
+
+def encode_credit(drained_sequence, counters):
+    """ The bytes of a credit, as sent by the injector
+    """
+    return _CREDIT.pack(
+        FRAME_CREDIT, drained_sequence & _SEQUENCE_MASK, *counters.as_words())
+
+
+def decode_credit(data):
+    """ Read a credit sent by the injector
+
+    :return: the drained sequence number and the counters, or None if the\
+        data is not a credit
+    :rtype: (int, InjectorCounters) or None
+    """
+    if len(data) < _CREDIT.size:
+        return None
+    fields = _CREDIT.unpack_from(data)
+    if fields[0] != FRAME_CREDIT:
+        return None
+    return fields[1], InjectorCounters(*fields[2:])
+
+
+class InputStreamStatistics(object):
+    """ What an input stream has sent, and how long it waited for credit
+    """
+
+    __slots__ = [
+        "_frames_sent",
+        "_values_sent",
+        "_bytes_sent",
+
+        # The number of times the window was full, and the seconds spent
+        # waiting for credit then
+        "_credit_waits",
+        "_seconds_waiting",
+
+        # When the stream was opened
+        "_start_time",
+
+        # The counters last reported by the injector
+        "_injector_counters"
+    ]
+
+    def __init__(self):
+        self._frames_sent = 0
+        self._values_sent = 0
+        self._bytes_sent = 0
+        self._credit_waits = 0
+        self._seconds_waiting = 0.0
+        self._start_time = time.time()
+        self._injector_counters = InjectorCounters()
+
+    def _add_frame(self, n_values, n_bytes):
+        self._frames_sent += 1
+        self._values_sent += n_values
+        self._bytes_sent += n_bytes
+
+    def _add_wait(self, seconds):
+        self._credit_waits += 1
+        self._seconds_waiting += seconds
+
+    @property
+    def frames_sent(self):
+        return self._frames_sent
+
+    @property
+    def values_sent(self):
+        return self._values_sent
+
+    @property
+    def bytes_sent(self):
+        return self._bytes_sent
+
+    @property
+    def credit_waits(self):
+        return self._credit_waits
+
+    @property
+    def seconds_waiting(self):
+        return self._seconds_waiting
+
+    @property
+    def injector_counters(self):
+        """ The counters the injector last reported
+        """
+        return self._injector_counters
+
+    @property
+    def values_per_second(self):
+        elapsed = time.time() - self._start_time
+        return self._values_sent / elapsed if elapsed > 0 else 0.0
+
+    def __repr__(self):
+        return (
+            "InputStreamStatistics({} values in {} frames, {:.0f} values/s, "
+            "{} waits for credit taking {:.3f}s; {})".format(
+                self._values_sent, self._frames_sent, self.values_per_second,
+                self._credit_waits, self._seconds_waiting,
+                self._injector_counters))
+
+
+class InputStream(object):
+    """ A stream of values from the host to a stream injector core, or to\
+        anything that speaks its protocol, such as UDPInjectorStandIn
+    """
+
+    __slots__ = [
+        # The socket the frames are sent from and the credit received on
+        "_socket",
+
+        # Where the frames are sent
+        "_address",
+
+        # The most frames in flight, which is the number of slots of the
+        # injector
+        "_window",
+
+        # How long to wait for credit before asking for it again, and how
+        # many times to ask before giving up
+        "_timeout",
+        "_max_requests",
+
+        # The sequence number of the next frame, and of the first frame
+        # not yet drained by the injector, without wrapping
+        "_next_sequence",
+        "_drained_sequence",
+
+        # True once the injector has answered, so it is running
+        "_connected",
+
+        # The (channel, value) pairs not yet sent
+        "_pending",
+
+        # What has been sent
+        "_statistics"
+    ]
+
+    def __init__(self, address, port, window, local_port=0, timeout=0.1,
+                 max_requests=100):
+        """
+        :param address: the address of the board of the injector, or of a\
+            stand in
+        :param port: the port of the reverse IP tag of the injector
+        :param window: the number of slots of the injector
+        :param local_port: the port to send from and to receive the credit\
+            on, which is the port of the IP tag of the injector; 0 to pick\
+            any
+        :param timeout: the seconds to wait for credit before asking again
+        :param max_requests: the times to ask for credit before giving up
+        """
+        self._socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self._socket.bind(("0.0.0.0", local_port))
+        self._address = (address, port)
+        self._window = window
+        self._timeout = timeout
+        self._max_requests = max_requests
+        self._next_sequence = 0
+        self._drained_sequence = 0
+        self._connected = False
+        self._pending = list()
+        self._statistics = InputStreamStatistics()
+
+    @property
+    def local_port(self):
+        """ The port the stream sends from and receives credit on
+        """
+        return self._socket.getsockname()[1]
+
+    @property
+    def statistics(self):
+        return self._statistics
+
+    @property
+    def n_in_flight(self):
+        """ The frames sent which the injector has not yet drained
+        """
+        return self._next_sequence - self._drained_sequence
+
+    def send(self, channel, value):
+        """ Queue a value for a channel; values are sent in frames when\
+            enough are queued, or on flush()
+        """
+        self._pending.append((channel, value))
+        if len(self._pending) >= MAX_VALUES_PER_FRAME * self._window:
+            self.flush()
+
+    def send_values(self, channel, values):
+        """ Queue a series of values for one channel
+        """
+        for value in values:
+            self.send(channel, value)
+
+    def send_sample(self, values, first_channel=0):
+        """ Queue a value for each of a range of channels
+        """
+        for offset, value in enumerate(values):
+            self.send(first_channel + offset, value)
+
+    def flush(self):
+        """ Send all the queued values, waiting for credit when the window\
+            is full
+        """
+        runs = make_runs(self._pending)
+        self._pending = list()
+        for first_channel, stride, values in runs:
+            self._wait_for_credit(self._window - 1)
+            frame = encode_frame(
+                self._next_sequence, first_channel, stride, values)
+            self._socket.sendto(frame, self._address)
+            self._next_sequence += 1
+            self._statistics._add_frame(len(values), len(frame))
+
+    def drain(self):
+        """ Send all the queued values and wait until the injector has sent\
+            all of them on
+        """
+        self.flush()
+        self._wait_for_credit(0)
+
+    def close(self):
+        """ Send what is queued and close the stream, logging its statistics
+        """
+        try:
+            self.drain()
+        finally:
+            self._socket.close()
+            logger.info("Closed input stream: {}".format(self._statistics))
+
+    def _receive_credits(self, wait):
+        """ Take any credit that has arrived, waiting up to wait seconds for\
+            some
+
+        :return: True if any credit arrived
+        """
+        received = False
+        while True:
+            readable, _, _ = select.select([self._socket], [], [], wait)
+            if not readable:
+                return received
+            data = self._socket.recv(1024)
+            credit = decode_credit(data)
+            if credit is not None:
+                drained, counters = credit
+
+                # the sequence numbers wrap at 16 bits, but the window is
+                # far smaller than that
+                self._drained_sequence = self._next_sequence - (
+                    (self._next_sequence - drained) & _SEQUENCE_MASK)
+                self._statistics._injector_counters = counters
+                self._connected = True
+                received = True
+            wait = 0
+
+    def _wait_for_credit(self, most_in_flight):
+        """ Wait until no more than a number of frames are in flight; the\
+            injector is asked for credit until it is known to be running
+        """
+        self._receive_credits(0)
+        if self._connected and self.n_in_flight <= most_in_flight:
+            return
+        start = time.time()
+        n_requests = 0
+        while not self._connected or self.n_in_flight > most_in_flight:
+            if n_requests == self._max_requests:
+                raise SpinnFrontEndException(
+                    "No credit from the stream injector at {}:{} after {} "
+                    "requests".format(
+                        self._address[0], self._address[1], n_requests))
+            self._socket.sendto(
+                encode_credit_request(self._next_sequence), self._address)
+            n_requests += 1
+            self._receive_credits(self._timeout)
+        self._statistics._add_wait(time.time() - start)
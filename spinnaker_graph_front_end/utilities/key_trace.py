@@ -0,0 +1,548 @@
+""" Host side of key_trace.h: the multicast packets received by each core,\
+    counted by the outgoing partition they came from, mapped back to the\
+    edges of the graph and traced through the router tables to the links\
+    and chips they crossed
+"""
+from collections import deque
+import logging
+import os
+import struct
+
+from spinn_front_end_common.utilities import globals_variables
+from spinn_front_end_common.utilities import helpful_functions
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.abstract_models import AbstractTracesKeys
+
+logger = logging.getLogger(__name__)
+
+# sample period, n entries, n received, n unmatched
+_HEADER = struct.Struct("<4I")
+
+# key, mask, count
+_ENTRY = struct.Struct("<3I")
+
+# The name of the report written to the report folder
+KEY_TRACE_REPORT = "key_trace_report.rpt"
+
+# The names of the links of a chip, by id
+LINK_NAMES = ("E", "NE", "N", "W", "SW", "S")
+
+# The shades of the heatmaps, from least to most traffic
+_SHADES = "123456789"
+
+
+def get_key_trace_region_size(n_entries):
+    """ The size of the key trace region in bytes
+
+    :param n_entries: the most partitions the vertex receives packets from
+    """
+    return _HEADER.size + n_entries * _ENTRY.size
+
+
+def get_sample_period():
+    """ The period of the packets counted, from the [KeyTrace] section of\
+        the config; 0 when tracing is off
+
+    :rtype: int
+    """
+    config = globals_variables.get_simulator().config
+    if not config.getboolean("KeyTrace", "enable"):
+        return 0
+    sample_period = config.getint("KeyTrace", "sample_period")
+    if sample_period < 1:
+        raise ConfigurationException(
+            "The key trace sample period must be at least 1, not {}".format(
+                sample_period))
+    return sample_period
+
+
+def get_traced_partitions(vertex, machine_graph, routing_info):
+    """ The outgoing partitions with an edge to a vertex, in the order of\
+        the entries of its key trace region
+
+    :param vertex: the vertex receiving the packets
+    :param machine_graph: the machine graph
+    :param routing_info: the routing information of the machine graph
+    :return: the key and mask of each partition and the partition, by\
+        increasing key; partitions without keys send no packets, so are left\
+        out
+    :rtype: list of (BaseKeyAndMask, OutgoingEdgePartition)
+    """
+    traced = dict()
+    for edge in machine_graph.get_edges_ending_at_vertex(vertex):
+        partition = machine_graph.get_outgoing_partition_for_edge(edge)
+        if partition in traced:
+            continue
+        partition_routing_info = \
+            routing_info.get_routing_info_from_partition(partition)
+        if partition_routing_info is not None:
+            traced[partition] = partition_routing_info.first_key_and_mask
+    return sorted(
+        ((key_and_mask, partition)
+         for partition, key_and_mask in traced.items()),
+        key=lambda item: item[0].key)
+
+
+def reserve_key_trace_region(spec, region, n_entries):
+    """ Reserve the key trace region in a data specification
+
+    :param spec: the data specification
+    :param region: the id of the region
+    :param n_entries: the most partitions the vertex receives packets from
+    """
+    spec.reserve_memory_region(
+        region=region, size=get_key_trace_region_size(n_entries),
+        label="key_trace")
+
+
+def write_key_trace_region(
+        spec, region, vertex, machine_graph, routing_info, n_entries):
+    """ Write the keys and masks a vertex receives packets with, for the\
+        binary to count its packets by
+
+    :param spec: the data specification
+    :param region: the id of the region
+    :param vertex: the vertex receiving the packets
+    :param machine_graph: the machine graph
+    :param routing_info: the routing information of the machine graph
+    :param n_entries: the most partitions the region was reserved for
+    """
+    traced = get_traced_partitions(vertex, machine_graph, routing_info)
+    if len(traced) > n_entries:
+        raise ConfigurationException(
+            "{} receives packets from {} partitions, but has room to count "
+            "only {}".format(vertex.label, len(traced), n_entries))
+    spec.switch_write_focus(region)
+    spec.write_array([get_sample_period(), len(traced), 0, 0])
+    for key_and_mask, _ in traced:
+        spec.write_array([key_and_mask.key, key_and_mask.mask, 0])
+
+
+class KeyTrace(object):
+    """ The packets counted by one core since it was loaded
+    """
+
+    __slots__ = [
+        # one packet in every this many was counted, or 0 if none
+        "_sample_period",
+
+        # the packets received, counted or not
+        "_n_received",
+
+        # the packets counted which matched no partition
+        "_n_unmatched",
+
+        # the packets counted from each partition, in region order
+        "_counts"
+    ]
+
+    def __init__(self, sample_period, n_received, n_unmatched, counts):
+        self._sample_period = sample_period
+        self._n_received = n_received
+        self._n_unmatched = n_unmatched
+        self._counts = counts
+
+    @property
+    def sample_period(self):
+        return self._sample_period
+
+    @property
+    def n_received(self):
+        """ The packets received while tracing, whether counted or not
+        """
+        return self._n_received
+
+    @property
+    def n_unmatched(self):
+        """ The packets estimated to have matched no partition
+        """
+        return self._n_unmatched * self._sample_period
+
+    @property
+    def counts(self):
+        """ The packets counted from each partition
+        """
+        return self._counts
+
+    @property
+    def packets(self):
+        """ The packets estimated to have come from each partition, from\
+            those counted
+        """
+        return [count * self._sample_period for count in self._counts]
+
+    def __repr__(self):
+        return "KeyTrace(sample_period={}, n_received={}, n_unmatched={}, " \
+               "counts={})".format(
+                   self._sample_period, self._n_received, self._n_unmatched,
+                   self._counts)
+
+
+def decode_key_trace(data):
+    """ Decode the contents of a key trace region
+
+    :param data: the bytes of the region
+    :rtype: :py:class:`KeyTrace`
+    """
+    sample_period, n_entries, n_received, n_unmatched = \
+        _HEADER.unpack_from(data)
+    counts = [
+        _ENTRY.unpack_from(data, _HEADER.size + i * _ENTRY.size)[2]
+        for i in range(n_entries)]
+    return KeyTrace(sample_period, n_received, n_unmatched, counts)
+
+
+def read_key_trace(transceiver, placement, region):
+    """ Read the key trace of a core
+
+    :param transceiver: the transceiver to read with
+    :param placement: the placement of the vertex
+    :param region: the id of the key trace region
+    :rtype: :py:class:`KeyTrace`
+    """
+    address = helpful_functions.locate_memory_region_for_placement(
+        placement, region, transceiver)
+    header = bytes(transceiver.read_memory(
+        placement.x, placement.y, address, _HEADER.size))
+    n_entries = _HEADER.unpack_from(header)[1]
+    return decode_key_trace(bytes(transceiver.read_memory(
+        placement.x, placement.y, address,
+        get_key_trace_region_size(n_entries))))
+
+
+def get_key_traces(transceiver, placements, machine_graph, routing_info):
+    """ Read the key traces of every vertex which traces its keys
+
+    :param transceiver: the transceiver to read with
+    :param placements: the placements of the machine graph
+    :param machine_graph: the machine graph
+    :param routing_info: the routing information of the machine graph
+    :return: dict of placement to its :py:class:`KeyTrace` and the\
+        partitions of its counts, as get_traced_partitions() gives them
+    """
+    return {
+        placement: (
+            read_key_trace(
+                transceiver, placement,
+                placement.vertex.key_trace_region_id),
+            get_traced_partitions(
+                placement.vertex, machine_graph, routing_info))
+        for placement in placements.placements
+        if isinstance(placement.vertex, AbstractTracesKeys)}
+
+
+def get_dropped_packets(transceiver, chips):
+    """ Read the multicast packets the routers of some chips have dropped
+
+    :param transceiver: the transceiver to read with
+    :param chips: the (x, y) of the chips
+    :return: dict of (x, y) to the packets dropped there
+    """
+    return {
+        (x, y): transceiver.get_router_diagnostics(
+            x, y).n_dropped_multicast_packets
+        for (x, y) in chips}
+
+
+class KeyTraceReport(object):
+    """ The multicast traffic of a run, from the key traces of the vertices:\
+        the packets sent along each edge and through each link and router,\
+        with the packets the routers dropped
+    """
+
+    __slots__ = [
+        # the packets estimated to have been sent along each machine edge
+        "_edge_packets",
+
+        # the packets estimated to have been sent by each partition
+        "_partition_packets",
+
+        # the key traces of each placement
+        "_key_traces",
+
+        # the packets received by the cores of each chip
+        "_chip_received",
+
+        # the packets estimated to have passed through each router
+        "_router_packets",
+
+        # the packets estimated to have left each chip on each link
+        "_link_packets",
+
+        # the packets dropped by each router, if known
+        "_dropped",
+
+        # the machine, for the heatmaps
+        "_machine"
+    ]
+
+    def __init__(self, placements, key_traces, machine=None,
+                 router_tables=None, dropped=None):
+        """
+        :param placements: the placements of the machine graph
+        :param key_traces: the key traces, as get_key_traces() gives them
+        :param machine: the machine, to trace the packets over its links
+        :param router_tables: the routing tables loaded on the machine, to\
+            trace the packets over the links of the machine
+        :param dropped: the packets dropped by each router, by (x, y)
+        """
+        self._key_traces = key_traces
+        self._machine = machine
+        self._dropped = dict(dropped or {})
+        self._edge_packets = dict()
+        self._partition_packets = dict()
+        self._chip_received = dict()
+        keys = dict()
+        for placement, (trace, traced) in key_traces.items():
+            chip = (placement.x, placement.y)
+            self._chip_received[chip] = (
+                self._chip_received.get(chip, 0) + trace.n_received)
+            for (key_and_mask, partition), packets in zip(
+                    traced, trace.packets):
+                keys[partition] = key_and_mask.key
+                for edge in partition.edges:
+                    if edge.post_vertex is placement.vertex:
+                        self._edge_packets[edge] = packets
+                        break
+
+                # every receiver of a multicast gets every packet, so the
+                # packets sent are the most any receiver got
+                self._partition_packets[partition] = max(
+                    packets, self._partition_packets.get(partition, 0))
+
+        self._router_packets = dict()
+        self._link_packets = dict()
+        if machine is not None and router_tables is not None:
+            for partition, packets in self._partition_packets.items():
+                if packets > 0:
+                    self._trace_partition(
+                        placements, router_tables, partition,
+                        keys[partition], packets)
+
+    def _trace_partition(
+            self, placements, router_tables, partition, key, packets):
+        placement = placements.get_placement_of_vertex(partition.pre_vertex)
+        routers, links = trace_route(
+            self._machine, router_tables, placement.x, placement.y, key)
+        for chip in routers:
+            self._router_packets[chip] = (
+                self._router_packets.get(chip, 0) + packets)
+        for link in links:
+            self._link_packets[link] = (
+                self._link_packets.get(link, 0) + packets)
+
+    @property
+    def edge_packets(self):
+        """ The packets estimated to have been sent along each machine edge
+
+        :rtype: dict of MachineEdge to int
+        """
+        return self._edge_packets
+
+    @property
+    def partition_packets(self):
+        """ The packets estimated to have been sent by each partition
+
+        :rtype: dict of OutgoingEdgePartition to int
+        """
+        return self._partition_packets
+
+    @property
+    def chip_received(self):
+        """ The packets received by the tracing cores of each chip
+
+        :rtype: dict of (int, int) to int
+        """
+        return self._chip_received
+
+    @property
+    def router_packets(self):
+        """ The packets estimated to have passed through each router
+
+        :rtype: dict of (int, int) to int
+        """
+        return self._router_packets
+
+    @property
+    def link_packets(self):
+        """ The packets estimated to have left each chip on each link
+
+        :rtype: dict of (int, int, int) to int
+        """
+        return self._link_packets
+
+    @property
+    def dropped(self):
+        """ The packets dropped by each router read
+
+        :rtype: dict of (int, int) to int
+        """
+        return self._dropped
+
+    def heatmap(self, values):
+        """ Draw the values of the chips of the machine as a map, north up,\
+            each shaded from 1 to 9 by its share of the largest; a chip\
+            without a value is a dot
+
+        :param values: dict of (x, y) to int
+        :rtype: list of str
+        """
+        if self._machine is None:
+            return []
+        most = max(list(values.values()) + [1])
+        lines = list()
+        for y in range(self._machine.max_chip_y, -1, -1):
+            line = "{:3d} ".format(y)
+            for x in range(self._machine.max_chip_x + 1):
+                if not self._machine.is_chip_at(x, y):
+                    line += " "
+                elif values.get((x, y), 0) == 0:
+                    line += "."
+                else:
+                    line += _SHADES[
+                        (len(_SHADES) * values[x, y] - 1) // most]
+            lines.append(line.rstrip())
+        lines.append("    " + "".join(
+            str(x % 10) for x in range(self._machine.max_chip_x + 1)))
+        return lines
+
+    def write(self, report_folder):
+        """ Write the report to the report folder, if it exists
+
+        :param report_folder: the folder to write the report in, or None
+        :return: the path of the report, or None if it was not written
+        """
+        if report_folder is None or not os.path.isdir(report_folder):
+            return None
+        path = os.path.join(report_folder, KEY_TRACE_REPORT)
+        with open(path, "w") as f:
+            f.write("Multicast packets by edge, estimated from those "
+                    "counted\n\n")
+            for edge, packets in sorted(
+                    self._edge_packets.items(), key=lambda item: -item[1]):
+                f.write("{:10d} {} -> {}\n".format(
+                    packets, edge.pre_vertex.label, edge.post_vertex.label))
+
+            f.write("\nPackets by core: received, matching no edge\n\n")
+            for placement, (trace, _) in sorted(
+                    self._key_traces.items(), key=lambda item: (
+                        item[0].x, item[0].y, item[0].p)):
+                f.write("({:3d}, {:3d}, {:2d}) {:10d} {:10d} {}\n".format(
+                    placement.x, placement.y, placement.p, trace.n_received,
+                    trace.n_unmatched, placement.vertex.label))
+
+            f.write("\nPackets by chip: received by its cores, through its "
+                    "router, dropped by its router\n\n")
+            chips = set(self._chip_received)
+            chips.update(self._router_packets)
+            chips.update(self._dropped)
+            for chip in sorted(chips):
+                f.write("({:3d}, {:3d}) {:10d} {:10d} {:10}\n".format(
+                    chip[0], chip[1], self._chip_received.get(chip, 0),
+                    self._router_packets.get(chip, 0),
+                    self._dropped.get(chip, "")))
+
+            f.write("\nPackets by link, from the router tables\n\n")
+            for (x, y, link), packets in sorted(
+                    self._link_packets.items(), key=lambda item: -item[1]):
+                f.write("({:3d}, {:3d}) {:2} {:10d}\n".format(
+                    x, y, LINK_NAMES[link], packets))
+
+            busiest_links = dict()
+            for (x, y, _), packets in self._link_packets.items():
+                busiest_links[x, y] = max(
+                    packets, busiest_links.get((x, y), 0))
+            for title, values in (
+                    ("Packets through each router", self._router_packets),
+                    ("Packets on the busiest link of each chip",
+                     busiest_links),
+                    ("Packets dropped by each router", self._dropped)):
+                lines = self.heatmap(values)
+                if lines:
+                    f.write("\n{}, of at most {}\n\n".format(
+                        title, max(list(values.values()) + [0])))
+                    f.write("\n".join(lines) + "\n")
+        return path
+
+
+def trace_route(machine, router_tables, x, y, key):
+    """ Follow the packets of a key through the router tables from the chip\
+        they are sent from
+
+    :param machine: the machine
+    :param router_tables: the routing tables loaded on the machine
+    :param x: the x of the chip of the sender
+    :param y: the y of the chip of the sender
+    :param key: the key of the packets
+    :return: the (x, y) of each router the packets pass through and the\
+        (x, y, link) of each link they leave a chip on
+    :rtype: (list of (int, int), list of (int, int, int))
+    """
+    routers = list()
+    links = list()
+    seen = set([(x, y)])
+    to_visit = deque([(x, y, None)])
+    while to_visit:
+        x, y, arrived_on = to_visit.popleft()
+        routers.append((x, y))
+        out_links = _route(router_tables, x, y, key)
+        if out_links is None:
+
+            # a packet which matches no entry carries on in the direction it
+            # was going, and one sent without an entry goes nowhere
+            out_links = [] if arrived_on is None else [arrived_on]
+        for link in out_links:
+            router_link = machine.get_chip_at(x, y).router.get_link(link)
+            if router_link is None:
+                continue
+            links.append((x, y, link))
+            destination = (router_link.destination_x,
+                           router_link.destination_y)
+            if destination not in seen:
+                seen.add(destination)
+                to_visit.append(destination + (link,))
+    return routers, links
+
+
+def _route(router_tables, x, y, key):
+    """ The links of the first entry of a router table matching a key, or\
+        None if none match
+    """
+    table = router_tables.get_routing_table_for_chip(x, y)
+    if table is None:
+        return None
+    for entry in table.multicast_routing_entries:
+        if key & entry.mask == entry.routing_entry_key:
+            return list(entry.link_ids)
+    return None
+
+
+def get_key_trace_report(
+        transceiver, placements, machine_graph, routing_info, machine,
+        router_tables, report_folder=None):
+    """ Read the key traces and router drop counters of a run, and write the\
+        report of its traffic
+
+    :return: the report
+    :rtype: :py:class:`KeyTraceReport`
+    """
+    key_traces = get_key_traces(
+        transceiver, placements, machine_graph, routing_info)
+    if not any(trace.sample_period for trace, _ in key_traces.values()):
+        logger.warning(
+            "No vertex traced its keys; turn on enable in the [KeyTrace] "
+            "section of the config")
+    chips = set()
+    if router_tables is not None:
+        chips.update(
+            (table.x, table.y) for table in router_tables.routing_tables)
+    chips.update(
+        (placement.x, placement.y) for placement in placements.placements)
+    report = KeyTraceReport(
+        placements, key_traces, machine, router_tables,
+        get_dropped_packets(transceiver, chips))
+    path = report.write(report_folder)
+    if path is not None:
+        logger.info("Wrote the key trace report to {}".format(path))
+    return report
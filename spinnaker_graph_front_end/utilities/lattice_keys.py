@@ -0,0 +1,136 @@
+""" Keys for the vertices of a 2D lattice which encode their coordinates in\
+    Morton (Z) order, so that a square block of vertices whose packets take\
+    the same route through a chip can share one masked router entry once\
+    the routing tables are compressed
+"""
+from pacman.model.constraints.key_allocator_constraints \
+    import FixedKeyAndMaskConstraint
+from pacman.model.routing_info import BaseKeyAndMask
+
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+
+def _bits_for(n_values):
+    """ The number of bits needed to tell n_values values apart
+    """
+    return max(0, int(n_values - 1).bit_length())
+
+
+def morton_encode(x, y):
+    """ Interleave the bits of x and y, x in the even bits and y in the odd
+
+    :rtype: int
+    """
+    code = 0
+    bit = 0
+    while (x >> bit) or (y >> bit):
+        code |= ((x >> bit) & 1) << (2 * bit)
+        code |= ((y >> bit) & 1) << (2 * bit + 1)
+        bit += 1
+    return code
+
+
+def morton_decode(code):
+    """ Split a Morton code back into x and y
+
+    :rtype: (int, int)
+    """
+    x = 0
+    y = 0
+    bit = 0
+    while code >> (2 * bit):
+        x |= ((code >> (2 * bit)) & 1) << bit
+        y |= ((code >> (2 * bit + 1)) & 1) << bit
+        bit += 1
+    return x, y
+
+
+def morton_order(coordinates):
+    """ Sort (x, y) coordinates into Morton order, so that vertices added to\
+        the graph in this order are placed in square blocks
+
+    :type coordinates: iterable of (int, int)
+    :rtype: list of (int, int)
+    """
+    return sorted(coordinates, key=lambda xy: morton_encode(xy[0], xy[1]))
+
+
+class LatticeKeys(object):
+    """ The keys of the vertices of a width by height lattice: the base key,\
+        then the Morton code of the coordinates of the vertex, then the\
+        bits of the keys of each vertex
+    """
+
+    __slots__ = [
+        # The first key of the lattice
+        "_base_key",
+
+        # The number of bits of the keys of each vertex
+        "_key_bits",
+
+        # The number of bits of each coordinate
+        "_coordinate_bits"
+    ]
+
+    def __init__(self, width, height, keys_per_vertex=1, base_key=0):
+        """
+        :param width: the number of vertices across the lattice
+        :param height: the number of vertices up the lattice
+        :param keys_per_vertex: the number of keys each vertex sends with
+        :param base_key: the first key of the lattice, which must be clear\
+            in the bits used by the vertices
+        :raise ConfigurationException: if the keys do not fit in 32 bits
+        """
+        self._key_bits = _bits_for(keys_per_vertex)
+        self._coordinate_bits = _bits_for(max(width, height))
+        n_bits = self._key_bits + 2 * self._coordinate_bits
+        if n_bits > 32 or (base_key & ((1 << n_bits) - 1)) != 0:
+            raise ConfigurationException(
+                "A {} by {} lattice with {} keys per vertex does not fit "
+                "under base key 0x{:08x}".format(
+                    width, height, keys_per_vertex, base_key))
+        self._base_key = base_key
+
+    @property
+    def mask(self):
+        """ The mask of the keys of one vertex
+        """
+        return (0xFFFFFFFF << self._key_bits) & 0xFFFFFFFF
+
+    def key(self, x, y):
+        """ The first key of the vertex at (x, y)
+        """
+        return self._base_key | (morton_encode(x, y) << self._key_bits)
+
+    def coordinates(self, key):
+        """ The coordinates of the vertex sending a key of the lattice
+
+        :rtype: (int, int)
+        """
+        return morton_decode(
+            (key & ~self._base_key & 0xFFFFFFFF) >> self._key_bits)
+
+    def block_key_and_mask(self, x, y, level):
+        """ The key and mask matching the keys of the 2^level by 2^level\
+            block of vertices containing (x, y); this is the entry a\
+            compressed routing table can use for the whole block
+
+        :rtype: (int, int)
+        """
+        block_bits = self._key_bits + 2 * level
+        mask = (0xFFFFFFFF << block_bits) & 0xFFFFFFFF
+        return self.key(x, y) & mask, mask
+
+    def add_constraint(self, machine_graph, vertex, partition_id, x, y):
+        """ Fix the keys of the partition of a vertex to those of its\
+            coordinates; called once the edges of the vertex are added
+
+        :param machine_graph: the graph holding the vertex
+        :param vertex: the vertex at (x, y)
+        :param partition_id: the partition sending its keys
+        """
+        partition = machine_graph.\
+            get_outgoing_edge_partition_starting_at_vertex(
+                vertex, partition_id)
+        partition.add_constraint(FixedKeyAndMaskConstraint(
+            [BaseKeyAndMask(self.key(x, y), self.mask)]))
@@ -0,0 +1,68 @@
+from pacman.model.graphs.common import Slice
+
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+import bisect
+
+
+class NodeSlicing(object):
+    """ The contiguous slices of the nodes of a graph handled by each\
+        vertex, numbered from 0
+    """
+
+    __slots__ = [
+        # The first node of each slice
+        "_lo_atoms",
+
+        # The slices, by vertex index
+        "_slices",
+
+        # The vertices handling each slice, once made
+        "_vertices"
+    ]
+
+    def __init__(self, n_nodes, nodes_per_core=None, lo_atoms=None):
+        """
+        :param n_nodes: the number of nodes of the graph
+        :param nodes_per_core: the number of nodes in each slice but the\
+            last, if the slices are not given
+        :param lo_atoms: the first node of each slice, starting with 0 in\
+            increasing order, such as those planned by plan_rebalance()
+        """
+        if lo_atoms is None:
+            lo_atoms = range(0, n_nodes, nodes_per_core)
+        self._lo_atoms = list(lo_atoms)
+        if (not self._lo_atoms or self._lo_atoms[0] != 0 or any(
+                lo_atom >= hi_atom for lo_atom, hi_atom in zip(
+                    self._lo_atoms, self._lo_atoms[1:] + [n_nodes]))):
+            raise ConfigurationException(
+                "The slices of {} nodes must start at 0 and each hold at "
+                "least one node".format(n_nodes))
+        self._slices = [
+            Slice(lo_atom, hi_atom - 1) for lo_atom, hi_atom in zip(
+                self._lo_atoms, self._lo_atoms[1:] + [n_nodes])]
+        self._vertices = list()
+
+    @property
+    def n_slices(self):
+        return len(self._slices)
+
+    def get_slice(self, index):
+        return self._slices[index]
+
+    @property
+    def slices(self):
+        return list(self._slices)
+
+    def nodes_of(self, index):
+        vertex_slice = self._slices[index]
+        return range(vertex_slice.lo_atom, vertex_slice.hi_atom + 1)
+
+    def index_of(self, node):
+        """ Get the index of the slice containing a node
+        """
+        return bisect.bisect_right(self._lo_atoms, node) - 1
+
+    @property
+    def vertices(self):
+        return self._vertices
@@ -0,0 +1,212 @@
+from collections import OrderedDict
+import sys
+
+try:
+    import resource
+except ImportError:
+    # Not available on Windows
+    resource = None
+
+
+def get_peak_memory_kb():
+    """ Get the peak memory used by this process in KiB, or None if it\
+        cannot be found on this platform
+    """
+    if resource is None:
+        return None
+    peak = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    if sys.platform == "darwin":
+        # Reported in bytes rather than KiB
+        peak //= 1024
+    return peak
+
+
+class AlgorithmTiming(object):
+    """ The time taken by one algorithm of the tool chain
+    """
+
+    __slots__ = [
+        # The name of the algorithm
+        "_name",
+
+        # The seconds it took
+        "_seconds",
+
+        # "pre_run" or "post_run" if it was added by the user through the
+        # extra algorithms of setup(), or None
+        "_extra"
+    ]
+
+    def __init__(self, name, seconds, extra=None):
+        self._name = name
+        self._seconds = seconds
+        self._extra = extra
+
+    @property
+    def name(self):
+        return self._name
+
+    @property
+    def seconds(self):
+        return self._seconds
+
+    @property
+    def extra(self):
+        """ "pre_run" or "post_run" for the extra algorithms given to\
+            setup(), or None for the algorithms of the tool chain
+        """
+        return self._extra
+
+    def to_dict(self):
+        return OrderedDict([
+            ("name", self._name), ("seconds", self._seconds),
+            ("extra", self._extra)])
+
+
+class PhaseTiming(object):
+    """ The time and memory taken by one phase of a run
+    """
+
+    __slots__ = [
+        # The name of the phase
+        "_name",
+
+        # The seconds spent in the phase
+        "_seconds",
+
+        # The peak memory of the process after the phase, in KiB
+        "_peak_memory_kb",
+
+        # How much the peak memory grew in the phase, in KiB
+        "_memory_growth_kb",
+
+        # The algorithms run in the phase, as AlgorithmTiming
+        "_algorithms"
+    ]
+
+    def __init__(self, name):
+        self._name = name
+        self._seconds = 0.0
+        self._peak_memory_kb = None
+        self._memory_growth_kb = None
+        self._algorithms = list()
+
+    @property
+    def name(self):
+        return self._name
+
+    @property
+    def seconds(self):
+        return self._seconds
+
+    @property
+    def peak_memory_kb(self):
+        return self._peak_memory_kb
+
+    @property
+    def memory_growth_kb(self):
+        return self._memory_growth_kb
+
+    @property
+    def algorithms(self):
+        return self._algorithms
+
+    def add_time(self, seconds, peak_memory_before_kb, peak_memory_kb):
+        """ Add time spent in the phase; a phase may be entered more than\
+            once in a run
+        """
+        self._seconds += seconds
+        self._peak_memory_kb = peak_memory_kb
+        if peak_memory_kb is not None and peak_memory_before_kb is not None:
+            self._memory_growth_kb = (self._memory_growth_kb or 0) + (
+                peak_memory_kb - peak_memory_before_kb)
+
+    def add_algorithm(self, algorithm_timing):
+        self._algorithms.append(algorithm_timing)
+
+    def to_dict(self):
+        return OrderedDict([
+            ("seconds", self._seconds),
+            ("peak_memory_kb", self._peak_memory_kb),
+            ("memory_growth_kb", self._memory_growth_kb),
+            ("algorithms", [
+                algorithm.to_dict() for algorithm in self._algorithms])])
+
+
+class PhaseTimingReport(object):
+    """ Where the time of a run went: building the graph, mapping, data\
+        generation, loading, running and extraction, each with the\
+        algorithms run in it and the memory used
+    """
+
+    __slots__ = [
+        # The phases in the order they were entered, by name
+        "_phases"
+    ]
+
+    def __init__(self):
+        self._phases = OrderedDict()
+
+    def phase(self, name):
+        """ Get a phase of the report, adding it if not there
+
+        :rtype: :py:class:`PhaseTiming`
+        """
+        if name not in self._phases:
+            self._phases[name] = PhaseTiming(name)
+        return self._phases[name]
+
+    @property
+    def phases(self):
+        """ The phases in the order they were entered
+
+        :rtype: iterable of :py:class:`PhaseTiming`
+        """
+        return self._phases.values()
+
+    def __contains__(self, name):
+        return name in self._phases
+
+    def __getitem__(self, name):
+        return self._phases[name]
+
+    @property
+    def total_seconds(self):
+        return sum(phase.seconds for phase in self._phases.values())
+
+    @property
+    def seconds_by_phase(self):
+        """ The seconds spent in each phase, by name
+        """
+        return OrderedDict(
+            (name, phase.seconds) for name, phase in self._phases.items())
+
+    @property
+    def extra_algorithms(self):
+        """ The timings of the extra pre- and post-run algorithms given to\
+            setup()
+        """
+        return [
+            algorithm for phase in self._phases.values()
+            for algorithm in phase.algorithms if algorithm.extra is not None]
+
+    def to_dict(self):
+        """ Get the report as a dictionary, ready to be written as JSON
+        """
+        return OrderedDict(
+            (name, phase.to_dict()) for name, phase in self._phases.items())
+
+    def __str__(self):
+        lines = list()
+        for phase in self._phases.values():
+            lines.append("{:<20} {:10.3f}s{}".format(
+                phase.name, phase.seconds,
+                "" if phase.peak_memory_kb is None else
+                "  peak memory {} KiB".format(phase.peak_memory_kb)))
+            for algorithm in phase.algorithms:
+                lines.append("    {:<30} {:10.3f}s{}".format(
+                    algorithm.name, algorithm.seconds,
+                    "" if algorithm.extra is None else
+                    " ({})".format(algorithm.extra)))
+        lines.append("{:<20} {:10.3f}s".format("total", self.total_seconds))
+        return "\n".join(lines)
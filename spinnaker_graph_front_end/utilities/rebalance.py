@@ -0,0 +1,235 @@
+""" Re-splitting the contiguous slices of elements (nodes, cells, ...) of\
+    a workload between runs, from the tick costs measured on the machine,\
+    so that the slowest core comes closer to the average one
+"""
+import logging
+
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+logger = logging.getLogger(__name__)
+
+# The number of halvings of the search for the cost of the slowest slice
+_N_SEARCH_STEPS = 60
+
+
+class Rebalancing(object):
+    """ New slices of a workload, with the costs measured of the old ones\
+        and those predicted of the new ones
+    """
+
+    __slots__ = [
+        # The first element of each new slice
+        "_lo_atoms",
+
+        # The cycles per tick measured of each old slice
+        "_measured_cycles",
+
+        # The cycles per tick predicted of each new slice
+        "_predicted_cycles",
+
+        # The packets lost by the cores of the old slices
+        "_n_lost_packets"
+    ]
+
+    def __init__(self, lo_atoms, measured_cycles, predicted_cycles,
+                 n_lost_packets=0):
+        self._lo_atoms = lo_atoms
+        self._measured_cycles = measured_cycles
+        self._predicted_cycles = predicted_cycles
+        self._n_lost_packets = n_lost_packets
+
+    @property
+    def lo_atoms(self):
+        """ The first element of each new slice, to make a NodeSlicing
+        """
+        return list(self._lo_atoms)
+
+    @property
+    def n_slices(self):
+        return len(self._lo_atoms)
+
+    @property
+    def measured_max_cycles(self):
+        return max(self._measured_cycles)
+
+    @property
+    def measured_mean_cycles(self):
+        return sum(self._measured_cycles) / float(len(self._measured_cycles))
+
+    @property
+    def predicted_max_cycles(self):
+        return max(self._predicted_cycles)
+
+    @property
+    def predicted_mean_cycles(self):
+        return (sum(self._predicted_cycles) /
+                float(len(self._predicted_cycles)))
+
+    @property
+    def measured_imbalance(self):
+        """ How much slower the slowest old slice was than the mean one, as\
+            a fraction of the mean
+        """
+        return _imbalance(self._measured_cycles)
+
+    @property
+    def predicted_imbalance(self):
+        """ How much slower the slowest new slice is expected to be than the\
+            mean one, as a fraction of the mean
+        """
+        return _imbalance(self._predicted_cycles)
+
+    @property
+    def n_lost_packets(self):
+        """ The packets the old slices lost; if any were, the costs measured\
+            are those of an overloaded run rather than a healthy one
+        """
+        return self._n_lost_packets
+
+    @property
+    def is_worthwhile(self):
+        """ Whether the new slices are expected to shorten the slowest tick
+        """
+        return self.predicted_max_cycles < self.measured_max_cycles
+
+    def __str__(self):
+        return (
+            "{} slices; slowest tick {:.0f} cycles, {:.0%} above the mean, "
+            "expected to become {:.0f} cycles, {:.0%} above the mean".format(
+                self.n_slices, self.measured_max_cycles,
+                self.measured_imbalance, self.predicted_max_cycles,
+                self.predicted_imbalance))
+
+
+def _imbalance(cycles):
+    mean = sum(cycles) / float(len(cycles))
+    if mean == 0:
+        return 0.0
+    return max(cycles) / mean - 1.0
+
+
+def get_vertex_cycles(tick_profiles, vertices):
+    """ Get the cost of the slowest tick of each of some vertices, and the\
+        packets they lost, from the tick profiles of a run
+
+    :param tick_profiles: dict of placement to TickProfile, as from\
+        get_tick_profiles()
+    :param vertices: the vertices, in the order of their slices
+    :return: the cycles of each vertex, and the total packets lost
+    :rtype: (list of int, int)
+    :raise ConfigurationException: if a vertex has no profile
+    """
+    profiles = {
+        placement.vertex: profile
+        for placement, profile in tick_profiles.items()}
+    cycles = list()
+    n_lost_packets = 0
+    for vertex in vertices:
+        if vertex not in profiles:
+            raise ConfigurationException(
+                "{} has not measured its ticks, so cannot be "
+                "rebalanced".format(vertex))
+        cycles.append(profiles[vertex].max_tick_cycles)
+        n_lost_packets += profiles[vertex].n_lost_packets
+    return cycles, n_lost_packets
+
+
+def _cut(runs, capacity, max_slices, max_atoms):
+    """ Greedily cut runs of elements of equal cost into as few slices as\
+        keep each within a capacity
+
+    :param runs: the (number of elements, cost of each) of each run
+    :return: the first element of each slice and the cost of each, or\
+        None if more than max_slices are needed
+    """
+    lo_atoms = [0]
+    costs = [0.0]
+    n_atoms = 0
+    atom = 0
+    for run_atoms, cost in runs:
+        while run_atoms > 0:
+            space = min(run_atoms, max_atoms - n_atoms)
+            if cost > 0:
+                space = min(space, int((capacity - costs[-1]) / cost))
+
+            # a slice holds at least one element, whatever it costs
+            if space <= 0 and n_atoms == 0:
+                space = 1
+            if space <= 0:
+                if len(lo_atoms) == max_slices:
+                    return None
+                lo_atoms.append(atom)
+                costs.append(0.0)
+                n_atoms = 0
+                continue
+            costs[-1] += space * cost
+            n_atoms += space
+            atom += space
+            run_atoms -= space
+    return lo_atoms, costs
+
+
+def plan_rebalance(
+        slices, cycles, base_cycles, n_slices=None, max_atoms=None,
+        n_lost_packets=0):
+    """ Plan new contiguous slices of the elements of some slices, so that\
+        the most cycles any slice is predicted to take is as small as can\
+        be.  The cycles above the base that each old slice took are shared\
+        equally by its elements, and the new slices are cut where the\
+        running total of these costs crosses each share.
+
+    :param slices: the old slices, contiguous from element 0
+    :type slices: list of Slice
+    :param cycles: the CPU cycles of the slowest tick of each old slice
+    :param base_cycles: the cycles of a tick of a core holding no elements
+    :param n_slices: the most new slices, or None for as many as the old
+    :param max_atoms: the most elements a new slice can hold, e.g. as\
+        limited by its DTCM, or None for no limit
+    :param n_lost_packets: the packets lost by the old slices
+    :rtype: :py:class:`Rebalancing`
+    :raise ConfigurationException: \
+        if the elements cannot fit in n_slices of max_atoms
+    """
+    if len(slices) != len(cycles) or not slices:
+        raise ConfigurationException(
+            "A cost is needed for each of the slices")
+    if n_slices is None:
+        n_slices = len(slices)
+    n_atoms = sum(vertex_slice.n_atoms for vertex_slice in slices)
+    if max_atoms is None:
+        max_atoms = n_atoms
+    if n_slices * max_atoms < n_atoms:
+        raise ConfigurationException(
+            "{} elements cannot fit in {} slices of at most {}".format(
+                n_atoms, n_slices, max_atoms))
+
+    runs = [
+        (vertex_slice.n_atoms,
+         max(cost - base_cycles, 0) / float(vertex_slice.n_atoms))
+        for vertex_slice, cost in zip(slices, cycles)]
+
+    # search for the smallest cost of the slowest slice which can be met
+    low = max(cost for _, cost in runs)
+    high = sum(run_atoms * cost for run_atoms, cost in runs) * (1 + 1e-9)
+    best = _cut(runs, high, n_slices, max_atoms)
+    for _ in range(_N_SEARCH_STEPS):
+        if high - low <= max(high * 1e-9, 1e-9):
+            break
+        middle = (low + high) / 2.0
+        cut = _cut(runs, middle, n_slices, max_atoms)
+        if cut is None:
+            low = middle
+        else:
+            high = middle
+            best = cut
+
+    lo_atoms, costs = best
+    rebalancing = Rebalancing(
+        lo_atoms, [float(cost) for cost in cycles],
+        [base_cycles + cost for cost in costs], n_lost_packets)
+    if n_lost_packets:
+        logger.warning(
+            "{} packets were lost while the costs were measured, so the "
+            "rebalancing may not be right".format(n_lost_packets))
+    logger.info("Rebalanced to {}".format(rebalancing))
+    return rebalancing
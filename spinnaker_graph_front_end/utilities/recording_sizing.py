@@ -0,0 +1,175 @@
+""" Sizing of recording regions from what is recorded per tick and how long\
+    the run is, rather than reserving the largest buffer for every region
+"""
+from spinn_front_end_common.interface.buffer_management \
+    import recording_utilities
+from spinn_front_end_common.utilities import constants
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.abstract_models \
+    import AbstractHasRecordingSizing
+
+
+class RecordingSizing(object):
+    """ The SDRAM and buffering thresholds of the recording regions of a\
+        vertex, all worked out from the bytes each region records per tick
+    """
+
+    __slots__ = [
+        # The most bytes each region records in a tick
+        "_bytes_per_tick",
+
+        # The number of ticks to be run, or None if running forever
+        "_n_machine_time_steps",
+
+        # The number of bytes recorded before the host is asked to read the
+        # data, or None if recording is not buffered
+        "_buffer_size_before_receive",
+
+        # The fewest ticks between requests to the host to read the data
+        "_time_between_requests"
+    ]
+
+    def __init__(
+            self, bytes_per_tick, n_machine_time_steps,
+            buffer_size_before_receive, time_between_requests):
+        """
+        :param bytes_per_tick: the most bytes each region records in a tick
+        :type bytes_per_tick: list of int
+        :param n_machine_time_steps: the number of ticks to be run, or None\
+            if running forever
+        :param buffer_size_before_receive: the configured threshold at which\
+            the host is asked to read the data, or None if recording is not\
+            buffered
+        :param time_between_requests: the fewest ticks between requests to\
+            the host to read the data
+        """
+        self._bytes_per_tick = list(bytes_per_tick)
+        self._n_machine_time_steps = n_machine_time_steps
+        self._buffer_size_before_receive = buffer_size_before_receive
+        self._time_between_requests = time_between_requests
+
+    @property
+    def buffered(self):
+        return self._buffer_size_before_receive is not None
+
+    @property
+    def n_machine_time_steps(self):
+        """ The number of ticks the regions are sized for, or None if\
+            running forever
+        """
+        return self._n_machine_time_steps
+
+    def holds_run(self, n_machine_time_steps):
+        """ Whether the regions can hold all the ticks of a run; those read\
+            by the host during the run, or sized as the largest buffer, can\
+            hold any number, but the others only those they are sized for
+
+        :param n_machine_time_steps: the total number of ticks of the run,\
+            or None if running forever
+        :rtype: bool
+        """
+        if self.buffered or self._n_machine_time_steps is None:
+            return True
+        return (n_machine_time_steps is not None and
+                n_machine_time_steps <= self._n_machine_time_steps)
+
+    @property
+    def region_sizes(self):
+        """ The size of each recording region in bytes; enough for the whole\
+            run, or at most the largest buffer if the data is read during the\
+            run
+        """
+        if self._n_machine_time_steps is None:
+            return [constants.MAX_SIZE_OF_BUFFERED_REGION_ON_CHIP
+                    for _ in self._bytes_per_tick]
+        sizes = [n_bytes * self._n_machine_time_steps
+                 for n_bytes in self._bytes_per_tick]
+        if self.buffered:
+            sizes = [min(size, constants.MAX_SIZE_OF_BUFFERED_REGION_ON_CHIP)
+                     for size in sizes]
+        return sizes
+
+    @property
+    def sdram_size(self):
+        """ The total size of the recording regions in bytes
+        """
+        return sum(self.region_sizes)
+
+    @property
+    def buffer_size_before_receive(self):
+        """ The number of bytes recorded before the host is asked to read\
+            them; low enough that the ticks before the host can next be\
+            asked do not overflow the smallest region, or None if the\
+            recording is not buffered
+        """
+        if not self.buffered:
+            return None
+        headroom = min(
+            size - (n_bytes * self._time_between_requests)
+            for size, n_bytes in zip(self.region_sizes, self._bytes_per_tick))
+        return max(
+            min(self._buffer_size_before_receive, headroom),
+            max(self._bytes_per_tick))
+
+    @property
+    def minimum_buffer_sdram_usage(self):
+        """ The fewest bytes the regions can work with while the host reads\
+            them during the run; enough for twice the ticks between requests\
+            to the host, or the whole run if that is shorter
+        """
+        minimum = sum(
+            n_bytes * 2 * self._time_between_requests
+            for n_bytes in self._bytes_per_tick)
+        if self._n_machine_time_steps is None:
+            return minimum
+        return min(self.sdram_size, minimum)
+
+    def get_n_timesteps_in_buffer_space(self, buffer_space):
+        """ The number of ticks that can be recorded in some space
+        """
+        return recording_utilities.get_n_timesteps_in_buffer_space(
+            buffer_space, self._bytes_per_tick)
+
+    def get_recording_resources(self, buffering_ip_address, buffering_port):
+        """ The resources of the recording regions
+        """
+        return recording_utilities.get_recording_resources(
+            self.region_sizes, buffering_ip_address, buffering_port)
+
+    def get_recording_header_array(self, iptags):
+        """ The header of the recording regions to write to the data\
+            specification
+        """
+        return recording_utilities.get_recording_header_array(
+            self.region_sizes, self._time_between_requests,
+            self.buffer_size_before_receive, iptags)
+
+
+def check_recording_sizes(vertices, n_machine_time_steps):
+    """ Check that the recording regions already written for vertices can\
+        hold a run; the regions of an earlier run are not sized again when\
+        the graph has not changed, so a longer run would lose data
+
+    :param vertices: the machine vertices to check
+    :param n_machine_time_steps: the total number of ticks of the run,\
+        including those of the earlier runs, or None if running forever
+    :raise ConfigurationException: if any of the regions cannot hold the run
+    """
+    too_small = list()
+    for vertex in vertices:
+        if isinstance(vertex, AbstractHasRecordingSizing):
+            sizing = vertex.recording_sizing
+            if sizing is not None and not sizing.holds_run(
+                    n_machine_time_steps):
+                too_small.append(vertex)
+    if too_small:
+        n_sized = too_small[0].recording_sizing.n_machine_time_steps
+        raise ConfigurationException(
+            "The recording of {} was sized for {} ticks, too few for {}; "
+            "run for at most {} ticks in total, or enable buffered "
+            "recording".format(
+                ", ".join(vertex.label for vertex in too_small), n_sized,
+                "a run forever" if n_machine_time_steps is None
+                else "a run of {} ticks".format(n_machine_time_steps),
+                n_sized))
@@ -0,0 +1,373 @@
+""" Global sums, minima and maxima computed on the machine by a tree of\
+    aggregator cores, one per chip and one per board, so that a single\
+    number does not have to be pulled from every vertex to be combined on\
+    the host, and so that a run can end once every vertex says it is done\
+    (see reduction.h)
+"""
+from pacman.model.constraints.placer_constraints import ChipAndCoreConstraint
+from pacman.model.graphs.machine import MachineEdge
+
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.abstract_models \
+    import AbstractReductionContributor
+
+from collections import OrderedDict
+from enum import Enum
+
+# The ways values can be combined, as in reduction.h
+ReductionOperation = Enum(
+    value="ReductionOperation",
+    names=[("SUM", 0), ("MIN", 1), ("MAX", 2)])
+
+# The partition contributors and aggregators send their values on
+REDUCTION_PARTITION_ID = "REDUCTION"
+
+# The partition the root sends the results back to the contributors on
+RESULT_PARTITION_ID = "REDUCTION_RESULT"
+
+# The most reductions a tree can carry, as in reduction.h
+MAX_REDUCTIONS = 8
+
+# key, period, n reductions, has results, result key, result mask,
+# completion reduction
+CONTRIBUTOR_REGION_SIZE = 7 * 4
+
+
+class ChipPlan(object):
+    """ The contributors to put on a chip of a reduction tree
+    """
+
+    __slots__ = [
+        # The coordinates of the chip
+        "_x", "_y",
+
+        # The coordinates of the Ethernet chip of its board
+        "_board",
+
+        # The number of contributors on the chip
+        "_n_contributors"
+    ]
+
+    def __init__(self, x, y, board, n_contributors):
+        self._x = x
+        self._y = y
+        self._board = board
+        self._n_contributors = n_contributors
+
+    @property
+    def x(self):
+        return self._x
+
+    @property
+    def y(self):
+        return self._y
+
+    @property
+    def board(self):
+        return self._board
+
+    @property
+    def n_contributors(self):
+        return self._n_contributors
+
+
+def plan_reduction_tree(chips, n_contributors, contributors_per_chip=None):
+    """ Share contributors between chips, filling a board at a time, and\
+        leaving a core on each chip used for its aggregator and another on\
+        each Ethernet chip for the aggregator of the board
+
+    :param chips: (x, y, n_application_cores, (ethernet x, ethernet y)) of\
+        each chip that can be used
+    :param n_contributors: the number of contributors
+    :param contributors_per_chip: the most contributors to put on a chip,\
+        or None to fill each chip
+    :rtype: list of :py:class:`ChipPlan`
+    :raise ConfigurationException: if the contributors do not fit
+    """
+    plans = list()
+    remaining = n_contributors
+    for x, y, n_cores, board in sorted(
+            chips, key=lambda chip: (chip[3], chip[0], chip[1])):
+        if remaining == 0:
+            break
+        capacity = n_cores - 1
+        if (x, y) == board:
+            capacity -= 1
+        if contributors_per_chip is not None:
+            capacity = min(capacity, contributors_per_chip)
+        n_on_chip = min(capacity, remaining)
+        if n_on_chip > 0:
+            plans.append(ChipPlan(x, y, board, n_on_chip))
+            remaining -= n_on_chip
+    if remaining > 0:
+        raise ConfigurationException(
+            "Cannot fit {} contributors to a reduction tree on the machine"
+            .format(n_contributors))
+    return plans
+
+
+class ReductionTree(object):
+    """ A tree of aggregators combining a value from each contributor every\
+        period ticks.  Each chip with contributors has an aggregator, whose\
+        results are combined by an aggregator on the Ethernet chip of the\
+        board; the aggregator of the first board is the root, which records\
+        the results for the host and can send them back to every\
+        contributor.  The contributors are constrained to the chips of\
+        their aggregators.
+
+        A tree with completion has an extra reduction, the minimum of\
+        whether each contributor is done; once every contributor is done in\
+        the same period, the root tells the contributors and aggregators,\
+        which all exit, ending a run_until_complete() run.  An aggregator\
+        missing a value from any child in a period passes on "not done",\
+        so a lost packet delays the end rather than ending the run early.
+    """
+
+    __slots__ = [
+        # The vertices contributing values
+        "_contributors",
+
+        # The operation of each reduction
+        "_operations",
+
+        # The number of ticks between contributions
+        "_period",
+
+        # Whether the results are sent back to the contributors
+        "_deliver_results",
+
+        # The label of the tree
+        "_label",
+
+        # The index of the reduction saying whether every contributor is
+        # done, or None if the tree does not end the run
+        "_completion_reduction",
+
+        # The aggregators of the tree, once added to the graph
+        "_aggregators",
+
+        # The root aggregator, once added to the graph
+        "_root"
+    ]
+
+    def __init__(
+            self, contributors, operations, period=1, deliver_results=False,
+            label="reduction", completion=False):
+        """
+        :param contributors: the vertices contributing values
+        :type contributors: list of AbstractReductionContributor
+        :param operations: the operation of each reduction
+        :type operations: list of ReductionOperation
+        :param period: the number of ticks between contributions
+        :param deliver_results: True to send the results back to every\
+            contributor as well as recording them
+        :param label: the label of the tree
+        :param completion: True to add a reduction of whether every\
+            contributor is done, which ends the run when it is; the results\
+            are then always sent back
+        """
+        operations = list(operations)
+        self._completion_reduction = None
+        if completion:
+            self._completion_reduction = len(operations)
+            operations.append(ReductionOperation.MIN)
+            deliver_results = True
+        if not 0 < len(operations) <= MAX_REDUCTIONS:
+            raise ConfigurationException(
+                "A reduction tree carries between 1 and {} reductions"
+                .format(MAX_REDUCTIONS))
+        if period < 1:
+            raise ConfigurationException(
+                "The period of a reduction tree must be at least 1 tick")
+        self._contributors = list(contributors)
+        self._operations = operations
+        self._period = period
+        self._deliver_results = deliver_results
+        self._label = label
+        self._aggregators = list()
+        self._root = None
+        for contributor in self._contributors:
+            if not isinstance(contributor, AbstractReductionContributor):
+                raise ConfigurationException(
+                    "{} does not contribute to reductions".format(
+                        contributor))
+            contributor.set_reduction_tree(self)
+
+    @property
+    def contributors(self):
+        return self._contributors
+
+    @property
+    def operations(self):
+        return self._operations
+
+    @property
+    def n_reductions(self):
+        return len(self._operations)
+
+    @property
+    def period(self):
+        return self._period
+
+    @property
+    def deliver_results(self):
+        return self._deliver_results
+
+    @property
+    def label(self):
+        return self._label
+
+    @property
+    def completion_reduction(self):
+        """ The index of the reduction saying whether every contributor is\
+            done, or None if the tree does not end the run
+        """
+        return self._completion_reduction
+
+    @property
+    def aggregators(self):
+        return self._aggregators
+
+    @property
+    def root(self):
+        return self._root
+
+    def add_to_graph(self, machine, add_vertex, add_edge,
+                     contributors_per_chip=None):
+        """ Place the contributors on chips and add the aggregators and the\
+            edges of the tree to the graph
+
+        :param machine: the machine the graph will run on
+        :param add_vertex: function to add a machine vertex to the graph
+        :param add_edge: function to add a machine edge to the graph, given\
+            the edge and its partition
+        :param contributors_per_chip: the most contributors to put on a\
+            chip, or None to fill each chip
+        """
+        # avoid a circular import
+        from spinnaker_graph_front_end.utility_models \
+            import ReductionAggregatorVertex, ReductionRootVertex
+
+        chips = [
+            (chip.x, chip.y,
+             len([p for p in chip.processors if not p.is_monitor]),
+             (chip.nearest_ethernet_x, chip.nearest_ethernet_y))
+            for chip in machine.chips]
+        plans = plan_reduction_tree(
+            chips, len(self._contributors), contributors_per_chip)
+
+        # an aggregator for each board, the first being the root
+        boards = OrderedDict()
+        for plan in plans:
+            if plan.board not in boards:
+                board_x, board_y = plan.board
+                if self._root is None:
+                    aggregator = ReductionRootVertex(
+                        "{}_root".format(self._label), self)
+                    self._root = aggregator
+                else:
+                    aggregator = ReductionAggregatorVertex(
+                        "{}_board_{}_{}".format(self._label, board_x, board_y),
+                        self)
+                    self._connect(aggregator, self._root, add_edge)
+                aggregator.add_constraint(
+                    ChipAndCoreConstraint(board_x, board_y))
+                boards[plan.board] = aggregator
+                self._aggregators.append(aggregator)
+                add_vertex(aggregator)
+
+        # an aggregator for each chip, and its contributors
+        contributors = iter(self._contributors)
+        for plan in plans:
+            aggregator = ReductionAggregatorVertex(
+                "{}_chip_{}_{}".format(self._label, plan.x, plan.y), self)
+            aggregator.add_constraint(ChipAndCoreConstraint(plan.x, plan.y))
+            self._aggregators.append(aggregator)
+            add_vertex(aggregator)
+            self._connect(aggregator, boards[plan.board], add_edge)
+            for _ in range(plan.n_contributors):
+                contributor = next(contributors)
+                contributor.add_constraint(
+                    ChipAndCoreConstraint(plan.x, plan.y))
+                self._connect(contributor, aggregator, add_edge)
+                if self._deliver_results:
+                    add_edge(MachineEdge(self._root, contributor),
+                             RESULT_PARTITION_ID)
+
+        # the other aggregators are told when every contributor is done
+        if self._completion_reduction is not None:
+            for aggregator in self._aggregators:
+                if aggregator is not self._root:
+                    add_edge(MachineEdge(self._root, aggregator),
+                             RESULT_PARTITION_ID)
+
+    @staticmethod
+    def _connect(child, aggregator, add_edge):
+        aggregator.add_child(child)
+        add_edge(MachineEdge(child, aggregator), REDUCTION_PARTITION_ID)
+
+    @staticmethod
+    def reserve_contributor_region(spec, region):
+        """ Reserve the reduction region of a contributor
+
+        :param spec: the data specification to write to
+        :param region: the id of the reduction region
+        """
+        spec.reserve_memory_region(
+            region=region, size=CONTRIBUTOR_REGION_SIZE, label="reduction")
+
+    def write_contributor_region(self, spec, region, contributor,
+                                 routing_info):
+        """ Write the reduction region of a contributor
+
+        :param spec: the data specification to write to
+        :param region: the id of the reduction region
+        :param contributor: the contributor
+        :param routing_info: the routing information of the machine graph
+        """
+        spec.switch_write_focus(region)
+        spec.write_value(routing_info.get_first_key_from_pre_vertex(
+            contributor, REDUCTION_PARTITION_ID))
+        spec.write_value(self._period)
+        spec.write_value(self.n_reductions)
+        self.write_result_keys(spec, routing_info)
+        spec.write_value(self.completion_parameter)
+
+    def write_result_keys(self, spec, routing_info):
+        """ Write whether the results are sent back, and the key and mask\
+            they are sent with
+
+        :param spec: the data specification to write to
+        :param routing_info: the routing information of the machine graph
+        """
+        if self._deliver_results:
+            key_and_mask = routing_info.get_routing_info_from_pre_vertex(
+                self._root, RESULT_PARTITION_ID).first_key_and_mask
+            spec.write_value(1)
+            spec.write_value(key_and_mask.key)
+            spec.write_value(key_and_mask.mask)
+        else:
+            spec.write_array([0, 0, 0])
+
+    @property
+    def completion_parameter(self):
+        """ The index + 1 of the completion reduction, or 0 if there is\
+            none, as the binaries take it
+        """
+        if self._completion_reduction is None:
+            return 0
+        return self._completion_reduction + 1
+
+    def get_results(self, buffer_manager, placements):
+        """ Get the results recorded by the root
+
+        :return: the result of each round of each reduction, by reduction
+        :rtype: list of list of int
+        """
+        records = self._root.read_records(
+            buffer_manager, placements.get_placement_of_vertex(self._root))
+        results = [list() for _ in self._operations]
+        for _, reduction, value, _ in sorted(records):
+            results[reduction].append(value)
+        return results
@@ -0,0 +1,276 @@
+""" Models of the DTCM and CPU time a binary needs, fitted to profiles\
+    measured on the machine (see tick_profiler.h)
+"""
+import json
+import logging
+import math
+import os
+
+from pacman.model.graphs.common import Slice
+from pacman.model.resources import CPUCyclesPerTickResource, DTCMResource
+
+logger = logging.getLogger(__name__)
+
+# The DTCM of a core in bytes
+DTCM_BYTES_PER_CORE = 64 * 1024
+
+# The ending of the name of a resource model saved next to a binary
+RESOURCE_MODEL_SUFFIX = ".resources.json"
+
+# The models loaded or saved so far, by absolute path
+_loaded_models = dict()
+
+
+class ResourceModel(object):
+    """ A linear model of the DTCM and the CPU cycles per timer tick a\
+        binary needs against the number of elements (cells, nodes, ...) one\
+        core of it holds
+    """
+
+    __slots__ = [
+        # The DTCM in bytes needed whatever the number of elements
+        "_dtcm_base",
+
+        # The DTCM in bytes needed for each element
+        "_dtcm_per_element",
+
+        # The CPU cycles per tick needed whatever the number of elements
+        "_cycles_base",
+
+        # The CPU cycles per tick needed for each element
+        "_cycles_per_element",
+
+        # True if fitted to measurements, False if an estimate
+        "_measured"
+    ]
+
+    def __init__(
+            self, dtcm_base, dtcm_per_element, cycles_base,
+            cycles_per_element, measured=False):
+        """
+        :param dtcm_base: the DTCM in bytes needed by the binary itself
+        :param dtcm_per_element: the DTCM in bytes needed per element
+        :param cycles_base: the CPU cycles per tick needed by the binary\
+            itself
+        :param cycles_per_element: the CPU cycles per tick needed per element
+        :param measured: True if fitted to measurements rather than estimated
+        """
+        self._dtcm_base = float(dtcm_base)
+        self._dtcm_per_element = float(dtcm_per_element)
+        self._cycles_base = float(cycles_base)
+        self._cycles_per_element = float(cycles_per_element)
+        self._measured = measured
+
+    @property
+    def dtcm_base(self):
+        return self._dtcm_base
+
+    @property
+    def dtcm_per_element(self):
+        return self._dtcm_per_element
+
+    @property
+    def cycles_base(self):
+        return self._cycles_base
+
+    @property
+    def cycles_per_element(self):
+        return self._cycles_per_element
+
+    @property
+    def measured(self):
+        """ True if the model was fitted to measurements
+        """
+        return self._measured
+
+    def dtcm_bytes(self, n_elements):
+        """ The DTCM in bytes needed by a core holding n_elements
+        """
+        return int(math.ceil(
+            self._dtcm_base + self._dtcm_per_element * n_elements))
+
+    def cycles_per_tick(self, n_elements):
+        """ The CPU cycles each tick needs on a core holding n_elements
+        """
+        return int(math.ceil(
+            self._cycles_base + self._cycles_per_element * n_elements))
+
+    def dtcm_resource(self, n_elements=1):
+        return DTCMResource(self.dtcm_bytes(n_elements))
+
+    def cpu_cycles_resource(self, n_elements=1):
+        return CPUCyclesPerTickResource(self.cycles_per_tick(n_elements))
+
+    def max_elements(
+            self, timer_period, cpu_clock_mhz, target_utilisation):
+        """ The most elements one core can hold while keeping within the\
+            target CPU utilisation and the DTCM of the core
+
+        :param timer_period: the time between ticks in microseconds, i.e.\
+            the machine time step times the time scale factor
+        :param cpu_clock_mhz: the clock speed of the cores in MHz
+        :param target_utilisation: the fraction of each tick to use, e.g. 0.8
+        :return: the number of elements, which is 0 if the binary does not\
+            fit at all
+        """
+        limits = list()
+        cycles = timer_period * cpu_clock_mhz * target_utilisation
+        limits.append(self._limit(
+            cycles, self._cycles_base, self._cycles_per_element))
+        limits.append(self._limit(
+            DTCM_BYTES_PER_CORE, self._dtcm_base, self._dtcm_per_element))
+        limits = [limit for limit in limits if limit is not None]
+        if not limits:
+            raise ValueError(
+                "The model needs no resources per element, so any number of "
+                "elements fits on a core")
+        return min(limits)
+
+    @staticmethod
+    def _limit(available, base, per_element):
+        if base > available:
+            return 0
+        if per_element <= 0:
+            return None
+        return int((available - base) // per_element)
+
+    def get_slices(
+            self, n_elements, timer_period, cpu_clock_mhz,
+            target_utilisation):
+        """ Split elements into as few cores as keep to the target CPU\
+            utilisation
+
+        :param n_elements: the number of elements to split
+        :param timer_period: the time between ticks in microseconds
+        :param cpu_clock_mhz: the clock speed of the cores in MHz
+        :param target_utilisation: the fraction of each tick to use
+        :return: list of :py:class:`Slice`, one per core
+        """
+        per_core = self.max_elements(
+            timer_period, cpu_clock_mhz, target_utilisation)
+        if per_core == 0:
+            raise ValueError(
+                "Not even one element fits on a core with a timer period of "
+                "{} us".format(timer_period))
+        return [
+            Slice(lo_atom, min(lo_atom + per_core, n_elements) - 1)
+            for lo_atom in range(0, n_elements, per_core)]
+
+    @staticmethod
+    def fit(samples):
+        """ Fit a model to measurements by least squares
+
+        :param samples: iterable of (n_elements, dtcm_used_bytes,\
+            cycles_per_tick), which must cover at least two numbers of\
+            elements
+        :rtype: :py:class:`ResourceModel`
+        """
+        samples = list(samples)
+        if len(set(n_elements for n_elements, _, _ in samples)) < 2:
+            raise ValueError(
+                "At least two different numbers of elements must be "
+                "measured to fit a model")
+        dtcm_base, dtcm_per_element = _fit_line(
+            [(n, dtcm) for n, dtcm, _ in samples])
+        cycles_base, cycles_per_element = _fit_line(
+            [(n, cycles) for n, _, cycles in samples])
+        return ResourceModel(
+            dtcm_base, dtcm_per_element, cycles_base, cycles_per_element,
+            measured=True)
+
+    def save(self, path):
+        """ Save the model as JSON; it replaces any model loaded from the\
+            same path before
+        """
+        with open(path, "w") as f:
+            json.dump({
+                "dtcm_base": self._dtcm_base,
+                "dtcm_per_element": self._dtcm_per_element,
+                "cycles_base": self._cycles_base,
+                "cycles_per_element": self._cycles_per_element,
+                "measured": self._measured}, f, indent=4, sort_keys=True)
+        _loaded_models[os.path.abspath(path)] = self
+
+    @staticmethod
+    def load(path):
+        """ Load a model saved as JSON
+        """
+        with open(path) as f:
+            values = json.load(f)
+        return ResourceModel(
+            values["dtcm_base"], values["dtcm_per_element"],
+            values["cycles_base"], values["cycles_per_element"],
+            values.get("measured", True))
+
+    def __repr__(self):
+        return (
+            "ResourceModel(dtcm={:.0f} + {:.1f}n bytes, "
+            "cycles={:.0f} + {:.1f}n per tick, {})".format(
+                self._dtcm_base, self._dtcm_per_element, self._cycles_base,
+                self._cycles_per_element,
+                "measured" if self._measured else "estimated"))
+
+
+def _fit_line(points):
+    n_points = float(len(points))
+    mean_x = sum(x for x, _ in points) / n_points
+    mean_y = sum(y for _, y in points) / n_points
+    variance = sum((x - mean_x) ** 2 for x, _ in points)
+    covariance = sum((x - mean_x) * (y - mean_y) for x, y in points)
+    gradient = max(covariance / variance, 0.0)
+    return max(mean_y - gradient * mean_x, 0.0), gradient
+
+
+def get_resource_model_path(binary_file_name, directory):
+    """ Get where the resource model of a binary is saved in a directory
+    """
+    return os.path.join(
+        directory, os.path.splitext(binary_file_name)[0] +
+        RESOURCE_MODEL_SUFFIX)
+
+
+def load_resource_model(binary_file_name, search_paths, default):
+    """ Load the resource model saved for a binary, if there is one
+
+    :param binary_file_name: the name of the binary, e.g. "conways_cell.aplx"
+    :param search_paths: the directories to look for the model in
+    :param default: the model to use if none has been saved, e.g. estimates
+    :rtype: :py:class:`ResourceModel`
+    """
+    for directory in search_paths:
+        path = os.path.abspath(
+            get_resource_model_path(binary_file_name, directory))
+        if path in _loaded_models:
+            return _loaded_models[path]
+        if os.path.isfile(path):
+            model = ResourceModel.load(path)
+            logger.info("Loaded {} for {}".format(model, binary_file_name))
+            _loaded_models[path] = model
+            return model
+    return default
+
+
+def check_resource_usage(vertices, timer_period, cpu_clock_mhz):
+    """ Warn about vertices which declare that they need more CPU time per\
+        tick or more DTCM than a core has
+
+    :param vertices: the machine vertices to check
+    :param timer_period: the time between ticks in microseconds, i.e. the\
+        machine time step times the time scale factor
+    :param cpu_clock_mhz: the clock speed of the cores in MHz
+    :return: the vertices which are overloaded
+    """
+    cycles_per_tick = timer_period * cpu_clock_mhz
+    overloaded = list()
+    for vertex in vertices:
+        resources = vertex.resources_required
+        cycles = resources.cpu_cycles.get_value()
+        dtcm = resources.dtcm.get_value()
+        if cycles > cycles_per_tick or dtcm > DTCM_BYTES_PER_CORE:
+            logger.warning(
+                "{} needs {} cycles per tick of the {} available and {} bytes"
+                " of DTCM of the {} available".format(
+                    vertex.label, cycles, cycles_per_tick, dtcm,
+                    DTCM_BYTES_PER_CORE))
+            overloaded.append(vertex)
+    return overloaded
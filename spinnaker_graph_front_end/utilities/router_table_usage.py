@@ -0,0 +1,64 @@
+""" How full the router table of each chip is, checked before the tables\
+    are loaded so that a graph which cannot be routed fails with a report\
+    rather than on the machine
+"""
+import logging
+import os
+
+logger = logging.getLogger(__name__)
+
+# The number of entries of a router table that applications can use
+MAX_ROUTER_ENTRIES = 1023
+
+# The name of the report written to the report folder
+ROUTER_TABLE_USAGE_REPORT = "router_table_usage.rpt"
+
+
+def get_router_table_usage(router_tables):
+    """ Count the entries of each router table
+
+    :param router_tables: the routing tables of the machine
+    :type router_tables: MulticastRoutingTables
+    :return: the number of entries of each chip with any, by (x, y)
+    :rtype: dict of (int, int) to int
+    """
+    return {
+        (table.x, table.y): table.number_of_entries
+        for table in router_tables.routing_tables
+        if table.number_of_entries > 0}
+
+
+def check_router_table_usage(
+        router_tables, report_folder=None, max_entries=MAX_ROUTER_ENTRIES):
+    """ Log how full the router tables are, warn about those with too many\
+        entries to load, and write the entries of each chip to a report
+
+    :param router_tables: the routing tables of the machine
+    :param report_folder: the folder to write the report in, or None
+    :param max_entries: the number of entries a table can hold
+    :return: the number of entries of each chip, by (x, y)
+    :rtype: dict of (int, int) to int
+    """
+    usage = get_router_table_usage(router_tables)
+    if not usage:
+        return usage
+    full = sorted(chip for chip, n in usage.items() if n > max_entries)
+    busiest = max(usage, key=lambda chip: usage[chip])
+    logger.info(
+        "Router tables on {} chips use {} entries, at most {} on {}".format(
+            len(usage), sum(usage.values()), usage[busiest], busiest))
+    for x, y in full:
+        logger.warning(
+            "The router table of chip ({}, {}) has {} entries, more than "
+            "the {} that fit".format(x, y, usage[x, y], max_entries))
+
+    if report_folder is not None and os.path.isdir(report_folder):
+        with open(os.path.join(
+                report_folder, ROUTER_TABLE_USAGE_REPORT), "w") as f:
+            f.write("Router table entries by chip, of {} that fit\n\n".format(
+                max_entries))
+            for (x, y), n_entries in sorted(usage.items()):
+                f.write("({:3d}, {:3d}) {:5d} {:6.1%}{}\n".format(
+                    x, y, n_entries, float(n_entries) / max_entries,
+                    " FULL" if n_entries > max_entries else ""))
+    return usage
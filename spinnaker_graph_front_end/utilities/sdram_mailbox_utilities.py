@@ -0,0 +1,134 @@
+""" Helpers for vertices which exchange data with same-chip neighbours\
+    through shared SDRAM mailboxes (see sdram_mailbox.h)
+"""
+from spinnaker_graph_front_end.utility_models import SDRAMMailboxMachineEdge
+
+# The producer writes slot (time & 1) while consumers read the other slot,
+# so that a reader never sees a half-written tick
+N_SLOTS = 2
+
+# Each slot is the time stamp, the data words and the time stamp again
+SLOT_HEADER_WORDS = 2
+
+# The time stamp of a slot not yet written, which matches no tick read
+NO_TIME = 0xFFFFFFFF
+
+# The producer region starts with the number of words per slot
+MAILBOX_HEADER_WORDS = 1
+
+# Each mailbox read is described by producer core, region id, n_words
+WORDS_PER_READ = 3
+
+# Each key filter is a key and mask
+WORDS_PER_FILTER = 2
+
+
+def get_mailbox_region_size(n_words):
+    """ Get the size of the mailbox region a producer has to reserve
+
+    :param n_words: the number of words written per timer tick
+    :return: the size in bytes
+    """
+    return (MAILBOX_HEADER_WORDS +
+            N_SLOTS * (SLOT_HEADER_WORDS + n_words)) * 4
+
+
+def get_mailbox_reads_region_size(n_incoming_edges):
+    """ Get the worst case size of the region that tells a consumer where\
+        its mailboxes are
+
+    :param n_incoming_edges: the number of edges ending at the consumer
+    :return: the size in bytes
+    """
+    return (2 + n_incoming_edges * (WORDS_PER_READ + WORDS_PER_FILTER)) * 4
+
+
+def is_sdram_edge(edge, placements):
+    """ Determine if an edge should carry its data through SDRAM
+
+    :param edge: the machine edge
+    :param placements: the placements of the machine graph
+    :rtype: bool
+    """
+    return (isinstance(edge, SDRAMMailboxMachineEdge) and
+            edge.uses_sdram(placements))
+
+
+def needs_multicast(vertex, partition_id, machine_graph, placements):
+    """ Determine if a producer still has to send multicast packets, i.e.\
+        if any of its outgoing edges reach another chip
+
+    :param vertex: the producer vertex
+    :param partition_id: the outgoing partition to check
+    :param machine_graph: the machine graph
+    :param placements: the placements of the machine graph
+    :rtype: bool
+    """
+    partition = machine_graph.get_outgoing_edge_partition_starting_at_vertex(
+        vertex, partition_id)
+    if partition is None:
+        return False
+    return any(
+        not is_sdram_edge(edge, placements) for edge in partition.edges)
+
+
+def write_mailbox_region(spec, region, n_words):
+    """ Write the header of a producer's mailbox region; the slots are\
+        filled in by the binary, and until then hold a time stamp that no\
+        read accepts
+
+    :param spec: the data specification to write to
+    :param region: the id of the mailbox region
+    :param n_words: the number of words written per timer tick
+    """
+    spec.switch_write_focus(region)
+    spec.write_value(n_words)
+    spec.write_array(get_empty_slots(n_words))
+
+
+def get_empty_slots(n_words):
+    """ Get the words of the slots of a mailbox before it is written
+
+    :param n_words: the number of words written per timer tick
+    :rtype: list of int
+    """
+    return ([NO_TIME] + [0] * n_words + [NO_TIME]) * N_SLOTS
+
+
+def write_mailbox_reads_region(
+        spec, region, vertex, partition_id, machine_graph, placements,
+        routing_info):
+    """ Write the mailboxes a consumer reads, and the keys of the producers\
+        that also transmit so the consumer can drop the duplicate packets
+
+    :param spec: the data specification to write to
+    :param region: the id of the mailbox reads region
+    :param vertex: the consumer vertex
+    :param partition_id: the partition the producers send on
+    :param machine_graph: the machine graph
+    :param placements: the placements of the machine graph
+    :param routing_info: the routing information of the machine graph
+    :return: the number of incoming edges carried through SDRAM
+    """
+    sdram_edges = [
+        edge for edge in machine_graph.get_edges_ending_at_vertex(vertex)
+        if is_sdram_edge(edge, placements)]
+
+    spec.switch_write_focus(region)
+    spec.write_value(len(sdram_edges))
+    filters = list()
+    for edge in sdram_edges:
+        producer = edge.pre_vertex
+        spec.write_value(placements.get_placement_of_vertex(producer).p)
+        spec.write_value(producer.sdram_mailbox_region_id)
+        spec.write_value(edge.n_words)
+        if needs_multicast(producer, partition_id, machine_graph, placements):
+            filters.append(routing_info.get_routing_info_from_pre_vertex(
+                producer, partition_id))
+
+    spec.write_value(len(filters))
+    for partition_routing_info in filters:
+        key_and_mask = partition_routing_info.first_key_and_mask
+        spec.write_value(key_and_mask.key)
+        spec.write_value(key_and_mask.mask)
+    return len(sdram_edges)
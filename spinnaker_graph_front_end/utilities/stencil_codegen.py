@@ -0,0 +1,199 @@
+""" Generation of a C kernel specialised to a StencilSpec, and building it\
+    into a binary which is cached by the hash of the spec, so that each\
+    stencil is only built once
+"""
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.utilities.stencil_spec import S1615, UINT8
+
+from string import Template
+import logging
+import os
+import subprocess
+
+logger = logging.getLogger(__name__)
+
+# The folder of the templates the kernels are generated from
+_C_COMMON_DIR = os.path.abspath(os.path.join(
+    os.path.dirname(__file__), os.pardir, "c_common"))
+TEMPLATE_DIR = os.path.join(_C_COMMON_DIR, "models", "stencil")
+KERNEL_TEMPLATE = "stencil_kernel.c.template"
+MAKEFILE_TEMPLATE = "Makefile.template"
+
+# The files of c_common the kernels are built with besides the templates:
+# the headers the kernel includes, and the makefile which can add the
+# tokenised logging header to the build
+BUILD_FILES = [
+    os.path.join("include", "fixed_point_kernels.h"),
+    os.path.join("include", "tick_profiler.h"),
+    os.path.join("include", "token_log.h"),
+    "Makefile.token_log"]
+
+# Where the binaries are cached if the config does not say
+DEFAULT_CACHE_FOLDER = os.path.join(
+    "~", ".spinnaker_graph_front_end", "stencil_binaries")
+
+# The number of values on each line of the generated tables
+_VALUES_PER_LINE = 12
+
+
+class _Template(Template):
+    """ A template whose fields are @{name}, which C and make leave alone
+    """
+    delimiter = "@"
+
+
+def _read_template(name):
+    with open(os.path.join(TEMPLATE_DIR, name)) as f:
+        return f.read()
+
+
+def _read_build_file(name):
+    with open(os.path.join(_C_COMMON_DIR, name)) as f:
+        return f.read()
+
+
+def _format_table(values):
+    """ The values of a C array initialiser, a line at a time
+    """
+    values = [str(value) for value in values]
+    return ",\n".join(
+        "    " + ", ".join(values[i:i + _VALUES_PER_LINE])
+        for i in range(0, len(values), _VALUES_PER_LINE))
+
+
+def _cell(dx, dy):
+    """ The C expression of the neighbour at (dx, dy) of the cell pointed to\
+        by "cell" in the padded grid
+    """
+    terms = list()
+    if dy:
+        terms.append("PADDED_WIDTH" if abs(dy) == 1 else
+                     "{} * PADDED_WIDTH".format(abs(dy)))
+        sign = "-" if dy < 0 else ""
+        terms[0] = sign + terms[0]
+    if dx:
+        if terms:
+            terms.append("{} {}".format("-" if dx < 0 else "+", abs(dx)))
+        else:
+            terms.append(str(dx))
+    return "cell[{}]".format(" ".join(terms) if terms else "0")
+
+
+def generate_rule(spec):
+    """ The C of the rule of a stencil: the tables it uses, and the body of\
+        next_state() with the neighbours unrolled
+
+    :rtype: (str, str)
+    """
+    if spec.cell_type == UINT8:
+        table = (
+            "#define N_STATES {}\n"
+            "#define N_TOTALS {}\n\n"
+            "//! the next state of a cell, by {}\n"
+            "static const uint8_t RULE[{}] = {{\n{}\n}};".format(
+                spec.n_states, spec.n_totals,
+                "its state and the sum of its neighbours" if spec.totalistic
+                else "its state and those of its neighbours",
+                len(spec.lut), _format_table(spec.lut)))
+        if spec.totalistic:
+            body = "    uint32_t total =\n        {};\n".format(
+                " +\n        ".join(
+                    _cell(dx, dy) for dx, dy in spec.neighbourhood))
+            body += "    return RULE[cell[0] * N_TOTALS + total];"
+        else:
+            body = "    uint32_t index = cell[0];\n"
+            body += "".join(
+                "    index = index * N_STATES + {};\n".format(_cell(dx, dy))
+                for dx, dy in spec.neighbourhood)
+            body += "    return RULE[index];"
+        return table, body
+
+    if spec.cell_type == S1615:
+        table = "//! the weights are baked into next_state()"
+        body = "    int64_t accumulator = (int64_t) cell[0] * {};\n".format(
+            spec.centre_weight)
+        body += "".join(
+            "    accumulator += (int64_t) {} * {};\n".format(
+                _cell(dx, dy), weight)
+            for (dx, dy), weight in zip(
+                spec.neighbourhood, spec.neighbour_weights)
+            if weight != 0)
+        body += "    return s1615_from_accumulator(accumulator);"
+        return table, body
+
+    raise ConfigurationException(
+        "Unknown cell type {}".format(spec.cell_type))
+
+
+def get_app_name(spec):
+    """ The name of the binary of a stencil, without the extension; this\
+        changes whenever the spec, the templates or the files of c_common\
+        the binary is built with change
+    """
+    salt = "".join(
+        [_read_template(KERNEL_TEMPLATE), _read_template(MAKEFILE_TEMPLATE)] +
+        [_read_build_file(name) for name in BUILD_FILES]).encode("utf-8")
+    return "stencil_" + spec.spec_hash(salt)
+
+
+def get_binary_name(spec):
+    return get_app_name(spec) + ".aplx"
+
+
+def generate_source(spec):
+    """ The C source of the kernel of a stencil
+    """
+    table, body = generate_rule(spec)
+    app_name = get_app_name(spec)
+    return _Template(_read_template(KERNEL_TEMPLATE)).substitute(
+        app_name=app_name, spec_hash=app_name[len("stencil_"):],
+        tile_width=spec.tile_width, tile_height=spec.tile_height,
+        radius=spec.radius, n_border_cells=len(spec.border_cells),
+        c_type=spec.c_type, border_cells=_format_table(spec.border_cells),
+        rule_table=table, rule_body=body)
+
+
+def generate_makefile(spec):
+    """ The Makefile building the kernel of a stencil
+    """
+    return _Template(_read_template(MAKEFILE_TEMPLATE)).substitute(
+        app_name=get_app_name(spec), gfe_c_common_dir=_C_COMMON_DIR)
+
+
+def build_stencil_binary(spec, cache_folder=None):
+    """ Build the binary of a stencil, unless it is already in the cache
+
+    :param spec: the stencil
+    :param cache_folder: the folder the binaries are cached in, or None for\
+        the default
+    :return: the folder holding the binary
+    :raise ConfigurationException: if the binary cannot be built
+    """
+    if cache_folder is None:
+        cache_folder = DEFAULT_CACHE_FOLDER
+    app_name = get_app_name(spec)
+    folder = os.path.join(
+        os.path.abspath(os.path.expanduser(cache_folder)), app_name)
+    binary = os.path.join(folder, app_name + ".aplx")
+    if os.path.isfile(binary):
+        logger.info("Using cached {} for {}".format(binary, spec))
+        return folder
+
+    if not os.path.isdir(folder):
+        os.makedirs(folder)
+    with open(os.path.join(folder, app_name + ".c"), "w") as f:
+        f.write(generate_source(spec))
+    with open(os.path.join(folder, "Makefile"), "w") as f:
+        f.write(generate_makefile(spec))
+
+    logger.info("Building {} for {}".format(binary, spec))
+    process = subprocess.Popen(
+        ["make"], cwd=folder, stdout=subprocess.PIPE,
+        stderr=subprocess.STDOUT)
+    output, _ = process.communicate()
+    if process.returncode != 0 or not os.path.isfile(binary):
+        raise ConfigurationException(
+            "Building the stencil binary in {} failed:\n{}".format(
+                folder, output.decode("utf-8", "replace")))
+    return folder
@@ -0,0 +1,177 @@
+""" A toroidal grid of cells updated by a generated stencil kernel, split\
+    into tiles of one core each which swap the cells on their borders every\
+    tick (see StencilSpec and stencil_codegen)
+"""
+from pacman.model.graphs.machine import MachineEdge
+
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.utilities.lattice_keys \
+    import LatticeKeys, morton_order
+from spinnaker_graph_front_end.utilities.stencil_spec \
+    import S1615, S1615_SCALE, to_s1615
+
+
+def get_neighbour_sides(spec):
+    """ The sides and corners of a tile, as (dx, dy) in tiles, holding cells\
+        which are neighbours of cells of the tile
+
+    :rtype: list of (int, int)
+    """
+    def _reaches(side, offset):
+        return side == 0 or (offset != 0 and (side > 0) == (offset > 0))
+
+    return [
+        (side_x, side_y)
+        for side_y in (-1, 0, 1) for side_x in (-1, 0, 1)
+        if (side_x, side_y) != (0, 0) and any(
+            _reaches(side_x, dx) and _reaches(side_y, dy)
+            for dx, dy in spec.neighbourhood)]
+
+
+class StencilGrid(object):
+    """ The tiles of a grid of cells which wraps around at its edges
+    """
+
+    __slots__ = [
+        # The stencil of the cells
+        "_spec",
+
+        # The number of tiles across and up the grid
+        "_n_tiles_x",
+        "_n_tiles_y",
+
+        # The label of the grid, from which those of the tiles are made
+        "_label",
+
+        # The initial cells of each tile, by the coordinates of the tile
+        "_initial_cells",
+
+        # The vertex of each tile, by the coordinates of the tile, once the
+        # grid is added to the graph
+        "_tiles"
+    ]
+
+    def __init__(self, spec, cells, label="stencil"):
+        """
+        :param spec: the stencil
+        :type spec: StencilSpec
+        :param cells: the initial cells as a list of rows, which must be a\
+            whole number of tiles across and up; states for UINT8 cells,\
+            numbers for S1615 cells
+        :param label: the label of the grid
+        :raise ConfigurationException: if the cells are not whole tiles
+        """
+        rows = [list(row) for row in cells]
+        height = len(rows)
+        width = len(rows[0]) if rows else 0
+        if (not width or any(len(row) != width for row in rows) or
+                width % spec.tile_width or height % spec.tile_height):
+            raise ConfigurationException(
+                "The cells must be rows of equal length, a whole number of "
+                "{} by {} tiles".format(spec.tile_width, spec.tile_height))
+        self._spec = spec
+        self._n_tiles_x = width // spec.tile_width
+        self._n_tiles_y = height // spec.tile_height
+        self._label = label
+        self._tiles = dict()
+
+        convert = to_s1615 if spec.cell_type == S1615 else int
+        self._initial_cells = dict()
+        for tile_y in range(self._n_tiles_y):
+            for tile_x in range(self._n_tiles_x):
+                self._initial_cells[tile_x, tile_y] = [
+                    convert(rows[tile_y * spec.tile_height + y]
+                            [tile_x * spec.tile_width + x])
+                    for y in range(spec.tile_height)
+                    for x in range(spec.tile_width)]
+
+    @property
+    def spec(self):
+        return self._spec
+
+    @property
+    def n_tiles_x(self):
+        return self._n_tiles_x
+
+    @property
+    def n_tiles_y(self):
+        return self._n_tiles_y
+
+    @property
+    def tiles(self):
+        """ The vertex of each tile, by the coordinates of the tile
+        """
+        return dict(self._tiles)
+
+    def add_to_graph(self, add_vertex, add_edge, machine_graph=None):
+        """ Add a vertex for each tile, and the edges carrying the cells on\
+            their borders, to the graph
+
+        :param add_vertex: function to add a machine vertex to the graph
+        :param add_edge: function to add a machine edge to the graph, given\
+            the edge and its partition
+        :param machine_graph: the graph, to fix the keys of the tiles so\
+            that neighbouring tiles can share router entries, or None to\
+            leave the keys to the key allocator
+        """
+        # avoid a circular import
+        from spinnaker_graph_front_end.utility_models \
+            import StencilTileVertex
+
+        spec = self._spec
+        coordinates = [
+            (tile_x, tile_y) for tile_x in range(self._n_tiles_x)
+            for tile_y in range(self._n_tiles_y)]
+        for tile_x, tile_y in morton_order(coordinates):
+            tile = StencilTileVertex(
+                "{}_{}_{}".format(self._label, tile_x, tile_y), spec,
+                self._initial_cells[tile_x, tile_y])
+            self._tiles[tile_x, tile_y] = tile
+            add_vertex(tile)
+
+        # the cell at (x, y) of a tile is at (x + r, y + r) of its padded
+        # grid, so that of the tile on a side is offset by the tile size
+        sending = set()
+        for (tile_x, tile_y), tile in self._tiles.items():
+            sources = set()
+            for side_x, side_y in get_neighbour_sides(spec):
+                source = self._tiles[
+                    (tile_x + side_x) % self._n_tiles_x,
+                    (tile_y + side_y) % self._n_tiles_y]
+                tile.add_incoming(
+                    source, side_x * spec.tile_width + spec.radius,
+                    side_y * spec.tile_height + spec.radius)
+                if source is not tile and source not in sources:
+                    sources.add(source)
+                    sending.add(source)
+                    add_edge(MachineEdge(source, tile),
+                             StencilTileVertex.PARTITION_ID)
+
+        if machine_graph is not None and sending:
+            keys = LatticeKeys(
+                self._n_tiles_x, self._n_tiles_y, 2 * spec.n_cells)
+            for (tile_x, tile_y), tile in self._tiles.items():
+                if tile in sending:
+                    keys.add_constraint(
+                        machine_graph, tile, StencilTileVertex.PARTITION_ID,
+                        tile_x, tile_y)
+
+    def read_cells(self, transceiver, placements):
+        """ Read the cells of the grid when the run paused
+
+        :return: the cells as a list of rows, as given to the constructor
+        """
+        spec = self._spec
+        rows = [[None] * (self._n_tiles_x * spec.tile_width)
+                for _ in range(self._n_tiles_y * spec.tile_height)]
+        for (tile_x, tile_y), tile in self._tiles.items():
+            cells = tile.read_cells(
+                transceiver, placements.get_placement_of_vertex(tile))
+            for index, value in enumerate(cells):
+                if spec.cell_type == S1615:
+                    value = value / S1615_SCALE
+                y, x = divmod(index, spec.tile_width)
+                rows[tile_y * spec.tile_height + y][
+                    tile_x * spec.tile_width + x] = value
+        return rows
@@ -0,0 +1,297 @@
+""" The description of a stencil computation over a 2D grid of cells, from\
+    which a kernel specialised to it is generated (see stencil_codegen)
+"""
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+import hashlib
+import json
+
+# The offsets of the neighbours of a cell in the common neighbourhoods
+MOORE = ((-1, -1), (0, -1), (1, -1), (-1, 0), (1, 0), (-1, 1), (0, 1), (1, 1))
+VON_NEUMANN = ((0, -1), (-1, 0), (1, 0), (0, 1))
+
+# Cells holding one of a few states, updated by a lookup table
+UINT8 = "uint8"
+
+# Cells holding signed 16.15 fixed point values, updated by a weighted sum
+S1615 = "s1615"
+
+# The C type of each type of cell
+C_TYPES = {UINT8: "uint8_t", S1615: "s1615_t"}
+
+# The most entries a rule lookup table can have; the table lives in DTCM
+MAX_LUT_ENTRIES = 4096
+
+# The scale of the signed 16.15 fixed point values
+S1615_SCALE = float(1 << 15)
+
+
+def to_s1615(value):
+    """ Convert a number to signed 16.15 fixed point, saturating
+    """
+    return max(-(1 << 31), min((1 << 31) - 1, int(round(value * S1615_SCALE))))
+
+
+class StencilSpec(object):
+    """ A stencil: the neighbourhood each cell is updated from, the type of\
+        the cells, the update rule and the size of the tile of cells each\
+        core holds.  Everything here is baked into the binary generated for\
+        the stencil, so two specs that are equal share a binary.
+
+        The rule of UINT8 cells is a python function, which is evaluated\
+        for every combination of states into a lookup table; it is given\
+        the state of the cell and the sum of the states of its neighbours\
+        if the rule is totalistic, or the tuple of the states of its\
+        neighbours, in the order of the neighbourhood, if not.  The rule of\
+        S1615 cells is the weighted sum of the cell and its neighbours.
+    """
+
+    __slots__ = [
+        # The (dx, dy) offsets of the neighbours of a cell
+        "_neighbourhood",
+
+        # The type of the cells, UINT8 or S1615
+        "_cell_type",
+
+        # The number of cells across and up the tile of each core
+        "_tile_width",
+        "_tile_height",
+
+        # The number of states of UINT8 cells
+        "_n_states",
+
+        # True if the rule of UINT8 cells depends only on the sum of the
+        # neighbours
+        "_totalistic",
+
+        # The lookup table of the rule of UINT8 cells
+        "_lut",
+
+        # The fixed point weights of the cell and of each neighbour of
+        # S1615 cells
+        "_centre_weight",
+        "_neighbour_weights"
+    ]
+
+    def __init__(
+            self, neighbourhood=MOORE, cell_type=UINT8, tile_width=8,
+            tile_height=8, rule=None, n_states=2, totalistic=True,
+            centre_weight=None, neighbour_weights=None):
+        """
+        :param neighbourhood: the (dx, dy) offsets of the neighbours
+        :param cell_type: UINT8 or S1615
+        :param tile_width: the number of cells across each tile
+        :param tile_height: the number of cells up each tile
+        :param rule: the rule of UINT8 cells, returning the next state
+        :type rule: callable(int, int or tuple of int)
+        :param n_states: the number of states of UINT8 cells
+        :param totalistic: True if the rule is given the sum of the states\
+            of the neighbours rather than each of them
+        :param centre_weight: the weight of the cell itself for S1615 cells
+        :param neighbour_weights: the weight of each neighbour for S1615\
+            cells, as one number or a number per neighbour
+        :raise ConfigurationException: if the stencil cannot be generated
+        """
+        self._neighbourhood = tuple(
+            (int(dx), int(dy)) for dx, dy in neighbourhood)
+        if not self._neighbourhood or (0, 0) in self._neighbourhood or \
+                len(set(self._neighbourhood)) != len(self._neighbourhood):
+            raise ConfigurationException(
+                "The neighbourhood must be distinct offsets other than the "
+                "cell itself")
+        if cell_type not in C_TYPES:
+            raise ConfigurationException(
+                "Unknown cell type {}".format(cell_type))
+        self._cell_type = cell_type
+        self._tile_width = int(tile_width)
+        self._tile_height = int(tile_height)
+        if min(self._tile_width, self._tile_height) < self.radius:
+            raise ConfigurationException(
+                "The tile must be at least as big as the radius {} of the "
+                "neighbourhood".format(self.radius))
+        self._n_states = int(n_states)
+        self._totalistic = bool(totalistic)
+        self._lut = None
+        self._centre_weight = None
+        self._neighbour_weights = None
+
+        if cell_type == UINT8:
+            if rule is None:
+                raise ConfigurationException("UINT8 cells need a rule")
+            if not 2 <= self._n_states <= 256:
+                raise ConfigurationException(
+                    "UINT8 cells have between 2 and 256 states")
+            self._lut = self._tabulate(rule)
+        else:
+            if centre_weight is None or neighbour_weights is None:
+                raise ConfigurationException(
+                    "S1615 cells need the centre and neighbour weights")
+            try:
+                weights = list(neighbour_weights)
+            except TypeError:
+                weights = [neighbour_weights] * len(self._neighbourhood)
+            if len(weights) != len(self._neighbourhood):
+                raise ConfigurationException(
+                    "There must be a weight for each neighbour")
+            self._centre_weight = to_s1615(centre_weight)
+            self._neighbour_weights = tuple(to_s1615(w) for w in weights)
+
+    def _tabulate(self, rule):
+        """ Evaluate the rule for every state of a cell and its neighbours
+        """
+        n_neighbours = len(self._neighbourhood)
+        if self._totalistic:
+            inputs = [
+                (state, total) for state in range(self._n_states)
+                for total in range(self.n_totals)]
+        else:
+            n_entries = self._n_states ** (n_neighbours + 1)
+            if n_entries > MAX_LUT_ENTRIES:
+                raise ConfigurationException(
+                    "A rule of {} states over {} neighbours needs {} entries; "
+                    "make it totalistic".format(
+                        self._n_states, n_neighbours, n_entries))
+
+            # the state of the cell is the most significant digit of the
+            # index, and the last neighbour the least
+            inputs = list()
+            for index in range(n_entries):
+                digits = list()
+                for _ in range(n_neighbours + 1):
+                    digits.append(index % self._n_states)
+                    index //= self._n_states
+                digits.reverse()
+                inputs.append((digits[0], tuple(digits[1:])))
+        if len(inputs) > MAX_LUT_ENTRIES:
+            raise ConfigurationException(
+                "The rule needs {} entries, more than the {} that fit".format(
+                    len(inputs), MAX_LUT_ENTRIES))
+
+        lut = list()
+        for state, neighbours in inputs:
+            next_state = int(rule(state, neighbours))
+            if not 0 <= next_state < self._n_states:
+                raise ConfigurationException(
+                    "The rule gives state {} for ({}, {}), which is not one "
+                    "of the {} states".format(
+                        next_state, state, neighbours, self._n_states))
+            lut.append(next_state)
+        return tuple(lut)
+
+    @property
+    def neighbourhood(self):
+        return self._neighbourhood
+
+    @property
+    def cell_type(self):
+        return self._cell_type
+
+    @property
+    def c_type(self):
+        return C_TYPES[self._cell_type]
+
+    @property
+    def tile_width(self):
+        return self._tile_width
+
+    @property
+    def tile_height(self):
+        return self._tile_height
+
+    @property
+    def n_cells(self):
+        return self._tile_width * self._tile_height
+
+    @property
+    def radius(self):
+        """ The furthest a neighbour is from a cell along either axis
+        """
+        return max(max(abs(dx), abs(dy)) for dx, dy in self._neighbourhood)
+
+    @property
+    def n_states(self):
+        return self._n_states
+
+    @property
+    def totalistic(self):
+        return self._totalistic
+
+    @property
+    def n_totals(self):
+        """ The number of different sums of the states of the neighbours
+        """
+        return (self._n_states - 1) * len(self._neighbourhood) + 1
+
+    @property
+    def lut(self):
+        """ The lookup table of the rule of UINT8 cells, or None
+        """
+        return self._lut
+
+    @property
+    def centre_weight(self):
+        """ The fixed point weight of the cell itself for S1615 cells
+        """
+        return self._centre_weight
+
+    @property
+    def neighbour_weights(self):
+        """ The fixed point weight of each neighbour for S1615 cells
+        """
+        return self._neighbour_weights
+
+    @property
+    def border_cells(self):
+        """ The indices of the cells of a tile which are neighbours of cells\
+            of other tiles, in row order
+        """
+        r = self.radius
+        return [
+            y * self._tile_width + x
+            for y in range(self._tile_height)
+            for x in range(self._tile_width)
+            if (x < r or y < r or x >= self._tile_width - r or
+                y >= self._tile_height - r)]
+
+    def describe(self):
+        """ Everything that is baked into the binary, as a dict which can be\
+            written as JSON
+        """
+        return {
+            "neighbourhood": [list(offset) for offset in self._neighbourhood],
+            "cell_type": self._cell_type,
+            "tile_width": self._tile_width,
+            "tile_height": self._tile_height,
+            "n_states": self._n_states,
+            "totalistic": self._totalistic,
+            "lut": None if self._lut is None else list(self._lut),
+            "centre_weight": self._centre_weight,
+            "neighbour_weights": (
+                None if self._neighbour_weights is None
+                else list(self._neighbour_weights))}
+
+    def spec_hash(self, salt=b""):
+        """ A hash of the spec which names its binary
+
+        :param salt: anything else the binary depends on, such as the\
+            source of the templates it is generated from
+        """
+        digest = hashlib.sha1(salt)
+        digest.update(json.dumps(
+            self.describe(), sort_keys=True).encode("utf-8"))
+        return digest.hexdigest()[:16]
+
+    def __eq__(self, other):
+        return (isinstance(other, StencilSpec) and
+                self.describe() == other.describe())
+
+    def __ne__(self, other):
+        return not self.__eq__(other)
+
+    def __hash__(self):
+        return hash(self.spec_hash())
+
+    def __repr__(self):
+        return "StencilSpec({} cells, {} neighbours, {}x{} tiles)".format(
+            self._cell_type, len(self._neighbourhood), self._tile_width,
+            self._tile_height)
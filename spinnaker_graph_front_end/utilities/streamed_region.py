@@ -0,0 +1,123 @@
+import numpy
+
+from pacman.model.resources import DTCMResource, SDRAMResource
+
+# The size of the data and the size of the blocks
+HEADER_BYTES = 2 * 4
+
+# The two DTCM buffers of the stream, see dma_stream.h
+N_BUFFERS = 2
+
+# A block size which keeps a good part of DTCM free for the application
+DEFAULT_BLOCK_BYTES = 4 * 1024
+
+
+class StreamedRegion(object):
+    """ A data region which is too large for DTCM and is instead read\
+        through a double-buffered DMA stream (see dma_stream.h)
+    """
+
+    __slots__ = [
+        # The id of the region
+        "_region",
+
+        # The size of the data in bytes
+        "_n_bytes",
+
+        # The size of the blocks the data is fetched in
+        "_block_bytes",
+
+        # The label of the region
+        "_label"
+    ]
+
+    def __init__(
+            self, region, n_bytes, block_bytes=DEFAULT_BLOCK_BYTES,
+            label=None):
+        """
+        :param region: the id of the region
+        :param n_bytes: the size of the data to be streamed in bytes
+        :param block_bytes: the size of each block fetched into DTCM
+        :param label: the label of the region
+        """
+        if block_bytes <= 0 or block_bytes % 4 != 0:
+            raise ValueError(
+                "The block size must be a positive multiple of 4 bytes")
+        self._region = region
+        self._n_bytes = int(n_bytes)
+        self._block_bytes = min(
+            block_bytes, max(4, self._round_to_words(self._n_bytes)))
+        self._label = label
+
+    @staticmethod
+    def _round_to_words(n_bytes):
+        return ((n_bytes + 3) // 4) * 4
+
+    @property
+    def region(self):
+        return self._region
+
+    @property
+    def n_bytes(self):
+        return self._n_bytes
+
+    @property
+    def block_bytes(self):
+        return self._block_bytes
+
+    @property
+    def n_blocks(self):
+        """ The number of blocks the data is streamed in
+        """
+        return (self._n_bytes + self._block_bytes - 1) // self._block_bytes
+
+    @property
+    def sdram_size(self):
+        """ The size of the region in SDRAM in bytes
+        """
+        return HEADER_BYTES + self._round_to_words(self._n_bytes)
+
+    @property
+    def dtcm_size(self):
+        """ The size of the DTCM buffers used to stream the region in bytes
+        """
+        return N_BUFFERS * self._block_bytes
+
+    @property
+    def sdram_resource(self):
+        return SDRAMResource(self.sdram_size)
+
+    @property
+    def dtcm_resource(self):
+        return DTCMResource(self.dtcm_size)
+
+    def reserve_memory_region(self, spec):
+        """ Reserve the region in a data specification
+
+        :param spec: the data specification to reserve the region in
+        """
+        spec.reserve_memory_region(
+            region=self._region, size=self.sdram_size, label=self._label)
+
+    def write(self, spec, data):
+        """ Write the data of the region
+
+        :param spec: the data specification to write to
+        :param data: the data to stream; a numpy array of any type, or a\
+            list of 32-bit words, which must come to the size given at\
+            creation
+        """
+        if not isinstance(data, numpy.ndarray):
+            data = numpy.array(data, dtype="uint32")
+        raw = numpy.ascontiguousarray(data).tobytes()
+        if len(raw) != self._n_bytes:
+            raise ValueError(
+                "Region {} was given {} bytes of data instead of {}".format(
+                    self._region, len(raw), self._n_bytes))
+        raw += b"\0" * (self._round_to_words(self._n_bytes) - self._n_bytes)
+
+        spec.switch_write_focus(self._region)
+        spec.write_value(self._n_bytes)
+        spec.write_value(self._block_bytes)
+        if raw:
+            spec.write_array(numpy.frombuffer(raw, dtype="<u4"))
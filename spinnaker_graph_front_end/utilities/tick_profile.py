@@ -0,0 +1,128 @@
+""" Host side of tick_profiler.h
+"""
+import struct
+
+from spinn_front_end_common.utilities import helpful_functions
+
+from spinnaker_graph_front_end.abstract_models import AbstractHasTickProfile
+
+# max cycles, total cycles (low, high), ticks, overruns, lost packets,
+# DTCM used
+_PROFILE = struct.Struct("<7I")
+
+# The size of the tick profile region in bytes
+TICK_PROFILE_REGION_SIZE = _PROFILE.size
+
+
+class TickProfile(object):
+    """ The measured cost of the timer ticks of one core
+    """
+
+    __slots__ = [
+        "_max_tick_cycles",
+        "_total_tick_cycles",
+        "_n_ticks",
+        "_n_overruns",
+        "_n_lost_packets",
+        "_dtcm_used_bytes"
+    ]
+
+    def __init__(
+            self, max_tick_cycles, total_tick_cycles, n_ticks, n_overruns,
+            n_lost_packets, dtcm_used_bytes=0):
+        self._max_tick_cycles = max_tick_cycles
+        self._total_tick_cycles = total_tick_cycles
+        self._n_ticks = n_ticks
+        self._n_overruns = n_overruns
+        self._n_lost_packets = n_lost_packets
+        self._dtcm_used_bytes = dtcm_used_bytes
+
+    @property
+    def max_tick_cycles(self):
+        """ The most CPU cycles any tick took from its timer interrupt
+        """
+        return self._max_tick_cycles
+
+    @property
+    def mean_tick_cycles(self):
+        """ The mean CPU cycles taken by a tick
+        """
+        if self._n_ticks == 0:
+            return 0.0
+        return float(self._total_tick_cycles) / self._n_ticks
+
+    @property
+    def n_ticks(self):
+        """ The number of ticks measured
+        """
+        return self._n_ticks
+
+    @property
+    def n_overruns(self):
+        """ The number of ticks that took longer than the timer period
+        """
+        return self._n_overruns
+
+    @property
+    def n_lost_packets(self):
+        """ The number of packets the binary reported as lost
+        """
+        return self._n_lost_packets
+
+    @property
+    def dtcm_used_bytes(self):
+        """ The DTCM the binary used once set up, or 0 if it did not say
+        """
+        return self._dtcm_used_bytes
+
+    def __repr__(self):
+        return "TickProfile(max_tick_cycles={}, mean_tick_cycles={:.1f}, " \
+               "n_ticks={}, n_overruns={}, n_lost_packets={}, " \
+               "dtcm_used_bytes={})".format(
+                   self._max_tick_cycles, self.mean_tick_cycles,
+                   self._n_ticks, self._n_overruns, self._n_lost_packets,
+                   self._dtcm_used_bytes)
+
+
+def reserve_tick_profile_region(spec, region):
+    """ Reserve the tick profile region in a data specification; the binary\
+        fills it in
+
+    :param spec: the data specification
+    :param region: the id of the region
+    """
+    spec.reserve_memory_region(
+        region=region, size=TICK_PROFILE_REGION_SIZE, label="tick_profile")
+
+
+def read_tick_profile(transceiver, placement, region):
+    """ Read the tick profile of a core
+
+    :param transceiver: the transceiver to read with
+    :param placement: the placement of the vertex
+    :param region: the id of the tick profile region
+    :rtype: :py:class:`TickProfile`
+    """
+    address = helpful_functions.locate_memory_region_for_placement(
+        placement, region, transceiver)
+    data = transceiver.read_memory(
+        placement.x, placement.y, address, TICK_PROFILE_REGION_SIZE)
+    (max_cycles, total_low, total_high, n_ticks, n_overruns,
+     n_lost_packets, dtcm_used_bytes) = _PROFILE.unpack_from(bytes(data))
+    return TickProfile(
+        max_cycles, (total_high << 32) | total_low, n_ticks, n_overruns,
+        n_lost_packets, dtcm_used_bytes)
+
+
+def get_tick_profiles(transceiver, placements):
+    """ Read the tick profiles of every vertex which has one
+
+    :param transceiver: the transceiver to read with
+    :param placements: the placements of the machine graph
+    :return: dict of placement to :py:class:`TickProfile`
+    """
+    return {
+        placement: read_tick_profile(
+            transceiver, placement, placement.vertex.tick_profile_region_id)
+        for placement in placements.placements
+        if isinstance(placement.vertex, AbstractHasTickProfile)}
@@ -0,0 +1,171 @@
+import logging
+import math
+
+logger = logging.getLogger(__name__)
+
+
+class TimeStepTuning(object):
+    """ The outcome of tuning the machine time step from a calibration run
+    """
+
+    __slots__ = [
+        # The time step the calibration was run with, in microseconds
+        "_calibration_time_step",
+
+        # The time step chosen for the real run, in microseconds
+        "_machine_time_step",
+
+        # The time the slowest tick needed, in microseconds
+        "_required_time_step",
+
+        # The factor the timer period is slowed down by
+        "_time_scale_factor",
+
+        # The placement of the core with the slowest tick
+        "_limiting_placement",
+
+        # Totals over all the cores of the calibration run
+        "_n_overruns",
+        "_n_lost_packets"
+    ]
+
+    def __init__(
+            self, calibration_time_step, machine_time_step,
+            required_time_step, limiting_placement, n_overruns,
+            n_lost_packets, time_scale_factor=1):
+        self._calibration_time_step = calibration_time_step
+        self._machine_time_step = machine_time_step
+        self._required_time_step = required_time_step
+        self._time_scale_factor = time_scale_factor
+        self._limiting_placement = limiting_placement
+        self._n_overruns = n_overruns
+        self._n_lost_packets = n_lost_packets
+
+    @property
+    def calibration_time_step(self):
+        return self._calibration_time_step
+
+    @property
+    def machine_time_step(self):
+        """ The chosen machine time step in microseconds
+        """
+        return self._machine_time_step
+
+    @property
+    def required_time_step(self):
+        """ The time the slowest tick of the calibration took in microseconds
+        """
+        return self._required_time_step
+
+    @property
+    def time_scale_factor(self):
+        return self._time_scale_factor
+
+    @property
+    def timer_period(self):
+        """ The time between the ticks of the chosen time step in\
+            microseconds, i.e. the machine time step times the time scale\
+            factor
+        """
+        return self._machine_time_step * self._time_scale_factor
+
+    @property
+    def headroom(self):
+        """ The fraction of the chosen timer period the slowest core has\
+            spare
+        """
+        return 1.0 - (self._required_time_step / self.timer_period)
+
+    @property
+    def limiting_placement(self):
+        """ The placement of the core which limits the time step, or None
+        """
+        return self._limiting_placement
+
+    @property
+    def calibration_was_safe(self):
+        """ Whether the calibration ran without overruns or lost packets
+        """
+        return self._n_overruns == 0 and self._n_lost_packets == 0
+
+    @property
+    def n_overruns(self):
+        return self._n_overruns
+
+    @property
+    def n_lost_packets(self):
+        return self._n_lost_packets
+
+    def __str__(self):
+        return (
+            "machine time step {} us (calibrated at {} us); slowest tick "
+            "took {:.1f} us{}, leaving {:.0%} headroom".format(
+                self._machine_time_step, self._calibration_time_step,
+                self._required_time_step,
+                "" if self._limiting_placement is None else " on {}, {}, {}"
+                .format(self._limiting_placement.x,
+                        self._limiting_placement.y,
+                        self._limiting_placement.p),
+                self.headroom))
+
+
+def tune_time_step(
+        tick_profiles, calibration_time_step, headroom,
+        minimum_time_step, granularity, cpu_clock_mhz, time_scale_factor=1):
+    """ Pick the smallest machine time step which leaves the slowest core\
+        the requested headroom.  If the calibration overran or lost packets,\
+        what it measured is only a lower bound of the cost of a tick, so a\
+        time step of at least twice the calibration time step is picked,\
+        which should be calibrated again
+
+    :param tick_profiles: dict of placement to TickProfile measured in the\
+        calibration run
+    :param calibration_time_step: the machine time step of the calibration\
+        run in microseconds
+    :param headroom: the fraction of each tick to leave spare on the\
+        slowest core, e.g. 0.25
+    :param minimum_time_step: the smallest time step to choose in\
+        microseconds
+    :param granularity: the chosen time step is a multiple of this many\
+        microseconds
+    :param cpu_clock_mhz: the clock speed of the cores in MHz
+    :param time_scale_factor: the factor the timer period is slowed down by,\
+        in the calibration run and the real run alike; the ticks are\
+        measured in real time, so the time step is scaled down by it
+    :rtype: :py:class:`TimeStepTuning`
+    """
+    max_cycles = 0
+    limiting_placement = None
+    n_overruns = 0
+    n_lost_packets = 0
+    for placement, profile in tick_profiles.items():
+        n_overruns += profile.n_overruns
+        n_lost_packets += profile.n_lost_packets
+        if profile.max_tick_cycles > max_cycles:
+            max_cycles = profile.max_tick_cycles
+            limiting_placement = placement
+    required = float(max_cycles) / cpu_clock_mhz
+
+    if not tick_profiles:
+        return TimeStepTuning(
+            calibration_time_step, calibration_time_step, required,
+            limiting_placement, n_overruns, n_lost_packets, time_scale_factor)
+
+    # the timer period is the time step times the time scale factor
+    chosen = required / (1.0 - headroom) / time_scale_factor
+    chosen = int(math.ceil(chosen / granularity)) * granularity
+    chosen = max(chosen, minimum_time_step)
+    if n_overruns or n_lost_packets:
+
+        # The calibration itself was too fast, so what was measured is not
+        # the cost of a healthy tick; back off from the time step shown to
+        # be too short
+        chosen = max(chosen, 2 * calibration_time_step)
+        logger.warning(
+            "The calibration run at {} us had {} overrunning ticks and {} "
+            "lost packets; backing off to {} us".format(
+                calibration_time_step, n_overruns, n_lost_packets, chosen))
+
+    return TimeStepTuning(
+        calibration_time_step, chosen, required, limiting_placement,
+        n_overruns, n_lost_packets, time_scale_factor)
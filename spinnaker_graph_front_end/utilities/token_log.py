@@ -0,0 +1,578 @@
+""" Tokenised logging (see token_log.h): conversion of the log calls of C\
+    sources to records of a token and raw arguments when a binary is built\
+    with TOKEN_LOGGING=1, the dictionary of the messages of the tokens\
+    saved next to the binary, and the rebuilding of the messages from the\
+    ring of records read from a core.
+
+    Run as "python token_log.py <dictionary> <output folder> <source>..."\
+    by Makefile.token_log to convert the sources of a binary.
+"""
+from spinn_front_end_common.abstract_models \
+    import AbstractHasAssociatedBinary
+from spinn_front_end_common.utilities.exceptions import SpinnFrontEndException
+
+import json
+import logging
+import os
+import re
+import struct
+import sys
+import zlib
+
+logger = logging.getLogger(__name__)
+
+# The ending of the name of a token dictionary saved next to a binary
+TOKEN_DICTIONARY_SUFFIX = ".tokens.json"
+
+# The first word of a ring, as in token_log.h
+TOKEN_LOG_MAGIC = 0x544F4B4E
+
+# The words before the records of a ring: magic, n_words, first, next,
+# used, n_dropped, load time
+_RING_HEADER = struct.Struct("<7I")
+
+# Where the number of arguments is in the header word of a record
+_N_ARGS_SHIFT = 24
+_TOKEN_MASK = (1 << _N_ARGS_SHIFT) - 1
+
+# The offset of the user2 register from the user0 register of a core
+_USER_2_OFFSET = 8
+
+# The log calls converted, and the level of each as named in debug.h
+LOG_LEVELS = {
+    "log_error": "LOG_ERROR",
+    "log_warning": "LOG_WARNING",
+    "log_info": "LOG_INFO",
+    "log_debug": "LOG_DEBUG"}
+
+# How each level is shown, as in the iobuf of a core
+_LEVEL_NAMES = {
+    "LOG_ERROR": "ERROR", "LOG_WARNING": "WARNING", "LOG_INFO": "INFO",
+    "LOG_DEBUG": "DEBUG"}
+
+# A conversion of a format: flags, width, precision and the conversion
+_CONVERSION = re.compile(r"%([-0]?)(\d*)(?:\.(\d+))?([a-zA-Z%])")
+
+# The C expression of an argument by its conversion; messages with other
+# conversions, such as %s, are left to be formatted on the core
+_ARGUMENTS = {
+    "d": "(uint32_t) ({})", "i": "(uint32_t) ({})", "u": "(uint32_t) ({})",
+    "x": "(uint32_t) ({})", "X": "(uint32_t) ({})", "c": "(uint32_t) ({})",
+    "p": "(uint32_t) ({})", "f": "token_log_float({})",
+    "F": "token_log_float({})", "k": "token_log_accum({})"}
+
+# The most arguments of a record
+MAX_ARGS = 15
+
+_ESCAPES = {"n": "\n", "t": "\t", "r": "\r", "0": "\0", "\\": "\\",
+            "\"": "\"", "'": "'"}
+
+
+class TokenEntry(object):
+    """ The message of a token
+    """
+
+    __slots__ = [
+        # The level of the message, as named in debug.h
+        "_level",
+
+        # Where the message was logged
+        "_file_name",
+        "_line",
+
+        # The format of the message
+        "_message_format"
+    ]
+
+    def __init__(self, level, file_name, line, message_format):
+        self._level = level
+        self._file_name = file_name
+        self._line = line
+        self._message_format = message_format
+
+    @property
+    def level(self):
+        return self._level
+
+    @property
+    def file_name(self):
+        return self._file_name
+
+    @property
+    def line(self):
+        return self._line
+
+    @property
+    def message_format(self):
+        return self._message_format
+
+    def format(self, args):
+        """ Rebuild the message from the words of its arguments, in the form\
+            of the iobuf of a core
+
+        :param args: the argument words of a record
+        :rtype: str
+        """
+        return "[{}] ({}: {}): {}".format(
+            _LEVEL_NAMES.get(self._level, self._level), self._file_name,
+            self._line, format_message(self._message_format, args))
+
+    def to_json(self):
+        return [self._level, self._file_name, self._line,
+                self._message_format]
+
+
+class TokenDictionary(object):
+    """ The messages of the tokens of a binary
+    """
+
+    __slots__ = [
+        # The message of each token
+        "_entries"
+    ]
+
+    def __init__(self):
+        self._entries = dict()
+
+    def __len__(self):
+        return len(self._entries)
+
+    def __contains__(self, token):
+        return token in self._entries
+
+    def get_entry(self, token):
+        """ Get the message of a token, or None if it has none
+
+        :rtype: :py:class:`TokenEntry`
+        """
+        return self._entries.get(token)
+
+    def add(self, level, file_name, line, message_format):
+        """ Add a message, giving it a token made from where it is logged;\
+            clashing tokens are moved on to the next free one
+
+        :return: the token of the message
+        :rtype: int
+        """
+        key = "{}:{}:{}".format(file_name, line, message_format)
+        token = (zlib.crc32(key.encode("utf-8")) & _TOKEN_MASK) or 1
+        while token in self._entries:
+            token = ((token + 1) & _TOKEN_MASK) or 1
+        self._entries[token] = TokenEntry(
+            level, file_name, line, message_format)
+        return token
+
+    def save(self, path):
+        """ Write the dictionary as JSON, in token order
+        """
+        with open(path, "w") as f:
+            f.write("[\n{}\n]\n".format(",\n".join(
+                json.dumps([token] + self._entries[token].to_json())
+                for token in sorted(self._entries))))
+
+    @staticmethod
+    def load(path):
+        """ Read a dictionary written by save()
+
+        :rtype: :py:class:`TokenDictionary`
+        """
+        dictionary = TokenDictionary()
+        with open(path) as f:
+            for token, level, file_name, line, message_format in json.load(f):
+                dictionary._entries[token] = TokenEntry(
+                    level, file_name, line, message_format)
+        return dictionary
+
+
+def get_token_dictionary_path(binary_path):
+    """ Get where the token dictionary of a binary is saved
+    """
+    return os.path.splitext(binary_path)[0] + TOKEN_DICTIONARY_SUFFIX
+
+
+def _to_signed(word):
+    return word - (1 << 32) if word & 0x80000000 else word
+
+
+def _format_conversion(match, args):
+    flags, width, precision, conversion = match.groups()
+    if conversion == "%":
+        return "%"
+    if not args:
+        return match.group(0)
+    word = args.pop(0)
+    if conversion in "di":
+        text = str(_to_signed(word))
+    elif conversion == "u":
+        text = str(word)
+    elif conversion in "xX":
+        text = "{:x}".format(word)
+        if conversion == "X":
+            text = text.upper()
+    elif conversion == "p":
+        text = "0x{:08x}".format(word)
+    elif conversion == "c":
+        text = chr(word & 0xFF)
+    elif conversion in "fF":
+        value, = struct.unpack("<f", struct.pack("<I", word))
+        text = "{:.{}f}".format(value, int(precision or 6))
+    else:
+        text = "{:.{}f}".format(
+            _to_signed(word) / 32768.0, int(precision or 6))
+    if not width:
+        return text
+    if flags == "-":
+        return text.ljust(int(width))
+    if flags == "0" and text.startswith("-"):
+        return "-" + text[1:].rjust(int(width) - 1, "0")
+    return text.rjust(int(width), "0" if flags == "0" else " ")
+
+
+def format_message(message_format, args):
+    """ Format a message as the core would have from the words of its\
+        arguments
+
+    :param message_format: the printf style format of the message
+    :param args: the argument words
+    :rtype: str
+    """
+    args = list(args)
+    return _CONVERSION.sub(
+        lambda match: _format_conversion(match, args), message_format)
+
+
+def _skip_literal(text, i):
+    """ The index after the string or character literal starting at i
+    """
+    quote = text[i]
+    i += 1
+    while i < len(text) and text[i] != quote:
+        i += 2 if text[i] == "\\" else 1
+    return i + 1
+
+
+def _skip_comment(text, i):
+    """ The index after the comment starting at i, or i if there is none
+    """
+    if text.startswith("//", i):
+        end = text.find("\n", i)
+        return len(text) if end < 0 else end
+    if text.startswith("/*", i):
+        end = text.find("*/", i + 2)
+        return len(text) if end < 0 else end + 2
+    return i
+
+
+def _split_arguments(text, start):
+    """ Split the arguments of a call whose "(" is at start
+
+    :return: the text of each argument, and the index after the ")"
+    """
+    arguments = list()
+    depth = 0
+    i = start + 1
+    argument_start = i
+    while i < len(text):
+        c = text[i]
+        after_comment = _skip_comment(text, i)
+        if after_comment != i:
+            i = after_comment
+            continue
+        if c in "\"'":
+            i = _skip_literal(text, i)
+            continue
+        if c in "([{":
+            depth += 1
+        elif c in ")]}":
+            if depth == 0:
+                arguments.append(text[argument_start:i].strip())
+                return arguments, i + 1
+            depth -= 1
+        elif c == "," and depth == 0:
+            arguments.append(text[argument_start:i].strip())
+            argument_start = i + 1
+        i += 1
+    return None, i
+
+
+def _parse_format(argument):
+    """ The format of a message from its C string literals, or None if it\
+        is not only string literals
+    """
+    parts = list()
+    i = 0
+    while i < len(argument):
+        if argument[i].isspace():
+            i += 1
+        elif argument[i] == "\"":
+            end = _skip_literal(argument, i)
+            parts.append(argument[i + 1:end - 1])
+            i = end
+        else:
+            return None
+    if not parts:
+        return None
+    literal = "".join(parts)
+    message_format = list()
+    i = 0
+    while i < len(literal):
+        if literal[i] == "\\" and i + 1 < len(literal):
+            if literal[i + 1] == "x":
+                end = i + 2
+                while end < len(literal) and end < i + 4 and \
+                        literal[end] in "0123456789abcdefABCDEF":
+                    end += 1
+                message_format.append(chr(int(literal[i + 2:end], 16)))
+                i = end
+                continue
+            message_format.append(
+                _ESCAPES.get(literal[i + 1], literal[i + 1]))
+            i += 2
+        else:
+            message_format.append(literal[i])
+            i += 1
+    return "".join(message_format)
+
+
+def _convert_call(name, arguments, file_name, line, dictionary):
+    """ The call of token_log_record() replacing a log call, or None if it\
+        has to be left alone
+    """
+    message_format = _parse_format(arguments[0])
+    if message_format is None:
+        return None
+    conversions = [
+        match.group(4) for match in _CONVERSION.finditer(message_format)
+        if match.group(4) != "%"]
+    values = arguments[1:]
+    if (len(conversions) != len(values) or len(values) > MAX_ARGS or
+            any(conversion not in _ARGUMENTS
+                for conversion in conversions)):
+        return None
+    level = LOG_LEVELS[name]
+    token = dictionary.add(level, file_name, line, message_format)
+    words = [_ARGUMENTS[conversion].format(value)
+             for conversion, value in zip(conversions, values)]
+    return "token_log_record({}, 0x{:06x}, {}, {})".format(
+        level, token, len(words), ", ".join(words or ["0"]))
+
+
+def convert_source(text, file_name, dictionary):
+    """ Replace the log calls of a C source by records of tokens, adding the\
+        messages to a dictionary; the lines of the source are kept where\
+        they are, so that the compiler reports the same lines
+
+    :param text: the source
+    :param file_name: the name of the source, as given in the dictionary
+    :type dictionary: :py:class:`TokenDictionary`
+    :return: the converted source
+    :rtype: str
+    """
+    converted = list()
+    done = 0
+    i = 0
+    while i < len(text):
+        after_comment = _skip_comment(text, i)
+        if after_comment != i:
+            i = after_comment
+            continue
+        c = text[i]
+        if c in "\"'":
+            i = _skip_literal(text, i)
+            continue
+        if not (c.isalpha() or c == "_"):
+            i += 1
+            continue
+
+        # a whole identifier; only the log calls themselves are converted
+        end = i
+        while end < len(text) and (text[end].isalnum() or text[end] == "_"):
+            end += 1
+        name = text[i:end]
+        start = end
+        while start < len(text) and text[start].isspace():
+            start += 1
+        if name not in LOG_LEVELS or not text.startswith("(", start):
+            i = end
+            continue
+        arguments, after = _split_arguments(text, start)
+        if not arguments:
+            i = end
+            continue
+        call = _convert_call(
+            name, arguments, file_name, text.count("\n", 0, i) + 1,
+            dictionary)
+        if call is None:
+            i = end
+            continue
+        converted.append(text[done:i])
+        converted.append(
+            call[:-1] + "\n" * text.count("\n", i, after) + ")")
+        done = i = after
+    converted.append(text[done:])
+    return "".join(converted)
+
+
+def _write_if_changed(path, text):
+    """ Write a file unless it already holds the text, so that make does\
+        not rebuild what has not changed
+    """
+    if os.path.exists(path):
+        with open(path) as f:
+            if f.read() == text:
+                return
+    with open(path, "w") as f:
+        f.write(text)
+
+
+def convert_sources(dictionary_path, output_folder, source_paths):
+    """ Convert the sources of a binary into a folder, and save the\
+        dictionary of their messages
+
+    :param dictionary_path: where to save the dictionary
+    :param output_folder: the folder to write the converted sources to,\
+        each under its own name
+    :param source_paths: the sources and headers to convert
+    :rtype: :py:class:`TokenDictionary`
+    """
+    if not os.path.isdir(output_folder):
+        os.makedirs(output_folder)
+    dictionary = TokenDictionary()
+    for path in source_paths:
+        with open(path) as f:
+            text = f.read()
+        file_name = os.path.basename(path)
+        _write_if_changed(
+            os.path.join(output_folder, file_name),
+            convert_source(text, file_name, dictionary))
+    dictionary.save(dictionary_path)
+    return dictionary
+
+
+def decode_ring(data):
+    """ Read the records of a ring, oldest first
+
+    :param data: the bytes of the ring, from its magic word
+    :return: the (token, argument words) of each record, and the number of\
+        records overwritten
+    :rtype: (list of (int, list of int), int)
+    :raise SpinnFrontEndException: if the data is not a whole ring
+    """
+    data = bytes(data)
+    if len(data) < _RING_HEADER.size:
+        raise SpinnFrontEndException("The token log is truncated")
+    magic, n_words, first, next_offset, used, n_dropped, _ = \
+        _RING_HEADER.unpack_from(data)
+    if magic != TOKEN_LOG_MAGIC:
+        raise SpinnFrontEndException("The token log has no magic number")
+    if len(data) < _RING_HEADER.size + n_words * 4 or used > n_words:
+        raise SpinnFrontEndException("The token log is truncated")
+    words = struct.unpack_from("<{}I".format(n_words), data, _RING_HEADER.size)
+
+    records = list()
+    offset = first
+    remaining = used
+    while remaining > 0:
+        if offset >= n_words or words[offset] == 0:
+
+            # the rest of the ring is unused
+            remaining -= n_words - offset
+            offset = 0
+            continue
+        n_args = words[offset] >> _N_ARGS_SHIFT
+        if 1 + n_args > remaining or offset + 1 + n_args > n_words:
+            raise SpinnFrontEndException("The token log is corrupt")
+        records.append((
+            words[offset] & _TOKEN_MASK,
+            list(words[offset + 1:offset + 1 + n_args])))
+        offset += 1 + n_args
+        remaining -= 1 + n_args
+    return records, n_dropped
+
+
+def read_token_log(transceiver, x, y, p):
+    """ Read the ring of records of a core
+
+    :return: the bytes of the ring, or None if the core has none
+    """
+    user_2_address = transceiver.get_user_0_register_address_from_core(
+        x, y, p) + _USER_2_OFFSET
+    address, = struct.unpack("<I", bytes(transceiver.read_memory(
+        x, y, user_2_address, 4)))
+    if address == 0:
+        return None
+    header = bytes(transceiver.read_memory(
+        x, y, address, _RING_HEADER.size))
+    magic, n_words, _, _, _, _, _ = _RING_HEADER.unpack(header)
+    if magic != TOKEN_LOG_MAGIC:
+        return None
+    return header + bytes(transceiver.read_memory(
+        x, y, address + _RING_HEADER.size, n_words * 4))
+
+
+def decode_messages(data, dictionary):
+    """ Rebuild the messages of a ring
+
+    :param data: the bytes of the ring
+    :type dictionary: :py:class:`TokenDictionary`
+    :return: the messages, oldest first, and the number overwritten
+    :rtype: (list of str, int)
+    """
+    records, n_dropped = decode_ring(data)
+    messages = list()
+    for token, args in records:
+        entry = dictionary.get_entry(token)
+        if entry is None:
+            messages.append("[UNKNOWN] token 0x{:06x} {}".format(
+                token, " ".join("0x{:08x}".format(arg) for arg in args)))
+        else:
+            messages.append(entry.format(args))
+    return messages, n_dropped
+
+
+def read_token_logs(transceiver, placements, executable_finder):
+    """ Read and rebuild the messages of every core running a binary built\
+        with tokenised logging
+
+    :param transceiver: the transceiver to read with
+    :param placements: the placements of the machine graph
+    :param executable_finder: where the binaries, and so their\
+        dictionaries, are found
+    :return: dict of placement to its messages, oldest first
+    """
+    dictionaries = dict()
+    logs = dict()
+    for placement in placements.placements:
+        vertex = placement.vertex
+        if not isinstance(vertex, AbstractHasAssociatedBinary):
+            continue
+        binary = vertex.get_binary_file_name()
+        if binary not in dictionaries:
+            path = get_token_dictionary_path(
+                executable_finder.get_executable_path(binary))
+            dictionaries[binary] = (
+                TokenDictionary.load(path) if os.path.exists(path) else None)
+        if dictionaries[binary] is None:
+            continue
+        data = read_token_log(
+            transceiver, placement.x, placement.y, placement.p)
+        if data is None:
+            continue
+        messages, n_dropped = decode_messages(data, dictionaries[binary])
+        if n_dropped:
+            logger.warning(
+                "{} messages of {} on {}, {}, {} were overwritten; build "
+                "with a larger TOKEN_LOG_WORDS to keep them".format(
+                    n_dropped, vertex, placement.x, placement.y,
+                    placement.p))
+        logs[placement] = messages
+    return logs
+
+
+if __name__ == "__main__":
+    if len(sys.argv) < 3:
+        sys.stderr.write(
+            "usage: token_log.py <dictionary> <output folder> "
+            "<source>...\n")
+        sys.exit(1)
+    convert_sources(sys.argv[1], sys.argv[2], sys.argv[3:])
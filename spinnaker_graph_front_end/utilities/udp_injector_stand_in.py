@@ -0,0 +1,178 @@
+""" A stand in for a stream injector core, which speaks its protocol over\
+    UDP on the host, so that an InputStream can be tested without a machine
+"""
+from spinnaker_graph_front_end.utilities.input_stream import \
+    FRAME_CREDIT_REQUEST, FRAME_DATA, InjectorCounters, decode_frame, \
+    encode_credit
+
+import select
+import socket
+import threading
+import time
+
+_SEQUENCE_MASK = 0xFFFF
+
+
+class UDPInjectorStandIn(object):
+    """ A thread which buffers frames in a ring of slots and drains them at\
+        a fixed rate, as stream_injector.c does each tick, sending credit\
+        back to where the frames came from
+    """
+
+    __slots__ = [
+        # The socket the frames are received on
+        "_socket",
+
+        # The number of slots, the values drained each tick, the seconds a
+        # tick lasts, and the frames drained after which credit is sent
+        "_n_slots",
+        "_values_per_tick",
+        "_tick_seconds",
+        "_credit_batch",
+
+        # The buffered frames, the value of the oldest to send next, and the
+        # sequence number of the next frame expected
+        "_slots",
+        "_next_value",
+        "_next_sequence",
+
+        # The frames drained since credit was last sent, and whether it was
+        # asked for
+        "_n_drained_since_credit",
+        "_credit_requested",
+
+        # Where the credit is sent
+        "_reply_address",
+
+        # The (channel, value) pairs sent on, in order
+        "_delivered",
+
+        # The counters, as the injector keeps them
+        "_frames_received",
+        "_frames_missed",
+        "_frames_dropped",
+        "_packets_sent",
+        "_ticks_rate_limited",
+
+        # The thread, and whether it should stop
+        "_thread",
+        "_stopping"
+    ]
+
+    def __init__(self, n_slots, values_per_tick, tick_seconds=0.001,
+                 credit_batch=1):
+        """
+        :param n_slots: the number of frames buffered
+        :param values_per_tick: the most values sent on each tick
+        :param tick_seconds: the time a tick lasts
+        :param credit_batch: the frames drained after which credit is sent
+        """
+        self._socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self._socket.bind(("127.0.0.1", 0))
+        self._n_slots = n_slots
+        self._values_per_tick = values_per_tick
+        self._tick_seconds = tick_seconds
+        self._credit_batch = credit_batch
+        self._slots = list()
+        self._next_value = 0
+        self._next_sequence = 0
+        self._n_drained_since_credit = 0
+        self._credit_requested = False
+        self._reply_address = None
+        self._delivered = list()
+        self._frames_received = 0
+        self._frames_missed = 0
+        self._frames_dropped = 0
+        self._packets_sent = 0
+        self._ticks_rate_limited = 0
+        self._thread = None
+        self._stopping = False
+
+    @property
+    def port(self):
+        """ The port the frames are received on
+        """
+        return self._socket.getsockname()[1]
+
+    @property
+    def delivered(self):
+        """ The (channel, value) pairs sent on so far
+        """
+        return list(self._delivered)
+
+    @property
+    def counters(self):
+        return InjectorCounters(
+            self._frames_received, self._frames_missed, self._frames_dropped,
+            self._packets_sent, self._ticks_rate_limited)
+
+    def start(self):
+        self._thread = threading.Thread(target=self._run)
+        self._thread.daemon = True
+        self._thread.start()
+
+    def stop(self):
+        self._stopping = True
+        if self._thread is not None:
+            self._thread.join()
+        self._socket.close()
+
+    def _receive(self, data, address):
+        self._reply_address = address
+        command, sequence, first_channel, stride, values = decode_frame(data)
+        if command == FRAME_CREDIT_REQUEST:
+            self._credit_requested = True
+        elif command == FRAME_DATA:
+            ahead = (sequence - self._next_sequence) & _SEQUENCE_MASK
+            if ahead >= 0x8000:
+                self._frames_dropped += 1
+                return
+            self._frames_missed += ahead
+            self._next_sequence = (sequence + 1) & _SEQUENCE_MASK
+            if len(self._slots) == self._n_slots:
+                self._frames_dropped += 1
+                self._n_drained_since_credit += 1
+            else:
+                self._slots.append([
+                    (first_channel + i * stride, value)
+                    for i, value in enumerate(values)])
+                self._frames_received += 1
+            self._n_drained_since_credit += ahead
+
+    def _drain(self):
+        n_sent = 0
+        while self._slots:
+            frame = self._slots[0]
+            if n_sent == self._values_per_tick:
+                self._ticks_rate_limited += 1
+                return
+            if self._next_value < len(frame):
+                self._delivered.append(frame[self._next_value])
+                self._packets_sent += 1
+                self._next_value += 1
+                n_sent += 1
+                continue
+            self._next_value = 0
+            self._slots.pop(0)
+            self._n_drained_since_credit += 1
+
+    def _run(self):
+        next_tick = time.time()
+        while not self._stopping:
+            wait = max(next_tick - time.time(), 0)
+            readable, _, _ = select.select([self._socket], [], [], wait)
+            if readable:
+                data, address = self._socket.recvfrom(1024)
+                self._receive(data, address)
+                continue
+            next_tick += self._tick_seconds
+            self._drain()
+            if self._reply_address is not None and (
+                    self._credit_requested or
+                    self._n_drained_since_credit >= self._credit_batch):
+                drained = self._next_sequence - len(self._slots)
+                self._socket.sendto(
+                    encode_credit(drained, self.counters),
+                    self._reply_address)
+                self._n_drained_since_credit = 0
+                self._credit_requested = False
@@ -0,0 +1,9 @@
+from .reduction_aggregator_vertex import ReductionAggregatorVertex, \
+    ReductionRootVertex
+from .sdram_mailbox_machine_edge import SDRAMMailboxMachineEdge
+from .stencil_tile_vertex import StencilTileVertex
+from .stream_injector_vertex import StreamInjectorVertex
+
+__all__ = ["ReductionAggregatorVertex", "ReductionRootVertex",
+           "SDRAMMailboxMachineEdge", "StencilTileVertex",
+           "StreamInjectorVertex"]
@@ -0,0 +1,310 @@
+# pacman imports
+from pacman.executor.injection_decorator import supports_injection, \
+    inject_items
+from pacman.model.decorators import overrides
+from pacman.model.graphs.machine import MachineVertex
+from pacman.model.resources import ResourceContainer
+from pacman.model.resources import CPUCyclesPerTickResource, DTCMResource
+from pacman.model.resources import SDRAMResource
+
+# spinn front end common imports
+from spinn_front_end_common.utilities import constants, helpful_functions
+from spinn_front_end_common.interface.simulation import simulation_utilities
+from spinn_front_end_common.interface.buffer_management.buffer_models \
+    import AbstractReceiveBuffersToHost
+from spinn_front_end_common.interface.buffer_management \
+    import recording_utilities
+from spinn_front_end_common.abstract_models.impl \
+    import MachineDataSpecableVertex
+from spinn_front_end_common.abstract_models \
+    import AbstractHasAssociatedBinary, AbstractProvidesNKeysForPartition
+from spinn_front_end_common.utilities.utility_objs import ExecutableStartType
+
+# graph front end imports
+from spinnaker_graph_front_end.abstract_models \
+    import AbstractHasRecordingSizing
+from spinnaker_graph_front_end.utilities.buffer_settings \
+    import get_buffer_settings
+from spinnaker_graph_front_end.utilities.recording_sizing \
+    import RecordingSizing
+from spinnaker_graph_front_end.utilities.reduction_tree \
+    import REDUCTION_PARTITION_ID
+
+# general imports
+from enum import Enum
+import struct
+
+
+class ReductionAggregatorVertex(
+        MachineVertex, MachineDataSpecableVertex, AbstractHasAssociatedBinary,
+        AbstractProvidesNKeysForPartition):
+    """ A core of a reduction tree combining the values of its children and\
+        sending the result to its parent
+    """
+
+    # has parent, key, n reductions, n children, has results, result key,
+    # result mask, completion reduction
+    PARAMETERS_SIZE = 8 * 4
+
+    # key and mask
+    CHILD_SIZE = 2 * 4
+
+    # value, n contributed and round, and a contributed flag per child
+    STATE_SIZE = 3 * 4
+
+    # Estimates of the cost of the binary
+    DTCM_BASE = 4 * 1024
+    CYCLES_BASE = 200
+    CYCLES_PER_PACKET = 150
+
+    DATA_REGIONS = Enum(
+        value="DATA_REGIONS",
+        names=[('SYSTEM', 0),
+               ('PARAMETERS', 1),
+               ('OPERATIONS', 2),
+               ('CHILDREN', 3),
+               ('RECORDED_DATA', 4)])
+
+    def __init__(self, label, reduction_tree, constraints=None):
+        """
+        :param label: the label of the vertex
+        :param reduction_tree: the tree the aggregator is part of
+        :type reduction_tree: ReductionTree
+        """
+        MachineVertex.__init__(self, label, constraints)
+        self._reduction_tree = reduction_tree
+        self._children = list()
+
+    def add_child(self, child):
+        """ Add a vertex whose values this aggregator combines
+        """
+        self._children.append(child)
+
+    @property
+    def children(self):
+        return self._children
+
+    @property
+    def is_root(self):
+        return False
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_file_name)
+    def get_binary_file_name(self):
+        return "reduction_aggregator.aplx"
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_start_type)
+    def get_binary_start_type(self):
+        return ExecutableStartType.USES_SIMULATION_INTERFACE
+
+    @overrides(AbstractProvidesNKeysForPartition.get_n_keys_for_partition)
+    def get_n_keys_for_partition(self, partition, graph_mapper):
+        return self._reduction_tree.n_reductions
+
+    @overrides(MachineDataSpecableVertex.generate_machine_data_specification)
+    def generate_machine_data_specification(
+            self, spec, placement, machine_graph, routing_info, iptags,
+            reverse_iptags, machine_time_step, time_scale_factor):
+        tree = self._reduction_tree
+
+        # reserve memory regions
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.SYSTEM.value,
+            size=constants.SYSTEM_BYTES_REQUIREMENT, label='systemInfo')
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.PARAMETERS.value,
+            size=self.PARAMETERS_SIZE, label="parameters")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.OPERATIONS.value,
+            size=tree.n_reductions * 4, label="operations")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.CHILDREN.value,
+            size=len(self._children) * self.CHILD_SIZE, label="children")
+        self._reserve_recording_region(spec)
+
+        # simulation.c requirements
+        spec.switch_write_focus(self.DATA_REGIONS.SYSTEM.value)
+        spec.write_array(simulation_utilities.get_simulation_header_array(
+            self.get_binary_file_name(), machine_time_step,
+            time_scale_factor))
+
+        spec.switch_write_focus(self.DATA_REGIONS.PARAMETERS.value)
+        if self.is_root:
+            spec.write_value(0)
+            spec.write_value(0)
+        else:
+            spec.write_value(1)
+            spec.write_value(routing_info.get_first_key_from_pre_vertex(
+                self, REDUCTION_PARTITION_ID))
+        spec.write_value(tree.n_reductions)
+        spec.write_value(len(self._children))
+
+        # the root sends the results, and the other aggregators receive them
+        # if they are to stop when every contributor is done
+        if tree.deliver_results and (
+                self.is_root or tree.completion_reduction is not None):
+            tree.write_result_keys(spec, routing_info)
+        else:
+            spec.write_array([0, 0, 0])
+        spec.write_value(tree.completion_parameter)
+
+        spec.switch_write_focus(self.DATA_REGIONS.OPERATIONS.value)
+        spec.write_array([operation.value for operation in tree.operations])
+
+        spec.switch_write_focus(self.DATA_REGIONS.CHILDREN.value)
+        for child in self._children:
+            key_and_mask = routing_info.get_routing_info_from_pre_vertex(
+                child, REDUCTION_PARTITION_ID).first_key_and_mask
+            spec.write_value(key_and_mask.key)
+            spec.write_value(key_and_mask.mask)
+
+        self._write_recording_region(spec, iptags)
+        spec.end_specification()
+
+    def _reserve_recording_region(self, spec):
+        pass
+
+    def _write_recording_region(self, spec, iptags):
+        pass
+
+    @property
+    @overrides(MachineVertex.resources_required)
+    def resources_required(self):
+        n_reductions = self._reduction_tree.n_reductions
+        n_children = len(self._children)
+        sdram = (
+            constants.SYSTEM_BYTES_REQUIREMENT + self.PARAMETERS_SIZE +
+            n_reductions * 4 + n_children * self.CHILD_SIZE)
+        dtcm = (
+            self.DTCM_BASE + n_reductions * (4 + self.STATE_SIZE) +
+            n_children * self.CHILD_SIZE + n_reductions * n_children)
+
+        # the worst tick has a value from every child for every reduction
+        cycles = (
+            self.CYCLES_BASE +
+            n_reductions * n_children * self.CYCLES_PER_PACKET)
+        return ResourceContainer(
+            sdram=SDRAMResource(sdram), dtcm=DTCMResource(dtcm),
+            cpu_cycles=CPUCyclesPerTickResource(cycles))
+
+    def __repr__(self):
+        return self.label
+
+
+@supports_injection
+class ReductionRootVertex(
+        ReductionAggregatorVertex, AbstractReceiveBuffersToHost,
+        AbstractHasRecordingSizing):
+    """ The root of a reduction tree, which records the result of each\
+        round of each reduction, and can send them back to the contributors
+    """
+
+    # round, reduction, value, n contributed
+    RECORD_SIZE = 4 * 4
+
+    def __init__(self, label, reduction_tree, constraints=None):
+        ReductionAggregatorVertex.__init__(
+            self, label, reduction_tree, constraints)
+
+        # the buffer settings are shared with the other vertices
+        self._buffer_settings = get_buffer_settings()
+
+        # the sizing of the recording region when it was last written
+        self._written_recording_sizing = None
+
+    @property
+    @overrides(ReductionAggregatorVertex.is_root)
+    def is_root(self):
+        return True
+
+    @inject_items({"n_machine_time_steps": "TotalMachineTimeSteps"})
+    @overrides(
+        ReductionAggregatorVertex.generate_machine_data_specification,
+        additional_arguments={"n_machine_time_steps"})
+    def generate_machine_data_specification(
+            self, spec, placement, machine_graph, routing_info, iptags,
+            reverse_iptags, machine_time_step, time_scale_factor,
+            n_machine_time_steps):
+        self._n_machine_time_steps = n_machine_time_steps
+        ReductionAggregatorVertex.generate_machine_data_specification(
+            self, spec, placement, machine_graph, routing_info, iptags,
+            reverse_iptags, machine_time_step, time_scale_factor)
+
+    @overrides(ReductionAggregatorVertex._reserve_recording_region)
+    def _reserve_recording_region(self, spec):
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.RECORDED_DATA.value,
+            size=recording_utilities.get_recording_header_size(1),
+            label="recording")
+
+    @overrides(ReductionAggregatorVertex._write_recording_region)
+    def _write_recording_region(self, spec, iptags):
+        spec.switch_write_focus(self.DATA_REGIONS.RECORDED_DATA.value)
+        sizing = self._recording_sizing(self._n_machine_time_steps)
+        spec.write_array(sizing.get_recording_header_array(iptags))
+        self._written_recording_sizing = sizing
+
+    @property
+    @overrides(AbstractHasRecordingSizing.recording_sizing)
+    def recording_sizing(self):
+        return self._written_recording_sizing
+
+    @property
+    @overrides(ReductionAggregatorVertex.resources_required)
+    def resources_required(self):
+        resources = ReductionAggregatorVertex.resources_required.fget(self)
+
+        # the length of the run is only known once the region is written;
+        # until then the region is sized for a run of any length
+        sizing = self._written_recording_sizing
+        if sizing is None:
+            sizing = self._recording_sizing()
+        resources.extend(sizing.get_recording_resources(
+            self._buffer_settings.receive_buffer_host,
+            self._buffer_settings.receive_buffer_port))
+        return resources
+
+    def _recording_sizing(self, n_machine_time_steps=None):
+
+        # a record for each reduction every period, spread over the ticks
+        tree = self._reduction_tree
+        bytes_per_tick = -(
+            -(self.RECORD_SIZE * tree.n_reductions) // tree.period)
+        return RecordingSizing(
+            [bytes_per_tick], n_machine_time_steps,
+            self._buffer_settings.buffer_size_before_receive,
+            self._buffer_settings.time_between_requests)
+
+    def read_records(self, buffer_manager, placement):
+        """ Read the results recorded by the root
+
+        :return: (round, reduction, value, n children contributed) of each\
+            result recorded
+        :rtype: list of (int, int, int, int)
+        """
+        reader, missing_data = buffer_manager.get_data_for_vertex(
+            placement, 0)
+        if missing_data:
+            raise Exception("missing results from {}".format(self.label))
+        raw_data = bytes(reader.read_all())
+        n_records = len(raw_data) // self.RECORD_SIZE
+        return [
+            struct.unpack_from("<4I", raw_data, i * self.RECORD_SIZE)
+            for i in range(n_records)]
+
+    @overrides(AbstractReceiveBuffersToHost.get_minimum_buffer_sdram_usage)
+    def get_minimum_buffer_sdram_usage(self):
+        return self._recording_sizing().minimum_buffer_sdram_usage
+
+    @overrides(AbstractReceiveBuffersToHost.get_n_timesteps_in_buffer_space)
+    def get_n_timesteps_in_buffer_space(self, buffer_space, machine_time_step):
+        return self._recording_sizing().get_n_timesteps_in_buffer_space(
+            buffer_space)
+
+    @overrides(AbstractReceiveBuffersToHost.get_recorded_region_ids)
+    def get_recorded_region_ids(self):
+        return [0]
+
+    @overrides(AbstractReceiveBuffersToHost.get_recording_region_base_address)
+    def get_recording_region_base_address(self, txrx, placement):
+        return helpful_functions.locate_memory_region_for_placement(
+            placement, self.DATA_REGIONS.RECORDED_DATA.value, txrx)
@@ -0,0 +1,50 @@
+from pacman.model.graphs.machine import MachineEdge
+
+
+class SDRAMMailboxMachineEdge(MachineEdge):
+    """ An edge whose data travels through a shared SDRAM mailbox when the\
+        pre and post vertices are placed on the same chip, and through\
+        multicast packets otherwise.  The choice is made per edge once the\
+        graph has been placed.
+    """
+
+    def __init__(
+            self, pre_vertex, post_vertex, n_words=1, label=None,
+            traffic_weight=1):
+        """
+        :param pre_vertex: the vertex at the start of the edge; must be an\
+            AbstractSDRAMMailboxProducer
+        :param post_vertex: the vertex at the end of the edge
+        :param n_words: the number of 32-bit words the pre vertex writes\
+            into its mailbox each timer tick
+        :param label: the label of the edge
+        :param traffic_weight: the optional weight of traffic expected to\
+            travel down this edge relative to other edges
+        """
+        MachineEdge.__init__(
+            self, pre_vertex, post_vertex, label=label,
+            traffic_weight=traffic_weight)
+        self._n_words = n_words
+
+    @property
+    def n_words(self):
+        """ The number of words passed through the mailbox per timer tick
+        """
+        return self._n_words
+
+    def uses_sdram(self, placements):
+        """ Determine if this edge is carried through SDRAM
+
+        :param placements: the placements of the machine graph
+        :return: True if both ends of the edge are on the same chip
+        :rtype: bool
+        """
+        pre = placements.get_placement_of_vertex(self.pre_vertex)
+        post = placements.get_placement_of_vertex(self.post_vertex)
+        return pre.x == post.x and pre.y == post.y
+
+    def __repr__(self):
+        return "SDRAMMailboxMachineEdge(pre_vertex={}, post_vertex={}, " \
+               "n_words={}, label={})".format(
+                   self.pre_vertex, self.post_vertex, self._n_words,
+                   self.label)
@@ -0,0 +1,260 @@
+# pacman imports
+from pacman.model.decorators import overrides
+from pacman.model.graphs.machine import MachineVertex
+from pacman.model.resources import ResourceContainer
+from pacman.model.resources import CPUCyclesPerTickResource, DTCMResource
+from pacman.model.resources import SDRAMResource
+
+# spinn front end common imports
+from spinn_front_end_common.utilities import constants, helpful_functions
+from spinn_front_end_common.interface.simulation import simulation_utilities
+from spinn_front_end_common.abstract_models.impl \
+    import MachineDataSpecableVertex
+from spinn_front_end_common.abstract_models \
+    import AbstractHasAssociatedBinary, AbstractProvidesNKeysForPartition
+from spinn_front_end_common.utilities.utility_objs import ExecutableStartType
+
+# graph front end imports
+from spinnaker_graph_front_end.abstract_models \
+    import AbstractCheckpointable, AbstractHasTickProfile
+from spinnaker_graph_front_end.utilities import tick_profile
+from spinnaker_graph_front_end.utilities.stencil_codegen \
+    import get_binary_name
+from spinnaker_graph_front_end.utilities.stencil_spec import UINT8
+
+# general imports
+from enum import Enum
+import struct
+
+# The struct format of a cell of each type
+_CELL_FORMATS = {UINT8: "B"}
+_DEFAULT_CELL_FORMAT = "i"
+
+
+class StencilTileVertex(
+        MachineVertex, MachineDataSpecableVertex, AbstractHasAssociatedBinary,
+        AbstractProvidesNKeysForPartition, AbstractHasTickProfile,
+        AbstractCheckpointable):
+    """ A core updating a tile of the cells of a stencil grid with the\
+        kernel generated for the stencil
+    """
+
+    PARTITION_ID = "STENCIL"
+
+    # has key, key, n incoming, n local
+    PARAMETERS_SIZE = 4 * 4
+
+    # key, mask, offset x and offset y
+    INCOMING_SIZE = 4 * 4
+
+    # The most neighbouring tiles, one on each side and corner
+    MAX_INCOMING = 8
+
+    # Estimates of the cost of the binary
+    DTCM_BASE = 8 * 1024
+    CYCLES_BASE = 2000
+    CYCLES_PER_CELL = 20
+    CYCLES_PER_NEIGHBOUR = 4
+    CYCLES_PER_BORDER_CELL = 40
+
+    DATA_REGIONS = Enum(
+        value="DATA_REGIONS",
+        names=[('SYSTEM', 0),
+               ('PARAMETERS', 1),
+               ('STATE', 2),
+               ('INCOMING', 3),
+               ('TICK_PROFILE', 4)])
+
+    def __init__(self, label, spec, cells):
+        """
+        :param label: the label of the vertex
+        :param spec: the stencil
+        :type spec: StencilSpec
+        :param cells: the initial cells of the tile in row order, as\
+            stored by the kernel (fixed point for S1615 cells)
+        """
+        MachineVertex.__init__(self, label)
+        self._spec = spec
+        self._binary_name = get_binary_name(spec)
+        self._cells = list(cells)
+
+        # the neighbouring tiles sending cells to this one, with where their
+        # cells go in the padded grid of this one, and where the cells of
+        # this tile go for each side it is its own neighbour on
+        self._incoming = list()
+        self._local = list()
+
+    @property
+    def spec(self):
+        return self._spec
+
+    @property
+    def cells(self):
+        """ The cells of the tile the next run starts from
+        """
+        return list(self._cells)
+
+    def add_incoming(self, vertex, offset_x, offset_y):
+        """ Say that the cells of a tile go in the padded grid of this one
+
+        :param vertex: the neighbouring tile, which may be this one
+        :param offset_x: what is added to the x of a cell of the tile to\
+            get its x in the padded grid
+        :param offset_y: likewise for y
+        """
+        if vertex is self:
+            self._local.append((offset_x, offset_y))
+        else:
+            self._incoming.append((vertex, offset_x, offset_y))
+
+    @property
+    def _cell_format(self):
+        return "<{}{}".format(self._spec.n_cells, _CELL_FORMATS.get(
+            self._spec.cell_type, _DEFAULT_CELL_FORMAT))
+
+    @property
+    def _cell_size(self):
+        return struct.calcsize(_CELL_FORMATS.get(
+            self._spec.cell_type, _DEFAULT_CELL_FORMAT))
+
+    @property
+    def _state_size(self):
+        size = struct.calcsize(self._cell_format)
+        return (size + 3) & ~3
+
+    def _pack_cells(self):
+        data = struct.pack(self._cell_format, *self._cells)
+        return data + b"\0" * (self._state_size - len(data))
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_file_name)
+    def get_binary_file_name(self):
+        return self._binary_name
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_start_type)
+    def get_binary_start_type(self):
+        return ExecutableStartType.USES_SIMULATION_INTERFACE
+
+    @overrides(AbstractProvidesNKeysForPartition.get_n_keys_for_partition)
+    def get_n_keys_for_partition(self, partition, graph_mapper):
+
+        # a key per cell for each parity of iteration
+        return 2 * self._spec.n_cells
+
+    @overrides(MachineDataSpecableVertex.generate_machine_data_specification)
+    def generate_machine_data_specification(
+            self, spec, placement, machine_graph, routing_info, iptags,
+            reverse_iptags, machine_time_step, time_scale_factor):
+        n_entries = len(self._incoming) + len(self._local)
+
+        # reserve memory regions
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.SYSTEM.value,
+            size=constants.SYSTEM_BYTES_REQUIREMENT, label='systemInfo')
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.PARAMETERS.value,
+            size=self.PARAMETERS_SIZE, label="parameters")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.STATE.value,
+            size=self._state_size, label="state")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.INCOMING.value,
+            size=max(n_entries * self.INCOMING_SIZE, 4), label="incoming")
+        tick_profile.reserve_tick_profile_region(
+            spec, self.DATA_REGIONS.TICK_PROFILE.value)
+
+        # simulation.c requirements
+        spec.switch_write_focus(self.DATA_REGIONS.SYSTEM.value)
+        spec.write_array(simulation_utilities.get_simulation_header_array(
+            self.get_binary_file_name(), machine_time_step,
+            time_scale_factor))
+
+        # the parameters; there is no key if no other tile neighbours this
+        key = routing_info.get_first_key_from_pre_vertex(
+            self, self.PARTITION_ID)
+        spec.switch_write_focus(self.DATA_REGIONS.PARAMETERS.value)
+        spec.write_value(0 if key is None else 1)
+        spec.write_value(0 if key is None else key)
+        spec.write_value(len(self._incoming))
+        spec.write_value(len(self._local))
+
+        # the cells of the tile
+        spec.switch_write_focus(self.DATA_REGIONS.STATE.value)
+        spec.write_array(list(struct.unpack(
+            "<{}I".format(self._state_size // 4), self._pack_cells())))
+
+        # the neighbouring tiles, then the sides this tile neighbours itself
+        spec.switch_write_focus(self.DATA_REGIONS.INCOMING.value)
+        for vertex, offset_x, offset_y in self._incoming:
+            key_and_mask = routing_info.get_routing_info_from_pre_vertex(
+                vertex, self.PARTITION_ID).first_key_and_mask
+            spec.write_value(key_and_mask.key)
+            spec.write_value(key_and_mask.mask)
+            spec.write_value(offset_x & 0xFFFFFFFF)
+            spec.write_value(offset_y & 0xFFFFFFFF)
+        for offset_x, offset_y in self._local:
+            spec.write_value(0)
+            spec.write_value(0)
+            spec.write_value(offset_x & 0xFFFFFFFF)
+            spec.write_value(offset_y & 0xFFFFFFFF)
+
+        spec.end_specification()
+
+    @property
+    @overrides(MachineVertex.resources_required)
+    def resources_required(self):
+        stencil = self._spec
+        padded_cells = (
+            (stencil.tile_width + 2 * stencil.radius) *
+            (stencil.tile_height + 2 * stencil.radius))
+        n_border_cells = len(stencil.border_cells)
+        sdram = (
+            constants.SYSTEM_BYTES_REQUIREMENT + self.PARAMETERS_SIZE +
+            self._state_size + self.MAX_INCOMING * self.INCOMING_SIZE +
+            tick_profile.TICK_PROFILE_REGION_SIZE)
+        dtcm = (
+            self.DTCM_BASE + 2 * padded_cells * self._cell_size +
+            self.MAX_INCOMING * self.INCOMING_SIZE)
+        cycles = (
+            self.CYCLES_BASE + stencil.n_cells * (
+                self.CYCLES_PER_CELL +
+                len(stencil.neighbourhood) * self.CYCLES_PER_NEIGHBOUR) +
+            n_border_cells * self.CYCLES_PER_BORDER_CELL)
+        return ResourceContainer(
+            sdram=SDRAMResource(sdram), dtcm=DTCMResource(dtcm),
+            cpu_cycles=CPUCyclesPerTickResource(cycles))
+
+    def read_cells(self, transceiver, placement):
+        """ Read the cells of the tile when the run paused
+
+        :return: the cells in row order, as stored by the kernel
+        :rtype: list of int
+        """
+        address = helpful_functions.locate_memory_region_for_placement(
+            placement, self.DATA_REGIONS.STATE.value, transceiver)
+        data = transceiver.read_memory(
+            placement.x, placement.y, address, self._state_size)
+        return list(struct.unpack_from(self._cell_format, bytes(data)))
+
+    @property
+    @overrides(AbstractHasTickProfile.tick_profile_region_id)
+    def tick_profile_region_id(self):
+        return self.DATA_REGIONS.TICK_PROFILE.value
+
+    @property
+    @overrides(AbstractCheckpointable.checkpoint_region_id)
+    def checkpoint_region_id(self):
+        return self.DATA_REGIONS.STATE.value
+
+    @property
+    @overrides(AbstractCheckpointable.checkpoint_size_in_bytes)
+    def checkpoint_size_in_bytes(self):
+        return self._state_size
+
+    @overrides(AbstractCheckpointable.restore_checkpoint)
+    def restore_checkpoint(self, state):
+
+        # the tile carries on from the iteration it paused at
+        self._cells = list(struct.unpack_from(self._cell_format, state))
+
+    def __repr__(self):
+        return self.label
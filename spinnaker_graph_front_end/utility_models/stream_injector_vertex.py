@@ -0,0 +1,191 @@
+# pacman imports
+from pacman.model.decorators import overrides
+from pacman.model.graphs.machine import MachineVertex
+from pacman.model.resources import ResourceContainer
+from pacman.model.resources import CPUCyclesPerTickResource, DTCMResource
+from pacman.model.resources import SDRAMResource
+from pacman.model.resources import IPtagResource, ReverseIPtagResource
+
+# spinn front end common imports
+from spinn_front_end_common.utilities import constants, helpful_functions
+from spinn_front_end_common.interface.simulation import simulation_utilities
+from spinn_front_end_common.abstract_models.impl \
+    import MachineDataSpecableVertex
+from spinn_front_end_common.abstract_models \
+    import AbstractHasAssociatedBinary, AbstractProvidesNKeysForPartition
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+from spinn_front_end_common.utilities.utility_objs import ExecutableStartType
+
+# graph front end imports
+from spinnaker_graph_front_end.utilities.input_stream import \
+    InjectorCounters, MAX_CHANNEL, MAX_VALUES_PER_FRAME, STREAM_SDP_PORT
+
+# general imports
+from enum import Enum
+import struct
+
+
+class StreamInjectorVertex(
+        MachineVertex, MachineDataSpecableVertex, AbstractHasAssociatedBinary,
+        AbstractProvidesNKeysForPartition):
+    """ A core receiving frames of values from the host through a reverse\
+        IP tag and sending each value as a multicast packet with the key of\
+        its channel, at a limited rate, telling the host through an IP tag\
+        how much of its buffer is free (see InputStream)
+    """
+
+    PARTITION_ID = "STREAM"
+
+    # has key, key, n channels, n slots, max packets per tick, credit batch,
+    # reply tag
+    PARAMETERS_SIZE = 7 * 4
+
+    # frames received, missed and dropped, packets sent, ticks rate limited
+    COUNTERS_SIZE = 5 * 4
+
+    # command, sequence, first channel, stride, n values, then the values
+    FRAME_SIZE = 8 + MAX_VALUES_PER_FRAME * 4
+
+    # Estimates of the cost of the binary
+    DTCM_BASE = 4 * 1024
+    CYCLES_BASE = 500
+    CYCLES_PER_PACKET = 100
+
+    DATA_REGIONS = Enum(
+        value="DATA_REGIONS",
+        names=[('SYSTEM', 0),
+               ('PARAMETERS', 1),
+               ('COUNTERS', 2)])
+
+    def __init__(
+            self, label, n_channels, port, reply_host, reply_port,
+            n_slots=16, packets_per_tick=64, credit_batch=4,
+            constraints=None):
+        """
+        :param label: the label of the vertex
+        :param n_channels: the number of channels, each sent with its own key
+        :param port: the port of the reverse IP tag the frames are sent to
+        :param reply_host: the host the credit is sent to
+        :param reply_port: the port the credit is sent to, which is that the\
+            frames are sent from
+        :param n_slots: the number of frames buffered, which is the most\
+            the host can have in flight
+        :param packets_per_tick: the most packets sent each tick
+        :param credit_batch: the number of frames drained after which the\
+            host is told
+        """
+        if not 0 < n_channels <= MAX_CHANNEL + 1:
+            raise ConfigurationException(
+                "A stream has between 1 and {} channels".format(
+                    MAX_CHANNEL + 1))
+        if n_slots < 1 or packets_per_tick < 1 or \
+                not 0 < credit_batch <= n_slots:
+            raise ConfigurationException(
+                "A stream needs a slot, a packet a tick and a credit batch "
+                "of at most the number of slots")
+        MachineVertex.__init__(self, label, constraints)
+        self._n_channels = n_channels
+        self._port = port
+        self._reply_host = reply_host
+        self._reply_port = reply_port
+        self._n_slots = n_slots
+        self._packets_per_tick = packets_per_tick
+        self._credit_batch = credit_batch
+
+    @property
+    def n_channels(self):
+        return self._n_channels
+
+    @property
+    def port(self):
+        return self._port
+
+    @property
+    def reply_port(self):
+        return self._reply_port
+
+    @property
+    def n_slots(self):
+        return self._n_slots
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_file_name)
+    def get_binary_file_name(self):
+        return "stream_injector.aplx"
+
+    @overrides(AbstractHasAssociatedBinary.get_binary_start_type)
+    def get_binary_start_type(self):
+        return ExecutableStartType.USES_SIMULATION_INTERFACE
+
+    @overrides(AbstractProvidesNKeysForPartition.get_n_keys_for_partition)
+    def get_n_keys_for_partition(self, partition, graph_mapper):
+        return self._n_channels
+
+    @overrides(MachineDataSpecableVertex.generate_machine_data_specification)
+    def generate_machine_data_specification(
+            self, spec, placement, machine_graph, routing_info, iptags,
+            reverse_iptags, machine_time_step, time_scale_factor):
+
+        # reserve memory regions
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.SYSTEM.value,
+            size=constants.SYSTEM_BYTES_REQUIREMENT, label='systemInfo')
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.PARAMETERS.value,
+            size=self.PARAMETERS_SIZE, label="parameters")
+        spec.reserve_memory_region(
+            region=self.DATA_REGIONS.COUNTERS.value,
+            size=self.COUNTERS_SIZE, label="counters")
+
+        # simulation.c requirements
+        spec.switch_write_focus(self.DATA_REGIONS.SYSTEM.value)
+        spec.write_array(simulation_utilities.get_simulation_header_array(
+            self.get_binary_file_name(), machine_time_step,
+            time_scale_factor))
+
+        # the parameters; there is no key if nothing receives the stream
+        key = routing_info.get_first_key_from_pre_vertex(
+            self, self.PARTITION_ID)
+        spec.switch_write_focus(self.DATA_REGIONS.PARAMETERS.value)
+        spec.write_value(0 if key is None else 1)
+        spec.write_value(0 if key is None else key)
+        spec.write_value(self._n_channels)
+        spec.write_value(self._n_slots)
+        spec.write_value(self._packets_per_tick)
+        spec.write_value(self._credit_batch)
+        spec.write_value(iptags[0].tag)
+
+        spec.switch_write_focus(self.DATA_REGIONS.COUNTERS.value)
+        spec.write_array([0] * (self.COUNTERS_SIZE // 4))
+
+        spec.end_specification()
+
+    @property
+    @overrides(MachineVertex.resources_required)
+    def resources_required(self):
+        sdram = (
+            constants.SYSTEM_BYTES_REQUIREMENT + self.PARAMETERS_SIZE +
+            self.COUNTERS_SIZE)
+        dtcm = self.DTCM_BASE + self._n_slots * self.FRAME_SIZE
+        cycles = self.CYCLES_BASE + (
+            self._packets_per_tick * self.CYCLES_PER_PACKET)
+        return ResourceContainer(
+            sdram=SDRAMResource(sdram), dtcm=DTCMResource(dtcm),
+            cpu_cycles=CPUCyclesPerTickResource(cycles),
+            iptags=[IPtagResource(
+                self._reply_host, self._reply_port, strip_sdp=True)],
+            reverse_iptags=[ReverseIPtagResource(
+                self._port, sdp_port=STREAM_SDP_PORT)])
+
+    def read_counters(self, transceiver, placement):
+        """ Read the counters of the injector when the run paused
+
+        :rtype: InjectorCounters
+        """
+        address = helpful_functions.locate_memory_region_for_placement(
+            placement, self.DATA_REGIONS.COUNTERS.value, transceiver)
+        data = transceiver.read_memory(
+            placement.x, placement.y, address, self.COUNTERS_SIZE)
+        return InjectorCounters(*struct.unpack_from("<5I", bytes(data)))
+
+    def __repr__(self):
+        return self.label
@@ -0,0 +1,33 @@
+""" Stand-ins for the objects of the tool chain shared by the tests
+"""
+
+
+class Object(object):
+    """ An object with the attributes it is given
+    """
+
+    def __init__(self, **kwargs):
+        self.__dict__.update(kwargs)
+
+
+class Spec(object):
+    """ The regions reserved in a data specification, and the words written\
+        to them
+    """
+
+    def __init__(self):
+        self.sizes = dict()
+        self.regions = dict()
+        self._region = None
+
+    def reserve_memory_region(self, region, size, label=None):
+        self.sizes[region] = size
+
+    def switch_write_focus(self, region):
+        self._region = self.regions.setdefault(region, list())
+
+    def write_value(self, value):
+        self._region.append(value)
+
+    def write_array(self, values):
+        self._region.extend(int(value) for value in values)
@@ -0,0 +1,54 @@
+import os
+import shutil
+import tempfile
+import unittest
+
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.utilities.checkpoint import Checkpoint
+
+
+class TestCheckpoint(unittest.TestCase):
+
+    def setUp(self):
+        self._folder = tempfile.mkdtemp()
+        self._path = os.path.join(self._folder, "test.checkpoint")
+
+    def tearDown(self):
+        shutil.rmtree(self._folder)
+
+    def test_save_and_load(self):
+        checkpoint = Checkpoint(50, 1000, 2)
+        checkpoint.add_state("cell0", b"\x01\x00\x00\x00")
+        checkpoint.add_state("cell1", b"")
+        checkpoint.add_state("cell2", bytearray(b"\x00" * 400))
+        checkpoint.save(self._path)
+
+        loaded = Checkpoint.load(self._path)
+        self.assertEqual(loaded.n_machine_time_steps, 50)
+        self.assertEqual(loaded.machine_time_step, 1000)
+        self.assertEqual(loaded.time_scale_factor, 2)
+        self.assertEqual(loaded.labels, ["cell0", "cell1", "cell2"])
+        self.assertEqual(loaded.get_state("cell0"), b"\x01\x00\x00\x00")
+        self.assertEqual(loaded.get_state("cell1"), b"")
+        self.assertEqual(loaded.get_state("cell2"), b"\x00" * 400)
+        self.assertIsNone(loaded.get_state("cell3"))
+
+        # the repeated state is compressed
+        self.assertLess(os.path.getsize(self._path), 400)
+
+    def test_labels_must_be_unique(self):
+        checkpoint = Checkpoint(50, 1000, 1)
+        checkpoint.add_state("cell", b"\x01")
+        with self.assertRaises(ConfigurationException):
+            checkpoint.add_state("cell", b"\x00")
+
+    def test_load_rejects_other_files(self):
+        with open(self._path, "wb") as f:
+            f.write(b"not a checkpoint")
+        with self.assertRaises(ConfigurationException):
+            Checkpoint.load(self._path)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,123 @@
+import struct
+import unittest
+
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.examples.Conways.\
+    partitioned_example_b_no_vis_buffer.conways_fabric import ConwayFabric
+from spinnaker_graph_front_end.utilities import buffer_settings
+
+
+class _Config(object):
+    """ The [Buffers] section of a config
+    """
+
+    _VALUES = {
+        "enable_buffered_recording": "True",
+        "buffer_size_before_receive": "16384",
+        "time_between_requests": "50",
+        "receive_buffer_host": "0.0.0.0",
+        "receive_buffer_port": "None"}
+
+    def get(self, section, option):
+        return self._VALUES[option]
+
+    def getint(self, section, option):
+        return int(self._VALUES[option])
+
+    def getboolean(self, section, option):
+        return self._VALUES[option] == "True"
+
+
+class _Simulator(object):
+    def __init__(self):
+        self.config = _Config()
+
+
+class _GlobalsVariables(object):
+    """ Holds the current simulator in place of the global one
+    """
+
+    def __init__(self):
+        self.simulator = _Simulator()
+
+    def get_simulator(self):
+        return self.simulator
+
+
+class TestConwayFabric(unittest.TestCase):
+
+    def setUp(self):
+        self._globals_variables = buffer_settings.globals_variables
+        buffer_settings.globals_variables = _GlobalsVariables()
+
+    def tearDown(self):
+        buffer_settings.globals_variables = self._globals_variables
+
+    def test_too_small(self):
+        with self.assertRaises(ConfigurationException):
+            ConwayFabric(2, 5)
+
+    def test_indices(self):
+        fabric = ConwayFabric(4, 3, label="f")
+        self.assertEqual(fabric.index_of(1, 2), 9)
+        self.assertEqual(fabric.coordinates_of(9), (1, 2))
+        for index in range(12):
+            self.assertEqual(
+                fabric.index_of(*fabric.coordinates_of(index)), index)
+
+        # the fabric is a torus
+        self.assertEqual(fabric.index_of(-1, 0), 3)
+        self.assertEqual(fabric.index_of(4, 3), 0)
+        self.assertEqual(fabric.index_of(0, -1), 8)
+
+        self.assertEqual(fabric.label_of(9), "f_1_2")
+        cell = fabric.cell(1, 2)
+        self.assertEqual(cell.label, "f_1_2")
+        self.assertEqual(cell.coordinates, (1, 2))
+        self.assertIs(fabric.cell(5, -1), cell)
+
+    def test_count_neighbour_states(self):
+        fabric = ConwayFabric(4, 3, alive=[(3, 2), (1, 0), (0, 1)])
+
+        # the neighbours of (0, 0) to the south and west wrap around
+        self.assertEqual(
+            fabric.count_neighbour_states(fabric.index_of(0, 0)), (3, 5))
+        self.assertEqual(
+            fabric.count_neighbour_states(fabric.index_of(2, 1)), (2, 6))
+        self.assertEqual(
+            fabric.cell(0, 0)._count_neighbour_states(None), (3, 5))
+
+    def test_restore_checkpoint(self):
+        fabric = ConwayFabric(3, 3, alive=[(1, 1)])
+        cell = fabric.cell(1, 1)
+        self.assertTrue(cell.state)
+        cell.restore_checkpoint(struct.pack("<I", 0))
+        self.assertFalse(cell.state)
+        self.assertFalse(fabric.get_state(fabric.index_of(1, 1)))
+
+        fabric.cell(2, 0).restore_checkpoint(struct.pack("<I", 1))
+        self.assertTrue(fabric.get_state(fabric.index_of(2, 0)))
+        self.assertEqual(
+            fabric.count_neighbour_states(fabric.index_of(0, 0)), (1, 7))
+
+    def test_buffer_settings_cached(self):
+        settings = buffer_settings.get_buffer_settings()
+        self.assertIs(buffer_settings.get_buffer_settings(), settings)
+        self.assertEqual(settings.buffer_size_before_receive, 16384)
+        self.assertEqual(settings.time_between_requests, 50)
+
+        # the cells of a fabric share the settings of the simulator
+        fabric = ConwayFabric(3, 3, record_changes_only=True)
+        self.assertIs(fabric.buffer_settings, settings)
+        self.assertIs(fabric.cell(0, 0).buffer_settings, settings)
+        self.assertIs(fabric.cell(2, 1).buffer_settings, settings)
+        self.assertTrue(fabric.cell(2, 1).record_changes_only)
+
+        # another simulator reads the settings again
+        buffer_settings.globals_variables.simulator = _Simulator()
+        self.assertIsNot(buffer_settings.get_buffer_settings(), settings)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,47 @@
+import unittest
+
+from spinn_front_end_common.utilities.exceptions import SpinnFrontEndException
+
+from spinnaker_graph_front_end.utilities.delta_recording import \
+    decode_transitions, encode_transitions, encode_varint, expand_transitions
+
+
+class TestDeltaRecording(unittest.TestCase):
+
+    def test_varint(self):
+        self.assertEqual(encode_varint(0), bytearray([0]))
+        self.assertEqual(encode_varint(127), bytearray([127]))
+        self.assertEqual(encode_varint(128), bytearray([0x80, 0x01]))
+        self.assertEqual(
+            encode_varint(0xFFFFFFFF),
+            bytearray([0xFF, 0xFF, 0xFF, 0xFF, 0x0F]))
+
+    def test_round_trip_with_padding(self):
+        transitions = [(0, 1), (1, 0), (200, 1), (70000, 0xFFFFFFFF),
+                       (70001, 0)]
+        data = encode_transitions(transitions)
+
+        # the ticks since the last record come first, then the value
+        self.assertEqual(data[:4], bytearray([1, 1, 1, 0]))
+
+        # blocks are padded to whole words with zeros, between records
+        padded = data[:4] + bytearray(4) + data[4:7] + bytearray(1) + \
+            data[7:] + bytearray(3)
+        self.assertEqual(decode_transitions(padded), transitions)
+
+    def test_truncated(self):
+        with self.assertRaises(SpinnFrontEndException):
+            decode_transitions(bytearray([5, 0x80]))
+
+    def test_expand(self):
+        transitions = [(0, 1), (3, 0), (4, 1)]
+        self.assertEqual(
+            expand_transitions(transitions, 7), [1, 1, 1, 0, 1, 1, 1])
+        self.assertEqual(expand_transitions(transitions, 2), [1, 1])
+        self.assertEqual(
+            expand_transitions([(2, 5)], 4, initial_value=9), [9, 9, 5, 5])
+        self.assertEqual(expand_transitions([], 3), [0, 0, 0])
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,83 @@
+import unittest
+from collections import namedtuple
+
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.utilities.graph_batch import GraphBatch
+
+_Edge = namedtuple("_Edge", "pre_vertex post_vertex label")
+
+
+class _Placements(object):
+
+    def get_placement_of_vertex(self, vertex):
+        return "placement of " + vertex
+
+
+class TestGraphBatch(unittest.TestCase):
+
+    def _batch(self, prefix_bits=8):
+        self.vertices = list()
+        self.edges = list()
+        return GraphBatch(
+            self.vertices.append,
+            lambda edge, partition: self.edges.append((edge, partition)),
+            prefix_bits)
+
+    def test_graphs_have_disjoint_keys(self):
+        batch = self._batch(prefix_bits=4)
+        graphs = [batch.add_graph(name) for name in ("a", "b", "c")]
+        self.assertEqual(
+            [graph.base_key for graph in graphs],
+            [0x00000000, 0x10000000, 0x20000000])
+        self.assertEqual(graphs[0].n_keys, 1 << 28)
+        self.assertTrue(graphs[1].owns_key(0x1FFFFFFF))
+        self.assertFalse(graphs[1].owns_key(0x20000000))
+
+        # the same lattice in each graph has keys in the range of the graph
+        for graph in graphs:
+            keys = graph.lattice_keys(7, 7, 2)
+            self.assertTrue(graph.owns_key(keys.key(6, 6)))
+            self.assertEqual(keys.coordinates(keys.key(3, 5)), (3, 5))
+
+    def test_edges_stay_in_their_graph(self):
+        batch = self._batch()
+        a = batch.add_graph("a")
+        b = batch.add_graph("b")
+        a.add_machine_vertex_instance("a0")
+        a.add_machine_vertex_instance("a1")
+        b.add_machine_vertex_instance("b0")
+        self.assertEqual(self.vertices, ["a0", "a1", "b0"])
+        a.add_machine_edge_instance(_Edge("a0", "a1", "e"), "STATE")
+        self.assertEqual(len(self.edges), 1)
+        with self.assertRaises(ConfigurationException):
+            a.add_machine_edge_instance(_Edge("a0", "b0", "e"), "STATE")
+        with self.assertRaises(ConfigurationException):
+            b.add_machine_edge_instance(_Edge("a1", "b0", "e"), "STATE")
+        self.assertIs(batch.graph_of("b0"), b)
+        self.assertIsNone(batch.graph_of("c0"))
+
+    def test_results_by_graph(self):
+        batch = self._batch()
+        for name in ("x", "y"):
+            graph = batch.add_graph(name)
+            for i in range(3):
+                graph.add_machine_vertex_instance("{}{}".format(name, i))
+        results = batch.collect(
+            _Placements(), lambda vertex, placement: (vertex, placement))
+        self.assertEqual(list(results), ["x", "y"])
+        self.assertEqual(list(results["y"]), ["y0", "y1", "y2"])
+        self.assertEqual(results["x"]["x1"], ("x1", "placement of x1"))
+
+    def test_batch_is_full(self):
+        batch = self._batch(prefix_bits=1)
+        batch.add_graph("a")
+        batch.add_graph("b")
+        with self.assertRaises(ConfigurationException):
+            batch.add_graph("c")
+        with self.assertRaises(ConfigurationException):
+            batch.add_graph("a")
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -17,7 +17,16 @@ EXCLUSIONS = ["spinnaker_graph_front_end.examples.Conways."
               "spinnaker_graph_front_end.examples.Conways."
               "partitioned_example_b_no_vis_buffer.conways_partitioned",
 
+              "spinnaker_graph_front_end.examples.Conways."
+              "partitioned_example_b_no_vis_buffer.conways_sweep",
+
+              "spinnaker_graph_front_end.examples.Conways."
+              "partitioned_example_b_no_vis_buffer.conways_large",
+
               "spinnaker_graph_front_end.examples.hello_world.hello_world",
+              "spinnaker_graph_front_end.examples.page_rank.page_rank",
+              "spinnaker_graph_front_end.examples.sssp.sssp",
+              "spinnaker_graph_front_end.examples.stencil.stencil_life",
               "spinnaker_graph_front_end.examples.template.python_template"]
 
 
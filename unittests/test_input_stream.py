@@ -0,0 +1,77 @@
+import unittest
+
+from spinn_front_end_common.utilities.exceptions import SpinnFrontEndException
+
+from spinnaker_graph_front_end.utilities.input_stream import \
+    InjectorCounters, InputStream, MAX_VALUES_PER_FRAME, decode_credit, \
+    decode_frame, encode_credit, encode_frame, make_runs
+from spinnaker_graph_front_end.utilities.udp_injector_stand_in \
+    import UDPInjectorStandIn
+
+
+class TestInputStream(unittest.TestCase):
+
+    def test_runs(self):
+        items = [(3, 10), (3, 11), (3, 12), (5, 1), (6, 2), (7, 3), (2, 9)]
+        self.assertEqual(make_runs(items), [
+            (3, 0, [10, 11, 12]), (5, 1, [1, 2, 3]), (2, 0, [9])])
+        self.assertEqual(make_runs([]), [])
+
+    def test_runs_fill_frames(self):
+        items = [(0, value) for value in range(MAX_VALUES_PER_FRAME + 1)]
+        runs = make_runs(items)
+        self.assertEqual(len(runs[0][2]), MAX_VALUES_PER_FRAME)
+        self.assertEqual(runs[1], (0, 0, [MAX_VALUES_PER_FRAME]))
+
+    def test_frame_and_credit_round_trip(self):
+        frame = encode_frame(0x10002, 7, 1, [1, -1, 5])
+        self.assertEqual(len(frame), 8 + 3 * 4)
+        self.assertEqual(
+            decode_frame(frame), (1, 2, 7, 1, [1, 0xFFFFFFFF, 5]))
+
+        credit = encode_credit(9, InjectorCounters(1, 2, 3, 4, 5))
+        self.assertEqual(len(credit), 24)
+        drained, counters = decode_credit(credit)
+        self.assertEqual(drained, 9)
+        self.assertEqual(counters.as_words(), (1, 2, 3, 4, 5))
+        self.assertIsNone(decode_credit(frame))
+
+    def test_stream_to_stand_in(self):
+
+        # a small window and a slow drain, so the stream waits for credit
+        stand_in = UDPInjectorStandIn(
+            n_slots=2, values_per_tick=16, tick_seconds=0.001)
+        stand_in.start()
+        try:
+            stream = InputStream("127.0.0.1", stand_in.port, window=2)
+            expected = list()
+            for sample in range(20):
+                values = [sample * 100 + channel for channel in range(8)]
+                stream.send_sample(values)
+                expected.extend(enumerate(values))
+            stream.send_values(3, range(200))
+            expected.extend((3, value) for value in range(200))
+            stream.close()
+            self.assertEqual(stand_in.delivered, expected)
+            statistics = stream.statistics
+            self.assertEqual(statistics.values_sent, len(expected))
+            self.assertGreater(statistics.credit_waits, 0)
+            self.assertEqual(statistics.injector_counters.frames_dropped, 0)
+            self.assertEqual(
+                statistics.injector_counters.packets_sent, len(expected))
+        finally:
+            stand_in.stop()
+
+    def test_no_injector(self):
+        stand_in = UDPInjectorStandIn(n_slots=1, values_per_tick=1)
+        port = stand_in.port
+        stand_in.stop()
+        stream = InputStream(
+            "127.0.0.1", port, window=1, timeout=0.01, max_requests=3)
+        stream.send(0, 1)
+        with self.assertRaises(SpinnFrontEndException):
+            stream.flush()
+
+
+if __name__ == '__main__':
+    unittest.main()
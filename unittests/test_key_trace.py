@@ -0,0 +1,157 @@
+import os
+import shutil
+import struct
+import tempfile
+import unittest
+
+from spinnaker_graph_front_end.utilities.key_trace import \
+    KEY_TRACE_REPORT, KeyTrace, KeyTraceReport, decode_key_trace, \
+    get_traced_partitions, trace_route
+
+from unittests.fakes import Object
+
+
+class _Graph(object):
+    """ Edges to vertices, and the partitions of the edges
+    """
+
+    def __init__(self, partitions):
+        self._partitions = partitions
+
+    def get_edges_ending_at_vertex(self, vertex):
+        return [
+            edge for partition in self._partitions
+            for edge in partition.edges if edge.post_vertex is vertex]
+
+    def get_outgoing_partition_for_edge(self, edge):
+        for partition in self._partitions:
+            if edge in partition.edges:
+                return partition
+
+
+class _Machine(object):
+    """ Chips in a line along x, joined east to west
+    """
+
+    max_chip_y = 0
+
+    def __init__(self, width):
+        self.max_chip_x = width - 1
+
+    def is_chip_at(self, x, y):
+        return y == 0 and 0 <= x <= self.max_chip_x
+
+    def get_chip_at(self, x, y):
+        links = dict()
+        if x < self.max_chip_x:
+            links[0] = Object(destination_x=x + 1, destination_y=0)
+        if x > 0:
+            links[3] = Object(destination_x=x - 1, destination_y=0)
+        return Object(router=Object(get_link=links.get))
+
+
+class _RouterTables(object):
+    def __init__(self, tables):
+        self._tables = tables
+
+    def get_routing_table_for_chip(self, x, y):
+        return self._tables.get((x, y))
+
+
+def _entry(key, mask, link_ids):
+    return Object(routing_entry_key=key, mask=mask, link_ids=link_ids)
+
+
+def _partition(pre_vertex, *post_vertices):
+    return Object(pre_vertex=pre_vertex, edges=[
+        Object(pre_vertex=pre_vertex, post_vertex=post_vertex)
+        for post_vertex in post_vertices])
+
+
+class TestKeyTrace(unittest.TestCase):
+
+    def test_decode(self):
+        data = struct.pack(
+            "<10I", 4, 2, 100, 3, 0x10, 0xFFFFFFF0, 5, 0x20, 0xFFFFFFF0, 7)
+        trace = decode_key_trace(data)
+        self.assertEqual(trace.n_received, 100)
+        self.assertEqual(trace.n_unmatched, 12)
+        self.assertEqual(trace.counts, [5, 7])
+        self.assertEqual(trace.packets, [20, 28])
+
+    def test_traced_partitions(self):
+        a, b, c = Object(label="a"), Object(label="b"), Object(label="c")
+        from_a = _partition(a, c)
+        from_b = _partition(b, c, c)
+        no_keys = _partition(c, c)
+        routing_info = Object(get_routing_info_from_partition={
+            from_a: Object(first_key_and_mask=Object(key=0x20)),
+            from_b: Object(first_key_and_mask=Object(key=0x10)),
+            no_keys: None}.get)
+        traced = get_traced_partitions(
+            c, _Graph([from_a, from_b, no_keys]), routing_info)
+        self.assertEqual(
+            [partition for _, partition in traced], [from_b, from_a])
+
+    def test_trace_route(self):
+
+        # the entry on chip 0 sends east, chip 1 has none so the packets
+        # carry on east, and chip 2 sends them back west and to a core
+        tables = _RouterTables({
+            (0, 0): Object(multicast_routing_entries=[
+                _entry(0x10, 0xFFFFFFF0, [0])]),
+            (2, 0): Object(multicast_routing_entries=[
+                _entry(0x20, 0xFFFFFFF0, []),
+                _entry(0x10, 0xFFFFFFF0, [3])])})
+        routers, links = trace_route(_Machine(4), tables, 0, 0, 0x13)
+        self.assertEqual(routers, [(0, 0), (1, 0), (2, 0)])
+        self.assertEqual(links, [(0, 0, 0), (1, 0, 0), (2, 0, 3)])
+
+        # packets without an entry on the chip they are sent from go nowhere
+        self.assertEqual(
+            trace_route(_Machine(4), tables, 1, 0, 0x13), ([(1, 0)], []))
+
+    def test_report(self):
+        a, b, c = Object(label="a"), Object(label="b"), Object(label="c")
+        from_a = _partition(a, b, c)
+        key_and_mask = Object(key=0x10)
+        placements = {
+            a: Object(x=0, y=0, p=1, vertex=a),
+            b: Object(x=1, y=0, p=1, vertex=b),
+            c: Object(x=1, y=0, p=2, vertex=c)}
+        key_traces = {
+            placements[b]: (
+                KeyTrace(2, 20, 0, [10]), [(key_and_mask, from_a)]),
+            placements[c]: (
+                KeyTrace(2, 18, 1, [9]), [(key_and_mask, from_a)])}
+        tables = _RouterTables({
+            (0, 0): Object(multicast_routing_entries=[
+                _entry(0x10, 0xFFFFFFF0, [0])]),
+            (1, 0): Object(multicast_routing_entries=[
+                _entry(0x10, 0xFFFFFFF0, [])])})
+        report = KeyTraceReport(
+            Object(get_placement_of_vertex=placements.get), key_traces,
+            _Machine(3), tables, {(0, 0): 0, (1, 0): 4})
+
+        self.assertEqual(sorted(report.edge_packets.values()), [18, 20])
+        self.assertEqual(report.partition_packets, {from_a: 20})
+        self.assertEqual(report.chip_received, {(1, 0): 38})
+        self.assertEqual(report.router_packets, {(0, 0): 20, (1, 0): 20})
+        self.assertEqual(report.link_packets, {(0, 0, 0): 20})
+        self.assertEqual(
+            report.heatmap(report.dropped), ["  0 .9.", "    012"])
+
+        folder = tempfile.mkdtemp()
+        try:
+            path = report.write(folder)
+            self.assertEqual(path, os.path.join(folder, KEY_TRACE_REPORT))
+            with open(path) as f:
+                text = f.read()
+        finally:
+            shutil.rmtree(folder)
+        self.assertIn("        20 a -> b", text)
+        self.assertIn("(  0,   0) E          20", text)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,51 @@
+import unittest
+
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.utilities.lattice_keys \
+    import LatticeKeys, morton_decode, morton_encode, morton_order
+
+
+class TestLatticeKeys(unittest.TestCase):
+
+    def test_morton_code(self):
+        self.assertEqual(morton_encode(0, 0), 0)
+        self.assertEqual(morton_encode(1, 0), 1)
+        self.assertEqual(morton_encode(0, 1), 2)
+        self.assertEqual(morton_encode(3, 5), 0b100111)
+        for x in range(20):
+            for y in range(20):
+                self.assertEqual(morton_decode(morton_encode(x, y)), (x, y))
+
+    def test_morton_order_makes_blocks(self):
+        order = morton_order((x, y) for x in range(4) for y in range(4))
+        self.assertEqual(
+            sorted(order[:4]), [(0, 0), (0, 1), (1, 0), (1, 1)])
+        self.assertEqual(
+            sorted(order[4:8]), [(2, 0), (2, 1), (3, 0), (3, 1)])
+
+    def test_keys(self):
+        keys = LatticeKeys(7, 7, keys_per_vertex=2, base_key=0x10000)
+        self.assertEqual(keys.mask, 0xFFFFFFFE)
+        self.assertEqual(keys.key(0, 0), 0x10000)
+        self.assertEqual(keys.key(1, 1), 0x10006)
+        self.assertEqual(len(set(
+            keys.key(x, y) for x in range(7) for y in range(7))), 49)
+        self.assertEqual(keys.coordinates(keys.key(5, 3) + 1), (5, 3))
+
+    def test_block_key_and_mask(self):
+        keys = LatticeKeys(8, 8)
+        key, mask = keys.block_key_and_mask(5, 2, 1)
+        block = [(x, y) for x in range(8) for y in range(8)
+                 if keys.key(x, y) & mask == key]
+        self.assertEqual(sorted(block), [(4, 2), (4, 3), (5, 2), (5, 3)])
+
+    def test_too_big(self):
+        with self.assertRaises(ConfigurationException):
+            LatticeKeys(1 << 16, 2, keys_per_vertex=2)
+        with self.assertRaises(ConfigurationException):
+            LatticeKeys(8, 8, base_key=0x1)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,33 @@
+import unittest
+
+from spinnaker_graph_front_end.examples.page_rank.page_rank_graph \
+    import PageRankGraph
+from spinnaker_graph_front_end.examples.page_rank.page_rank_reference \
+    import page_rank, converged_iteration
+
+
+class TestPageRankReference(unittest.TestCase):
+
+    def test_cycle_is_uniform(self):
+        graph = PageRankGraph(4, [(0, 1), (1, 2), (2, 3), (3, 0)])
+        ranks, residuals = page_rank(graph, 0.85, 10)
+        for rank in ranks:
+            self.assertAlmostEqual(rank, 0.25)
+        self.assertEqual(converged_iteration(residuals, 1e-9), 1)
+
+    def test_hub_ranks_highest(self):
+        graph = PageRankGraph(4, [(1, 0), (2, 0), (3, 0), (0, 1)])
+        ranks, residuals = page_rank(graph, 0.85, 50)
+        self.assertEqual(max(range(4), key=lambda node: ranks[node]), 0)
+        self.assertLess(residuals[-1], residuals[0])
+
+    def test_dangling_rank_is_not_redistributed(self):
+        graph = PageRankGraph(2, [(0, 1)])
+        ranks, _ = page_rank(graph, 0.5, 1)
+        self.assertAlmostEqual(ranks[0], 0.25)
+        self.assertAlmostEqual(ranks[1], 0.25 + 0.5 * 0.5)
+
+    def test_repeated_edges_are_ignored(self):
+        graph = PageRankGraph(2, [(0, 1), (0, 1), (1, 0)])
+        self.assertEqual(graph.n_edges, 2)
+        self.assertEqual(graph.predecessors(1), [0])
@@ -0,0 +1,126 @@
+from datetime import timedelta
+import unittest
+
+from spinnaker_graph_front_end import spinnaker
+from spinnaker_graph_front_end.utilities.phase_timing_report import \
+    AlgorithmTiming, PhaseTiming, PhaseTimingReport
+
+
+class _Executor(object):
+    def __init__(self, algorithm_timings):
+        self.algorithm_timings = algorithm_timings
+
+
+class _Base(object):
+    """ Runs no algorithms, but reports the timings it is given
+    """
+
+    algorithm_timings = list()
+
+    @staticmethod
+    def _run_algorithms(simulator, *args, **kwargs):
+        return _Executor(_Base.algorithm_timings)
+
+
+class TestPhaseTimingReport(unittest.TestCase):
+
+    def test_add_time(self):
+        phase = PhaseTiming("mapping")
+        self.assertEqual(phase.seconds, 0.0)
+        self.assertIsNone(phase.peak_memory_kb)
+        self.assertIsNone(phase.memory_growth_kb)
+
+        # a phase entered again adds to its time and memory growth
+        phase.add_time(1.5, 100, 150)
+        phase.add_time(0.5, 150, 170)
+        self.assertEqual(phase.seconds, 2.0)
+        self.assertEqual(phase.peak_memory_kb, 170)
+        self.assertEqual(phase.memory_growth_kb, 70)
+
+        # time whose memory is not known adds no growth
+        phase.add_time(1.0, None, 180)
+        self.assertEqual(phase.seconds, 3.0)
+        self.assertEqual(phase.peak_memory_kb, 180)
+        self.assertEqual(phase.memory_growth_kb, 70)
+
+        unknown = PhaseTiming("loading")
+        unknown.add_time(1.0, None, None)
+        self.assertIsNone(unknown.memory_growth_kb)
+
+    def test_accumulation(self):
+        report = PhaseTimingReport()
+        mapping = report.phase("mapping")
+        self.assertIs(report.phase("mapping"), mapping)
+        self.assertIn("mapping", report)
+        self.assertNotIn("loading", report)
+
+        mapping.add_time(2.0, None, None)
+        report.phase("loading").add_time(1.0, None, None)
+        report.phase("mapping").add_time(0.5, None, None)
+        self.assertIs(report["loading"], report.phase("loading"))
+        self.assertEqual(
+            [phase.name for phase in report.phases], ["mapping", "loading"])
+        self.assertEqual(
+            list(report.seconds_by_phase.items()),
+            [("mapping", 2.5), ("loading", 1.0)])
+        self.assertEqual(report.total_seconds, 3.5)
+
+    def test_to_dict(self):
+        report = PhaseTimingReport()
+        mapping = report.phase("mapping")
+        mapping.add_time(2.0, 100, 120)
+        mapping.add_algorithm(AlgorithmTiming("Placer", 1.5))
+        mapping.add_algorithm(AlgorithmTiming("Check", 0.5, "pre_run"))
+        report.phase("running").add_time(4.0, 120, 120)
+
+        self.assertEqual(report.to_dict(), {
+            "mapping": {
+                "seconds": 2.0, "peak_memory_kb": 120,
+                "memory_growth_kb": 20,
+                "algorithms": [
+                    {"name": "Placer", "seconds": 1.5, "extra": None},
+                    {"name": "Check", "seconds": 0.5, "extra": "pre_run"}]},
+            "running": {
+                "seconds": 4.0, "peak_memory_kb": 120,
+                "memory_growth_kb": 0, "algorithms": []}})
+        self.assertEqual(list(report.to_dict()), ["mapping", "running"])
+
+    def test_extra_algorithms_tagged(self):
+        simulator = spinnaker.SpiNNaker.__new__(spinnaker.SpiNNaker)
+        simulator._current_timing_report = PhaseTimingReport()
+        simulator._active_phase = "mapping"
+        simulator._extra_algorithms = {
+            "Before": "pre_run", "After": "post_run"}
+        _Base.algorithm_timings = [
+            ("Before", 0.25), ("Placer", timedelta(seconds=2)),
+            ("After", 0.5)]
+
+        base = spinnaker.AbstractSpinnakerBase
+        spinnaker.AbstractSpinnakerBase = _Base
+        try:
+            spinnaker.SpiNNaker._run_algorithms(simulator, {}, [])
+
+            # algorithms run outside of a phase are filed under "other"
+            simulator._active_phase = None
+            _Base.algorithm_timings = [("Loader", 1.0)]
+            spinnaker.SpiNNaker._run_algorithms(simulator, {}, [])
+        finally:
+            spinnaker.AbstractSpinnakerBase = base
+
+        report = simulator._current_timing_report
+        self.assertEqual(
+            [(algorithm.name, algorithm.seconds, algorithm.extra)
+             for algorithm in report["mapping"].algorithms],
+            [("Before", 0.25, "pre_run"), ("Placer", 2.0, None),
+             ("After", 0.5, "post_run")])
+        self.assertEqual(
+            [algorithm.name for algorithm in report["other"].algorithms],
+            ["Loader"])
+        self.assertEqual(
+            [(algorithm.name, algorithm.extra)
+             for algorithm in report.extra_algorithms],
+            [("Before", "pre_run"), ("After", "post_run")])
+
+
+if __name__ == "__main__":
+    unittest.main()
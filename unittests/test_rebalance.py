@@ -0,0 +1,72 @@
+import unittest
+from collections import namedtuple
+
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.utilities.node_slicing import NodeSlicing
+from spinnaker_graph_front_end.utilities.rebalance \
+    import get_vertex_cycles, plan_rebalance
+from spinnaker_graph_front_end.utilities.tick_profile import TickProfile
+
+_Placement = namedtuple("_Placement", "vertex x y p")
+
+
+class TestRebalance(unittest.TestCase):
+
+    def test_slices_from_lo_atoms(self):
+        slicing = NodeSlicing(10, lo_atoms=[0, 2, 7])
+        self.assertEqual(
+            [(s.lo_atom, s.hi_atom) for s in slicing.slices],
+            [(0, 1), (2, 6), (7, 9)])
+        self.assertEqual(slicing.index_of(6), 1)
+        self.assertEqual(NodeSlicing(10, 4).n_slices, 3)
+        with self.assertRaises(ConfigurationException):
+            NodeSlicing(10, lo_atoms=[0, 5, 5])
+        with self.assertRaises(ConfigurationException):
+            NodeSlicing(10, lo_atoms=[1, 5])
+
+    def test_busy_slices_are_split(self):
+        slices = NodeSlicing(400, 100).slices
+
+        # the last slice does nine times the work of each of the others
+        rebalancing = plan_rebalance(slices, [2000, 2000, 2000, 10000], 1000)
+        self.assertEqual(rebalancing.n_slices, 4)
+        self.assertEqual(rebalancing.lo_atoms[0], 0)
+        self.assertTrue(rebalancing.is_worthwhile)
+        self.assertAlmostEqual(rebalancing.measured_imbalance, 1.5)
+
+        # 12000 cycles of work over 4 cores is 3000 each, 4000 with the base
+        self.assertLess(rebalancing.predicted_max_cycles, 4100)
+        self.assertLess(rebalancing.predicted_imbalance, 0.05)
+        self.assertGreater(rebalancing.lo_atoms[-1], 300)
+
+    def test_balanced_slices_are_kept(self):
+        slices = NodeSlicing(400, 100).slices
+        rebalancing = plan_rebalance(slices, [3000] * 4, 1000)
+        self.assertEqual(rebalancing.lo_atoms, [0, 100, 200, 300])
+        self.assertFalse(rebalancing.is_worthwhile)
+
+    def test_limits(self):
+        slices = NodeSlicing(400, 100).slices
+        rebalancing = plan_rebalance(
+            slices, [1000, 1000, 1000, 41000], 1000, n_slices=2,
+            max_atoms=300)
+        self.assertEqual(rebalancing.lo_atoms, [0, 300])
+        with self.assertRaises(ConfigurationException):
+            plan_rebalance(slices, [1000] * 4, 1000, n_slices=3,
+                           max_atoms=100)
+        with self.assertRaises(ConfigurationException):
+            plan_rebalance(slices, [1000] * 3, 1000)
+
+    def test_vertex_cycles(self):
+        profiles = {
+            _Placement("a", 0, 0, 1): TickProfile(500, 5000, 10, 0, 2),
+            _Placement("b", 0, 0, 2): TickProfile(900, 5000, 10, 0, 1)}
+        self.assertEqual(
+            get_vertex_cycles(profiles, ["b", "a"]), ([900, 500], 3))
+        with self.assertRaises(ConfigurationException):
+            get_vertex_cycles(profiles, ["c"])
+
+
+if __name__ == "__main__":
+    unittest.main()
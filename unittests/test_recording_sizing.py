@@ -0,0 +1,91 @@
+import unittest
+
+from spinn_front_end_common.utilities import constants
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.abstract_models \
+    import AbstractHasRecordingSizing
+from spinnaker_graph_front_end.utilities.recording_sizing \
+    import RecordingSizing, check_recording_sizes
+
+MAX_REGION = constants.MAX_SIZE_OF_BUFFERED_REGION_ON_CHIP
+
+
+class _Vertex(AbstractHasRecordingSizing):
+    def __init__(self, label, sizing):
+        self.label = label
+        self._sizing = sizing
+
+    @property
+    def recording_sizing(self):
+        return self._sizing
+
+
+class TestRecordingSizing(unittest.TestCase):
+
+    def test_unbuffered(self):
+
+        # the regions hold the whole run, however big
+        n_ticks = MAX_REGION
+        sizing = RecordingSizing([4, 2], n_ticks, None, 50)
+        self.assertFalse(sizing.buffered)
+        self.assertEqual(sizing.region_sizes, [4 * n_ticks, 2 * n_ticks])
+        self.assertEqual(sizing.sdram_size, 6 * n_ticks)
+        self.assertIsNone(sizing.buffer_size_before_receive)
+        self.assertEqual(sizing.minimum_buffer_sdram_usage, 6 * 2 * 50)
+
+        # a short run needs no more than it records
+        short = RecordingSizing([4, 2], 10, None, 50)
+        self.assertEqual(short.region_sizes, [40, 20])
+        self.assertEqual(short.minimum_buffer_sdram_usage, 60)
+
+    def test_buffered(self):
+
+        # the regions are no bigger than the largest buffer
+        n_ticks = MAX_REGION
+        sizing = RecordingSizing([4, 1], n_ticks, 16384, 50)
+        self.assertTrue(sizing.buffered)
+        self.assertEqual(sizing.region_sizes, [MAX_REGION, MAX_REGION])
+        self.assertEqual(sizing.buffer_size_before_receive, 16384)
+
+        # the host is asked for the data before the ticks between requests
+        # can fill the smallest region
+        small = RecordingSizing([4], 100, 16384, 50)
+        self.assertEqual(small.region_sizes, [400])
+        self.assertEqual(small.buffer_size_before_receive, 400 - 4 * 50)
+
+        # but never for less than a tick of data
+        tiny = RecordingSizing([4], 10, 16384, 50)
+        self.assertEqual(tiny.buffer_size_before_receive, 4)
+
+    def test_run_forever(self):
+        sizing = RecordingSizing([4, 8], None, None, 50)
+        self.assertEqual(sizing.region_sizes, [MAX_REGION, MAX_REGION])
+        self.assertEqual(sizing.minimum_buffer_sdram_usage, 12 * 2 * 50)
+
+    def test_holds_run(self):
+        sizing = RecordingSizing([4], 100, None, 50)
+        self.assertEqual(sizing.n_machine_time_steps, 100)
+        self.assertTrue(sizing.holds_run(100))
+        self.assertFalse(sizing.holds_run(101))
+        self.assertFalse(sizing.holds_run(None))
+
+        # regions read during the run, or as big as a buffer, hold any run
+        self.assertTrue(RecordingSizing([4], 100, 16384, 50).holds_run(1000))
+        self.assertTrue(RecordingSizing([4], None, None, 50).holds_run(None))
+
+    def test_check_recording_sizes(self):
+        vertices = [
+            _Vertex("a", RecordingSizing([4], 100, None, 50)),
+            _Vertex("b", RecordingSizing([4], 100, 16384, 50)),
+            _Vertex("c", None), object()]
+        check_recording_sizes(vertices, 100)
+        with self.assertRaises(ConfigurationException):
+            check_recording_sizes(vertices, 200)
+        with self.assertRaises(ConfigurationException):
+            check_recording_sizes(vertices, None)
+        check_recording_sizes(vertices[1:], 200)
+
+
+if __name__ == "__main__":
+    unittest.main()
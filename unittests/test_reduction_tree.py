@@ -0,0 +1,66 @@
+import unittest
+
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.abstract_models \
+    import AbstractReductionContributor
+from spinnaker_graph_front_end.utilities.reduction_tree \
+    import MAX_REDUCTIONS, ReductionOperation, ReductionTree, \
+    plan_reduction_tree
+
+# two boards of two chips, each with 17 application cores
+CHIPS = [(x, y, 17, board)
+         for board in [(0, 0), (4, 8)]
+         for x, y in [(board[0], board[1]), (board[0] + 1, board[1])]]
+
+
+class _Contributor(AbstractReductionContributor):
+
+    def set_reduction_tree(self, reduction_tree):
+        self.reduction_tree = reduction_tree
+
+
+class TestReductionTree(unittest.TestCase):
+
+    def _plan(self, n_contributors, contributors_per_chip=None):
+        return [
+            ((plan.x, plan.y), plan.board, plan.n_contributors)
+            for plan in plan_reduction_tree(
+                CHIPS, n_contributors, contributors_per_chip)]
+
+    def test_cores_left_for_aggregators(self):
+
+        # an aggregator on every chip, and one more on each Ethernet chip
+        self.assertEqual(self._plan(40), [
+            ((0, 0), (0, 0), 15), ((1, 0), (0, 0), 16),
+            ((4, 8), (4, 8), 9)])
+
+    def test_contributors_per_chip(self):
+        self.assertEqual(self._plan(10, 4), [
+            ((0, 0), (0, 0), 4), ((1, 0), (0, 0), 4),
+            ((4, 8), (4, 8), 2)])
+
+    def test_too_many_contributors(self):
+        with self.assertRaises(ConfigurationException):
+            self._plan(63)
+
+    def test_completion(self):
+        contributor = _Contributor()
+        tree = ReductionTree(
+            [contributor], [ReductionOperation.SUM], completion=True)
+        self.assertIs(contributor.reduction_tree, tree)
+        self.assertEqual(
+            tree.operations, [ReductionOperation.SUM, ReductionOperation.MIN])
+        self.assertEqual(tree.completion_reduction, 1)
+        self.assertEqual(tree.completion_parameter, 2)
+        self.assertTrue(tree.deliver_results)
+
+        tree = ReductionTree([contributor], [ReductionOperation.SUM])
+        self.assertIsNone(tree.completion_reduction)
+        self.assertEqual(tree.completion_parameter, 0)
+
+        # the completion reduction counts towards the limit
+        with self.assertRaises(ConfigurationException):
+            ReductionTree(
+                [contributor], [ReductionOperation.MAX] * MAX_REDUCTIONS,
+                completion=True)
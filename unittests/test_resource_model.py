@@ -0,0 +1,77 @@
+import os
+import shutil
+import tempfile
+import unittest
+
+from spinnaker_graph_front_end.utilities.resource_model import \
+    ResourceModel, get_resource_model_path, load_resource_model
+
+
+class TestResourceModel(unittest.TestCase):
+
+    def test_fit_recovers_line(self):
+        model = ResourceModel.fit([
+            (1, 1100, 600), (2, 1200, 700), (4, 1400, 900), (4, 1400, 900)])
+        self.assertAlmostEqual(model.dtcm_base, 1000)
+        self.assertAlmostEqual(model.dtcm_per_element, 100)
+        self.assertAlmostEqual(model.cycles_base, 500)
+        self.assertAlmostEqual(model.cycles_per_element, 100)
+        self.assertTrue(model.measured)
+
+    def test_fit_needs_two_sizes(self):
+        with self.assertRaises(ValueError):
+            ResourceModel.fit([(1, 1100, 600), (1, 1100, 610)])
+
+    def test_max_elements(self):
+        model = ResourceModel(1024, 16, 1000, 50)
+
+        # 1000 us at 200 MHz, 80% used, is 160000 cycles: 3180 elements,
+        # but only (65536 - 1024) / 16 = 4032 fit in DTCM
+        self.assertEqual(model.max_elements(1000, 200, 0.8), 3180)
+
+        # At 1 ms and 10% the DTCM is not the limit either
+        self.assertEqual(model.max_elements(1000, 200, 0.1), 380)
+
+        # Cycles are plentiful at 10 ms so DTCM limits the elements
+        self.assertEqual(model.max_elements(10000, 200, 0.8), 4032)
+
+        # The binary alone overruns a 1 us tick
+        self.assertEqual(model.max_elements(1, 200, 0.8), 0)
+
+    def test_save_and_load(self):
+        folder = tempfile.mkdtemp()
+        try:
+            path = os.path.join(folder, "model.json")
+            ResourceModel(1, 2, 3, 4, measured=True).save(path)
+            model = ResourceModel.load(path)
+            self.assertEqual(model.dtcm_bytes(10), 21)
+            self.assertEqual(model.cycles_per_tick(10), 43)
+        finally:
+            shutil.rmtree(folder)
+
+    def test_load_after_save(self):
+        folder = tempfile.mkdtemp()
+        try:
+            default = ResourceModel(1, 2, 3, 4, measured=False)
+            self.assertIs(
+                load_resource_model("test.aplx", [folder], default), default)
+
+            # a model loaded once is kept, until another is saved over it
+            path = get_resource_model_path("test.aplx", folder)
+            ResourceModel(5, 6, 7, 8).save(path)
+            first = load_resource_model("test.aplx", [folder], default)
+            self.assertEqual(first.dtcm_bytes(1), 11)
+            self.assertIs(
+                load_resource_model("test.aplx", [folder], default), first)
+            ResourceModel(10, 20, 30, 40).save(os.path.join(
+                folder, os.pardir, os.path.basename(folder),
+                os.path.basename(path)))
+            model = load_resource_model("test.aplx", [folder], default)
+            self.assertEqual(model.dtcm_bytes(1), 30)
+            self.assertEqual(model.cycles_per_tick(1), 70)
+        finally:
+            shutil.rmtree(folder)
+
+
+if __name__ == '__main__':
+    unittest.main()
@@ -0,0 +1,121 @@
+import unittest
+
+from spinnaker_graph_front_end.utilities.sdram_mailbox_utilities \
+    import NO_TIME, get_mailbox_reads_region_size, get_mailbox_region_size, \
+    is_sdram_edge, needs_multicast, write_mailbox_reads_region, \
+    write_mailbox_region
+from spinnaker_graph_front_end.utility_models import SDRAMMailboxMachineEdge
+
+from unittests.fakes import Object, Spec
+
+PARTITION_ID = "STATE"
+
+
+class _Vertex(object):
+    sdram_mailbox_region_id = 5
+
+    def __init__(self, label):
+        self.label = label
+
+
+class _Graph(object):
+    def __init__(self, edges):
+        self._edges = edges
+
+    def get_edges_ending_at_vertex(self, vertex):
+        return [edge for edge in self._edges if edge.post_vertex is vertex]
+
+    def get_outgoing_edge_partition_starting_at_vertex(
+            self, vertex, partition_id):
+        edges = [edge for edge in self._edges if edge.pre_vertex is vertex]
+        if not edges:
+            return None
+        return Object(edges=edges)
+
+
+class TestSDRAMMailbox(unittest.TestCase):
+
+    def setUp(self):
+
+        # a and b share a chip with c, and d is on another chip
+        self.a, self.b, self.c, self.d = [
+            _Vertex(label) for label in "abcd"]
+        locations = {
+            self.a: (0, 0, 1), self.b: (0, 0, 2), self.c: (0, 0, 3),
+            self.d: (1, 0, 1)}
+        self.placements = Object(get_placement_of_vertex=lambda vertex: (
+            Object(**dict(zip(("x", "y", "p"), locations[vertex])))))
+
+    def test_edge(self):
+        edge = SDRAMMailboxMachineEdge(self.a, self.c, n_words=3)
+        self.assertEqual(edge.n_words, 3)
+        self.assertTrue(edge.uses_sdram(self.placements))
+        self.assertTrue(is_sdram_edge(edge, self.placements))
+        off_chip = SDRAMMailboxMachineEdge(self.d, self.c)
+        self.assertEqual(off_chip.n_words, 1)
+        self.assertFalse(off_chip.uses_sdram(self.placements))
+        self.assertFalse(is_sdram_edge(off_chip, self.placements))
+
+        # an edge of another type always sends packets
+        plain = Object(pre_vertex=self.a, post_vertex=self.c)
+        self.assertFalse(is_sdram_edge(plain, self.placements))
+
+    def test_sizes(self):
+
+        # the words per slot, the times before and after the data of each
+        # of the two slots
+        self.assertEqual(get_mailbox_region_size(1), (1 + 2 * (2 + 1)) * 4)
+        self.assertEqual(get_mailbox_region_size(4), (1 + 2 * (2 + 4)) * 4)
+
+        # the counts of reads and filters, and a read and a filter per edge
+        self.assertEqual(get_mailbox_reads_region_size(8), (2 + 8 * 5) * 4)
+
+    def test_mailbox_region(self):
+        spec = Spec()
+        write_mailbox_region(spec, 5, 2)
+
+        # no slot holds a time a read would accept until it is written
+        self.assertEqual(spec.regions[5], [
+            2, NO_TIME, 0, 0, NO_TIME, NO_TIME, 0, 0, NO_TIME])
+        self.assertEqual(
+            len(spec.regions[5]) * 4, get_mailbox_region_size(2))
+
+    def test_needs_multicast(self):
+        graph = _Graph([
+            SDRAMMailboxMachineEdge(self.a, self.c),
+            SDRAMMailboxMachineEdge(self.b, self.c),
+            SDRAMMailboxMachineEdge(self.b, self.d)])
+        self.assertFalse(needs_multicast(
+            self.a, PARTITION_ID, graph, self.placements))
+        self.assertTrue(needs_multicast(
+            self.b, PARTITION_ID, graph, self.placements))
+        self.assertFalse(needs_multicast(
+            self.c, PARTITION_ID, graph, self.placements))
+
+    def test_reads_region(self):
+        graph = _Graph([
+            SDRAMMailboxMachineEdge(self.a, self.c, n_words=2),
+            SDRAMMailboxMachineEdge(self.b, self.c),
+            SDRAMMailboxMachineEdge(self.b, self.d),
+            SDRAMMailboxMachineEdge(self.d, self.c)])
+        keys = {self.b: Object(
+            first_key_and_mask=Object(key=0x100, mask=0xFFFFFF00))}
+        routing_info = Object(
+            get_routing_info_from_pre_vertex=lambda vertex, _: keys[vertex])
+        spec = Spec()
+        n_sdram_edges = write_mailbox_reads_region(
+            spec, 6, self.c, PARTITION_ID, graph, self.placements,
+            routing_info)
+
+        # a and b are read from their mailboxes, and as b also sends packets
+        # to d, those packets are dropped by c
+        self.assertEqual(n_sdram_edges, 2)
+        self.assertEqual(spec.regions[6], [
+            2, 1, 5, 2, 2, 5, 1,
+            1, 0x100, 0xFFFFFF00])
+        self.assertLessEqual(
+            len(spec.regions[6]) * 4, get_mailbox_reads_region_size(3))
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,31 @@
+import unittest
+
+from spinnaker_graph_front_end.examples.sssp.sssp_graph import WeightedGraph
+from spinnaker_graph_front_end.examples.sssp.sssp_reference \
+    import shortest_paths
+
+
+class TestSSSPReference(unittest.TestCase):
+
+    def test_shorter_path_with_more_edges(self):
+        graph = WeightedGraph(4, [(0, 1, 5), (0, 2, 1), (2, 1, 1), (1, 3, 1)])
+        self.assertEqual(shortest_paths(graph, 0), [0, 2, 1, 3])
+
+    def test_unreachable_nodes(self):
+        graph = WeightedGraph(3, [(0, 1, 1), (2, 0, 1)])
+        self.assertEqual(shortest_paths(graph, 0), [0, 1, None])
+
+    def test_lightest_repeated_edge_is_kept(self):
+        graph = WeightedGraph(2, [(0, 1, 3), (0, 1, 2), (0, 1, 4)])
+        self.assertEqual(graph.successors(0), [(1, 2)])
+        self.assertEqual(graph.n_edges, 1)
+
+    def test_unit_weights_are_breadth_first(self):
+        graph = WeightedGraph.random(50, 200, seed=3)
+        distances = shortest_paths(graph, 0)
+        for source in range(graph.n_nodes):
+            if distances[source] is None:
+                continue
+            for target, weight in graph.successors(source):
+                self.assertEqual(weight, 1)
+                self.assertLessEqual(distances[target], distances[source] + 1)
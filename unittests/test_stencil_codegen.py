@@ -0,0 +1,125 @@
+import os
+import shutil
+import tempfile
+import unittest
+
+from spinn_front_end_common.utilities.exceptions import ConfigurationException
+
+from spinnaker_graph_front_end.utilities import stencil_codegen
+from spinnaker_graph_front_end.utilities.stencil_codegen \
+    import BUILD_FILES, generate_makefile, generate_source, get_binary_name
+from spinnaker_graph_front_end.utilities.stencil_grid \
+    import StencilGrid, get_neighbour_sides
+from spinnaker_graph_front_end.utilities.stencil_spec \
+    import MOORE, S1615, StencilSpec, UINT8, VON_NEUMANN
+
+
+def _life(state, n_alive):
+    return 1 if n_alive == 3 or (state and n_alive == 2) else 0
+
+
+class TestStencilCodegen(unittest.TestCase):
+
+    def test_totalistic_lut(self):
+        spec = StencilSpec(MOORE, UINT8, 4, 4, rule=_life)
+        self.assertEqual(len(spec.lut), 2 * 9)
+        for state in range(2):
+            for n_alive in range(9):
+                self.assertEqual(
+                    spec.lut[state * spec.n_totals + n_alive],
+                    _life(state, n_alive))
+
+    def test_lut_of_each_neighbour(self):
+
+        # the next state is the neighbour to the east
+        spec = StencilSpec(
+            VON_NEUMANN, UINT8, 4, 4, rule=lambda state, n: n[2],
+            totalistic=False)
+        self.assertEqual(len(spec.lut), 2 ** 5)
+        self.assertEqual(spec.lut[0b00010], 1)
+        self.assertEqual(spec.lut[0b11101], 0)
+        with self.assertRaises(ConfigurationException):
+            StencilSpec(MOORE, UINT8, 4, 4, rule=_life, n_states=3,
+                        totalistic=False)
+        with self.assertRaises(ConfigurationException):
+            StencilSpec(MOORE, UINT8, 4, 4, rule=lambda state, n: 2)
+
+    def test_binary_named_by_spec(self):
+        spec = StencilSpec(MOORE, UINT8, 8, 8, rule=_life)
+        same = StencilSpec(MOORE, UINT8, 8, 8, rule=lambda s, n: _life(s, n))
+        other = StencilSpec(MOORE, UINT8, 8, 4, rule=_life)
+        self.assertEqual(spec, same)
+        self.assertEqual(get_binary_name(spec), get_binary_name(same))
+        self.assertNotEqual(get_binary_name(spec), get_binary_name(other))
+        self.assertTrue(get_binary_name(spec).startswith("stencil_"))
+
+    def test_binary_named_by_headers(self):
+        spec = StencilSpec(MOORE, UINT8, 8, 8, rule=_life)
+        name = get_binary_name(spec)
+
+        # a copy of c_common in which each file built with changes in turn
+        c_common_dir = stencil_codegen._C_COMMON_DIR
+        folder = tempfile.mkdtemp()
+        try:
+            os.mkdir(os.path.join(folder, "include"))
+            for build_file in BUILD_FILES:
+                shutil.copy(os.path.join(c_common_dir, build_file),
+                            os.path.join(folder, build_file))
+            stencil_codegen._C_COMMON_DIR = folder
+            self.assertEqual(get_binary_name(spec), name)
+            names = set()
+            for build_file in BUILD_FILES:
+                with open(os.path.join(folder, build_file), "a") as f:
+                    f.write("\n")
+                names.add(get_binary_name(spec))
+        finally:
+            stencil_codegen._C_COMMON_DIR = c_common_dir
+            shutil.rmtree(folder)
+        self.assertNotIn(name, names)
+        self.assertEqual(len(names), len(BUILD_FILES))
+
+    def test_generated_source(self):
+        spec = StencilSpec(MOORE, UINT8, 8, 4, rule=_life)
+        source = generate_source(spec)
+        self.assertNotIn("@{", source)
+        self.assertIn("#define TILE_WIDTH 8", source)
+        self.assertIn("#define N_BORDER_CELLS 20", source)
+        self.assertIn("cell[-PADDED_WIDTH - 1]", source)
+        self.assertIn("RULE[cell[0] * N_TOTALS + total]", source)
+        makefile = generate_makefile(spec)
+        self.assertIn("APP = " + get_binary_name(spec)[:-5], makefile)
+
+        numeric = StencilSpec(
+            VON_NEUMANN, S1615, 4, 4, centre_weight=0.5,
+            neighbour_weights=[0.125, 0.125, 0.125, 0])
+        source = generate_source(numeric)
+        self.assertIn("(int64_t) cell[0] * 16384", source)
+        self.assertIn("(int64_t) cell[-1] * 4096", source)
+        self.assertNotIn("cell[PADDED_WIDTH]", source)
+
+    def test_neighbour_sides(self):
+        self.assertEqual(len(get_neighbour_sides(
+            StencilSpec(MOORE, UINT8, 4, 4, rule=_life))), 8)
+        self.assertEqual(
+            sorted(get_neighbour_sides(StencilSpec(
+                VON_NEUMANN, UINT8, 4, 4, rule=_life))),
+            [(-1, 0), (0, -1), (0, 1), (1, 0)])
+
+    def test_grid_wraps_onto_itself(self):
+        spec = StencilSpec(MOORE, UINT8, 2, 2, rule=_life)
+        grid = StencilGrid(spec, [[0, 1, 0, 1], [1, 0, 1, 0]])
+        vertices = list()
+        edges = list()
+        grid.add_to_graph(
+            vertices.append, lambda edge, partition: edges.append(edge))
+        self.assertEqual(len(vertices), 2)
+
+        # each tile is on both sides of the other, and above and below
+        # itself
+        self.assertEqual(len(edges), 2)
+        left = grid.tiles[0, 0]
+        self.assertEqual(left.cells, [0, 1, 1, 0])
+        self.assertEqual(len(left._incoming), 6)
+        self.assertEqual(len(left._local), 2)
+        with self.assertRaises(ConfigurationException):
+            StencilGrid(spec, [[0, 1, 0]])
@@ -0,0 +1,72 @@
+import struct
+import unittest
+
+import numpy
+
+from spinnaker_graph_front_end.utilities.streamed_region import \
+    HEADER_BYTES, StreamedRegion
+
+from unittests.fakes import Spec
+
+
+class TestStreamedRegion(unittest.TestCase):
+
+    def test_sizes(self):
+        region = StreamedRegion(3, 10000, block_bytes=4096)
+        self.assertEqual(region.n_blocks, 3)
+        self.assertEqual(region.sdram_size, HEADER_BYTES + 10000)
+        self.assertEqual(region.dtcm_size, 2 * 4096)
+
+        # the blocks are no bigger than the data
+        small = StreamedRegion(3, 40)
+        self.assertEqual(small.block_bytes, 40)
+        self.assertEqual(small.n_blocks, 1)
+
+    def test_bad_block_size(self):
+        with self.assertRaises(ValueError):
+            StreamedRegion(3, 100, block_bytes=6)
+        with self.assertRaises(ValueError):
+            StreamedRegion(3, 100, block_bytes=0)
+
+    def test_write(self):
+        region = StreamedRegion(3, 12, block_bytes=8, label="data")
+        spec = Spec()
+        region.reserve_memory_region(spec)
+        region.write(spec, [1, 2, 3])
+        self.assertEqual(spec.sizes[3], region.sdram_size)
+        self.assertEqual(spec.regions[3], [12, 8, 1, 2, 3])
+        with self.assertRaises(ValueError):
+            region.write(Spec(), [1, 2])
+
+    def test_partial_words(self):
+
+        # 2-byte values, so the data does not end on a word
+        data = numpy.arange(1, 8, dtype="<u2")
+        region = StreamedRegion(4, data.nbytes, block_bytes=8)
+        self.assertEqual(region.n_bytes, 14)
+        self.assertEqual(region.n_blocks, 2)
+
+        # the data is padded to whole words, so the last block, of 6 bytes,
+        # is fetched as 8 and still fits in its buffer
+        self.assertEqual(region.sdram_size, HEADER_BYTES + 16)
+        last_block = \
+            region.n_bytes - (region.n_blocks - 1) * region.block_bytes
+        self.assertEqual(last_block, 6)
+        self.assertLessEqual((last_block + 3) // 4 * 4, region.block_bytes)
+
+        spec = Spec()
+        region.reserve_memory_region(spec)
+        region.write(spec, data)
+        words = spec.regions[4]
+        self.assertEqual(words[:2], [14, 8])
+        self.assertEqual(len(words) * 4, spec.sizes[4])
+        self.assertEqual(
+            struct.pack("<4I", *words[2:]),
+            data.tobytes() + b"\0\0")
+
+        # the block size is rounded to words even for data smaller than one
+        self.assertEqual(StreamedRegion(4, 5).block_bytes, 8)
+
+
+if __name__ == "__main__":
+    unittest.main()
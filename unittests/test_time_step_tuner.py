@@ -0,0 +1,67 @@
+import unittest
+
+from spinnaker_graph_front_end.utilities.tick_profile import TickProfile
+from spinnaker_graph_front_end.utilities.time_step_tuner \
+    import tune_time_step
+
+
+class TestTimeStepTuner(unittest.TestCase):
+
+    def _tune(self, profiles, time_scale_factor=1):
+        return tune_time_step(
+            profiles, calibration_time_step=1000, headroom=0.25,
+            minimum_time_step=10, granularity=10, cpu_clock_mhz=200,
+            time_scale_factor=time_scale_factor)
+
+    def test_slowest_core_sets_time_step(self):
+        tuning = self._tune({
+            "fast": TickProfile(2000, 100000, 100, 0, 0),
+            "slow": TickProfile(12000, 600000, 100, 0, 0)})
+
+        # 12000 cycles at 200 MHz is 60 us; with 25% headroom that is 80 us
+        self.assertEqual(tuning.machine_time_step, 80)
+        self.assertEqual(tuning.limiting_placement, "slow")
+        self.assertAlmostEqual(tuning.headroom, 0.25)
+
+    def test_minimum_time_step(self):
+        tuning = self._tune({"idle": TickProfile(20, 2000, 100, 0, 0)})
+        self.assertEqual(tuning.machine_time_step, 10)
+
+    def test_unsafe_calibration_backs_off(self):
+
+        # the time step of the calibration is shown to be too short
+        tuning = self._tune({"lossy": TickProfile(2000, 20000, 10, 0, 3)})
+        self.assertEqual(tuning.machine_time_step, 2000)
+        self.assertFalse(tuning.calibration_was_safe)
+
+        # unless what was measured needs longer still: 300000 cycles is
+        # 1500 us, and 2000 us with the headroom
+        tuning = self._tune({"slow": TickProfile(300000, 300000, 1, 1, 0)})
+        self.assertEqual(tuning.machine_time_step, 2000)
+        tuning = self._tune({"slow": TickProfile(450000, 450000, 1, 1, 0)})
+        self.assertEqual(tuning.machine_time_step, 3000)
+
+    def test_time_scale_factor(self):
+
+        # the ticks take 80 us of real time with the headroom, which a time
+        # step of 20 us gives when slowed down four times
+        tuning = self._tune(
+            {"slow": TickProfile(12000, 600000, 100, 0, 0)},
+            time_scale_factor=4)
+        self.assertEqual(tuning.machine_time_step, 20)
+        self.assertEqual(tuning.timer_period, 80)
+        self.assertAlmostEqual(tuning.headroom, 0.25)
+
+        # the time step is rounded up to the granularity
+        tuning = self._tune(
+            {"slow": TickProfile(12000, 600000, 100, 0, 0)},
+            time_scale_factor=3)
+        self.assertEqual(tuning.machine_time_step, 30)
+        self.assertAlmostEqual(tuning.headroom, 1.0 - 60.0 / 90.0)
+
+    def test_no_profiles_keeps_time_step(self):
+        self.assertEqual(self._tune({}).machine_time_step, 1000)
+
+
+if __name__ == "__main__":
+    unittest.main()
@@ -0,0 +1,113 @@
+import os
+import shutil
+import struct
+import tempfile
+import unittest
+
+from spinn_front_end_common.utilities.exceptions import SpinnFrontEndException
+
+from spinnaker_graph_front_end.utilities.token_log import \
+    TOKEN_LOG_MAGIC, TokenDictionary, convert_source, decode_messages, \
+    decode_ring, format_message
+
+_SOURCE = """\
+void timer_callback(uint ticks, uint b) {
+    // log_info("not %d converted", 1);
+    log_debug("on tick %d of %d", time,
+              simulation_ticks);
+    log_info("read: %s", text);
+    log_error("done\\n");
+    log_info("%d%%", percent(a, b));
+}
+"""
+
+
+def _ring(n_words, first, next_offset, used, n_dropped, data):
+    words = list(data) + [0] * (n_words - len(data))
+    return struct.pack(
+        "<{}I".format(7 + n_words), TOKEN_LOG_MAGIC, n_words, first,
+        next_offset, used, n_dropped, 1234, *words)
+
+
+class TestTokenLog(unittest.TestCase):
+
+    def test_convert(self):
+        dictionary = TokenDictionary()
+        converted = convert_source(_SOURCE, "cell.c", dictionary)
+        lines = converted.split("\n")
+
+        # the lines stay where they are, and comments and %s are left alone
+        self.assertEqual(len(lines), len(_SOURCE.split("\n")))
+        self.assertIn("// log_info(\"not %d converted\", 1);", lines[1])
+        self.assertIn("log_info(\"read: %s\", text);", lines[4])
+        self.assertEqual(len(dictionary), 3)
+
+        self.assertIn("token_log_record(LOG_DEBUG, 0x", lines[2])
+        self.assertTrue(lines[2].endswith(
+            "2, (uint32_t) (time), (uint32_t) (simulation_ticks)"))
+        self.assertEqual(lines[3], ");")
+        self.assertIn(", 0, 0);", lines[5])
+        self.assertIn("1, (uint32_t) (percent(a, b)));", lines[6])
+
+        token = int(lines[2].split(",")[1], 16)
+        entry = dictionary.get_entry(token)
+        self.assertEqual(entry.line, 3)
+        self.assertEqual(entry.message_format, "on tick %d of %d")
+        self.assertEqual(
+            entry.format([5, 10]), "[DEBUG] (cell.c: 3): on tick 5 of 10")
+        token = int(lines[5].split(",")[1], 16)
+        self.assertEqual(dictionary.get_entry(token).message_format, "done\n")
+
+    def test_save_and_load(self):
+        dictionary = TokenDictionary()
+        token = dictionary.add("LOG_INFO", "a.c", 1, "x")
+        clash = dictionary.add("LOG_INFO", "a.c", 1, "x")
+        self.assertNotEqual(token, clash)
+        folder = tempfile.mkdtemp()
+        try:
+            path = os.path.join(folder, "a.tokens.json")
+            dictionary.save(path)
+            loaded = TokenDictionary.load(path)
+        finally:
+            shutil.rmtree(folder)
+        self.assertEqual(len(loaded), 2)
+        self.assertEqual(loaded.get_entry(clash).line, 1)
+
+    def test_format(self):
+        self.assertEqual(
+            format_message("%d %u %08x %c", [0xFFFFFFFF, 7, 0xBEEF, 65]),
+            "-1 7 0000beef A")
+        self.assertEqual(
+            format_message("%.2f %k%%", [0x3FC00000, 0x00018000]),
+            "1.50 3.000000%")
+        self.assertEqual(
+            format_message("%05d|%-3d|", [0xFFFFFFF4, 4]), "-0012|4  |")
+
+    def test_decode_ring(self):
+
+        # the oldest record is at 6; 10 and 11 are unused, and the newest
+        # records start again at 0
+        data = [
+            (1 << 24) | 3, 30, (0 << 24) | 4, 0, 0, 0,
+            (2 << 24) | 1, 10, 11, (0 << 24) | 2, 0, 0]
+        records, n_dropped = decode_ring(_ring(12, 6, 3, 9, 5, data))
+        self.assertEqual(n_dropped, 5)
+        self.assertEqual(
+            records, [(1, [10, 11]), (2, []), (3, [30]), (4, [])])
+
+        dictionary = TokenDictionary()
+        messages, _ = decode_messages(
+            _ring(12, 0, 2, 2, 0, [(1 << 24) | 7, 9]), dictionary)
+        self.assertEqual(messages, ["[UNKNOWN] token 0x000007 0x00000009"])
+
+    def test_bad_ring(self):
+        with self.assertRaises(SpinnFrontEndException):
+            decode_ring(b"\0" * 28)
+        with self.assertRaises(SpinnFrontEndException):
+            decode_ring(_ring(4, 0, 2, 2, 0, [(5 << 24) | 1, 0])[:-4])
+        with self.assertRaises(SpinnFrontEndException):
+            decode_ring(_ring(4, 0, 2, 2, 0, [(5 << 24) | 1, 0]))
+
+
+if __name__ == "__main__":
+    unittest.main()